@@ -202,6 +202,9 @@ void CacheMetrics::printAll(raw_ostream &OS,
   size_t TotalCodeMaxAddr = 0;
   size_t HotCodeMinAddr = std::numeric_limits<size_t>::max();
   size_t HotCodeMaxAddr = 0;
+  size_t NumWarmBlocks = 0;
+  size_t WarmCodeMinAddr = std::numeric_limits<size_t>::max();
+  size_t WarmCodeMaxAddr = 0;
 
   for (BinaryFunction *BF : BFs) {
     NumFunctions++;
@@ -215,10 +218,18 @@ void CacheMetrics::printAll(raw_ostream &OS,
       size_t BBAddrMax = BB.getOutputAddressRange().second;
       TotalCodeMinAddr = std::min(TotalCodeMinAddr, BBAddrMin);
       TotalCodeMaxAddr = std::max(TotalCodeMaxAddr, BBAddrMax);
-      if (BF->hasValidIndex() && !BB.isCold()) {
+      if (!BF->hasValidIndex())
+        continue;
+      // With hot-warm-cold splitting, the warm fragment is placed in a section
+      // of its own between hot and cold code.
+      if (!BB.isSplit()) {
         NumHotBlocks++;
         HotCodeMinAddr = std::min(HotCodeMinAddr, BBAddrMin);
         HotCodeMaxAddr = std::max(HotCodeMaxAddr, BBAddrMax);
+      } else if (BB.getFragmentNum() == FragmentNum::warm()) {
+        NumWarmBlocks++;
+        WarmCodeMinAddr = std::min(WarmCodeMinAddr, BBAddrMin);
+        WarmCodeMaxAddr = std::max(WarmCodeMaxAddr, BBAddrMax);
       }
     }
   }
@@ -241,6 +252,13 @@ void CacheMetrics::printAll(raw_ostream &OS,
                "%.2lf huge pages)\n",
                100.0 * HotCodeSize / TotalCodeSize, HotCodeSize, TotalCodeSize,
                double(HotCodeSize) / HugePage2MB);
+  if (NumWarmBlocks) {
+    size_t WarmCodeSize = WarmCodeMaxAddr - WarmCodeMinAddr;
+    OS << format("  Warm code takes %.2lf%% of binary (%zu bytes in %zu "
+                 "basic blocks, %.2lf huge pages)\n",
+                 100.0 * WarmCodeSize / TotalCodeSize, WarmCodeSize,
+                 NumWarmBlocks, double(WarmCodeSize) / HugePage2MB);
+  }
 
   // Stats related to expected cache performance
   std::unordered_map<BinaryBasicBlock *, uint64_t> BBAddr;
@@ -16,6 +16,7 @@
 // - estimate temporal locality by looking at CFG?
 
 #include "bolt/Passes/ReorderData.h"
+#include "llvm/ADT/DenseSet.h"
 #include "llvm/ADT/MapVector.h"
 #include <algorithm>
 
@@ -99,6 +100,20 @@ namespace bolt {
 namespace {
 
 static constexpr uint16_t MinAlignment = 16;
+static constexpr uint64_t CacheLineSize = 64;
+
+/// Record the cache lines and pages touched by [Start, Start + Size).
+void addFootprint(DenseSet<uint64_t> &Lines, DenseSet<uint64_t> &Pages,
+                  uint64_t Start, uint64_t Size, uint64_t PageSize) {
+  if (!Size)
+    return;
+  const uint64_t Last = Start + Size - 1;
+  for (uint64_t Line = Start / CacheLineSize; Line <= Last / CacheLineSize;
+       ++Line)
+    Lines.insert(Line);
+  for (uint64_t Page = Start / PageSize; Page <= Last / PageSize; ++Page)
+    Pages.insert(Page);
+}
 
 bool isSupported(const BinarySection &BS) { return BS.isData() && !BS.isTLS(); }
 
@@ -339,6 +354,10 @@ void ReorderData::setSectionOrder(BinaryContext &BC,
   uint64_t Offset = 0;
   uint64_t Count = 0;
 
+  // Cache lines and pages covered by the reordered symbols before and after
+  // reordering. The new offsets are relative to the start of OutputSection.
+  DenseSet<uint64_t> LinesBefore, PagesBefore, LinesAfter, PagesAfter;
+
   // Get the total count just for stats
   uint64_t TotalCount = 0;
   for (auto Itr = Begin; Itr != End; ++Itr)
@@ -376,6 +395,10 @@ void ReorderData::setSectionOrder(BinaryContext &BC,
                       << Twine::utohexstr(Offset) << "\n");
 
     BD->setOutputLocation(OutputSection, Offset);
+    addFootprint(LinesBefore, PagesBefore, BD->getAddress(), BD->getSize(),
+                 BC.RegularPageSize);
+    addFootprint(LinesAfter, PagesAfter, Offset, BD->getSize(),
+                 BC.RegularPageSize);
 
     // reorder sub-symbols
     for (std::pair<const uint64_t, BinaryData *> &SubBD :
@@ -399,6 +422,10 @@ void ReorderData::setSectionOrder(BinaryContext &BC,
   BC.outs() << "BOLT-INFO: reorder-data: " << Count << "/" << TotalCount
             << format(" (%.1f%%)", 100.0 * Count / TotalCount) << " events, "
             << Offset << " hot bytes\n";
+  BC.outs() << "BOLT-INFO: reorder-data: hot data spans " << LinesAfter.size()
+            << " cache lines and " << PagesAfter.size() << " pages, previously "
+            << LinesBefore.size() << " cache lines and " << PagesBefore.size()
+            << " pages\n";
 }
 
 bool ReorderData::markUnmoveableSymbols(BinaryContext &BC,
@@ -1465,6 +1465,11 @@ uint64_t DataAggregator::parseLBRSample(const PerfBranchSample &Sample,
   return NumTraces;
 }
 
+// FIXME: Samples are parsed one at a time from ParsingBuf, and the parse*
+// helpers keep their position in ParsingBuf, Line and Col. Parsing the script
+// output in parallel would need those helpers to work on a cursor owned by
+// each chunk, chunk boundaries at sample starts, and per-chunk BranchLBRs and
+// FallthroughLBRs that are merged in chunk order.
 std::error_code DataAggregator::parseBranchEvents() {
   outs() << "PERF2BOLT: parse branch events...\n";
   NamedRegionTimer T("parseBranch", "Parsing branch events", TimerGroupName,
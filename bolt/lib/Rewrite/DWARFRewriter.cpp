@@ -790,6 +790,13 @@ void DWARFRewriter::updateDebugInfo() {
       createDIEStreamer(*TheTriple, *ObjOS, "TypeStreamer", DIEBlder, *this);
   CUOffsetMap OffsetMap = finalizeTypeSections(DIEBlder, *Streamer);
 
+  // FIXME: --deterministic-debuginfo is always on, so CUs are processed
+  // sequentially in batches of --cu-processing-batch-size. The CUs of a batch
+  // cannot simply be handed to the thread pool: processUnitDIE() reads the
+  // shared range list writer's offset and then starts the unit's section, and
+  // the DWARF5 str_offsets and address writers are appended to in unit order.
+  // Each CU would need private writers that are concatenated in CU order when
+  // the batch is finalized.
   const bool SingleThreadedMode =
       opts::NoThreads || opts::DeterministicDebugInfo;
   if (!SingleThreadedMode)
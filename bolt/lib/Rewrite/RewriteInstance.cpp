@@ -3177,6 +3177,12 @@ void RewriteInstance::processProfileData() {
 void RewriteInstance::disassembleFunctions() {
   NamedRegionTimer T("disassembleFunctions", "disassemble functions",
                      TimerGroupName, TimerGroupDesc, opts::TimeRewrite);
+  // FIXME: Unlike buildFunctionsCFG(), disassembly runs sequentially. It
+  // creates symbols through BinaryContext and MCContext, records
+  // interprocedural references and registers jump tables, none of which is
+  // guarded. Running it through ParallelUtilities needs those to take
+  // BC->scopeLock() or be deferred to a sequential pass, and symbol names
+  // created by the disassembler to not depend on the processing order.
   for (auto &BFI : BC->getBinaryFunctions()) {
     BinaryFunction &Function = BFI.second;
 
@@ -68,6 +68,13 @@ SuppressMergedDataOutput("q",
   cl::Optional,
   cl::cat(MergeFdataCategory));
 
+static cl::opt<double>
+Decay("decay",
+  cl::desc("scale the counts read from the first input by this factor, e.g. "
+           "to age a previously merged profile against newer ones"),
+  cl::init(1.0),
+  cl::cat(MergeFdataCategory));
+
 static cl::opt<std::string>
 OutputFilePath("o",
   cl::value_desc("file"),
@@ -247,6 +254,26 @@ void mergeFunctionProfile(BinaryFunctionProfile &MergedBF,
       MergedBF.Blocks.emplace_back(std::move(*BB));
 }
 
+uint64_t scaleCount(uint64_t Count, double Weight) {
+  return Weight == 1.0 ? Count : static_cast<uint64_t>(Count * Weight + 0.5);
+}
+
+void scaleFunctionProfile(BinaryFunctionProfile &BF, double Weight) {
+  BF.ExecCount = scaleCount(BF.ExecCount, Weight);
+  for (BinaryBasicBlockProfile &BB : BF.Blocks) {
+    BB.ExecCount = scaleCount(BB.ExecCount, Weight);
+    BB.EventCount = scaleCount(BB.EventCount, Weight);
+    for (CallSiteInfo &CS : BB.CallSites) {
+      CS.Count = scaleCount(CS.Count, Weight);
+      CS.Mispreds = scaleCount(CS.Mispreds, Weight);
+    }
+    for (SuccessorInfo &SI : BB.Successors) {
+      SI.Count = scaleCount(SI.Count, Weight);
+      SI.Mispreds = scaleCount(SI.Mispreds, Weight);
+    }
+  }
+}
+
 bool isYAML(const StringRef Filename) {
   ErrorOr<std::unique_ptr<MemoryBuffer>> MB =
       MemoryBuffer::getFileOrSTDIN(Filename);
@@ -258,13 +285,15 @@ bool isYAML(const StringRef Filename) {
   return false;
 }
 
-void mergeLegacyProfiles(const SmallVectorImpl<std::string> &Filenames) {
+void mergeLegacyProfiles(const SmallVectorImpl<std::string> &Filenames,
+                         size_t NumDecayedInputs) {
   errs() << "Using legacy profile format.\n";
   std::optional<bool> BoltedCollection;
   std::mutex BoltedCollectionMutex;
   typedef StringMap<uint64_t> ProfileTy;
 
-  auto ParseProfile = [&](const std::string &Filename, auto &Profiles) {
+  auto ParseProfile = [&](const std::string &Filename, double Weight,
+                          auto &Profiles) {
     const llvm::thread::id tid = llvm::this_thread::get_id();
 
     if (isYAML(Filename))
@@ -307,6 +336,19 @@ void mergeLegacyProfiles(const SmallVectorImpl<std::string> &Filenames) {
       uint64_t Count;
       if (Line.substr(Pos + 1, Line.size() - Pos).getAsInteger(10, Count))
         report_error(Filename, "Malformed / corrupted profile counter");
+      Count = scaleCount(Count, Weight);
+      // A branch record ends in "<mispreds> <count>", so its mispredictions
+      // are part of the signature and have to be scaled along with the count.
+      std::string ScaledSignature;
+      if (Weight != 1.0 && Signature.count(' ') == 6) {
+        size_t MispredsPos = Signature.rfind(' ');
+        uint64_t Mispreds;
+        if (Signature.substr(MispredsPos + 1).getAsInteger(10, Mispreds))
+          report_error(Filename, "Malformed / corrupted profile counter");
+        ScaledSignature = Signature.substr(0, MispredsPos).str() + " " +
+                          std::to_string(scaleCount(Mispreds, Weight));
+        Signature = ScaledSignature;
+      }
       Count += Profile->lookup(Signature);
       Profile->insert_or_assign(Signature, Count);
     }
@@ -319,8 +361,10 @@ void mergeLegacyProfiles(const SmallVectorImpl<std::string> &Filenames) {
   DefaultThreadPool Pool(S);
   DenseMap<llvm::thread::id, ProfileTy> ParsedProfiles(
       Pool.getMaxConcurrency());
-  for (const auto &Filename : Filenames)
-    Pool.async(ParseProfile, std::cref(Filename), std::ref(ParsedProfiles));
+  for (size_t I = 0; I < Filenames.size(); ++I)
+    Pool.async(ParseProfile, std::cref(Filenames[I]),
+               I < NumDecayedInputs ? opts::Decay.getValue() : 1.0,
+               std::ref(ParsedProfiles));
   Pool.wait();
 
   ProfileTy MergedProfile;
@@ -356,6 +400,8 @@ int main(int argc, char **argv) {
 
   // Recursively expand input directories into input file lists.
   SmallVector<std::string> Inputs;
+  // Number of files that come from the first input, which -decay applies to.
+  size_t NumDecayedInputs = 0;
   for (std::string &InputDataFilename : opts::InputDataFilenames) {
     if (!llvm::sys::fs::exists(InputDataFilename))
       report_error(InputDataFilename,
@@ -372,10 +418,16 @@ int main(int argc, char **argv) {
       if (EC)
         report_error(InputDataFilename, EC);
     }
+    if (&InputDataFilename == &opts::InputDataFilenames.front())
+      NumDecayedInputs = Inputs.size();
   }
 
+  // Written this way so that NaN is rejected as well.
+  if (!(opts::Decay >= 0.0))
+    report_error("-decay", "factor must be a non-negative number");
+
   if (!isYAML(Inputs.front())) {
-    mergeLegacyProfiles(Inputs);
+    mergeLegacyProfiles(Inputs, NumDecayedInputs);
     return 0;
   }
 
@@ -386,7 +438,8 @@ int main(int argc, char **argv) {
   // Merged information for all functions.
   StringMap<BinaryFunctionProfile> MergedBFs;
 
-  for (std::string &InputDataFilename : Inputs) {
+  for (size_t I = 0; I < Inputs.size(); ++I) {
+    const std::string &InputDataFilename = Inputs[I];
     ErrorOr<std::unique_ptr<MemoryBuffer>> MB =
         MemoryBuffer::getFileOrSTDIN(InputDataFilename);
     if (std::error_code EC = MB.getError())
@@ -410,6 +463,10 @@ int main(int argc, char **argv) {
     // Merge the header.
     mergeProfileHeaders(MergedHeader, BP.Header);
 
+    if (I < NumDecayedInputs)
+      for (BinaryFunctionProfile &BF : BP.Functions)
+        scaleFunctionProfile(BF, opts::Decay);
+
     // Do the function merge.
     for (BinaryFunctionProfile &BF : BP.Functions) {
       if (!MergedBFs.count(BF.Name)) {
@@ -598,6 +598,12 @@ runClangTidy(clang::tidy::ClangTidyContext &Context,
     ClangTidyASTConsumerFactory ConsumerFactory;
   };
 
+  // FIXME: The input files are checked one after the other, each parsing its
+  // headers from scratch. Checking them on several threads would need a
+  // ClangTidyContext and diagnostic consumer per thread, since both track the
+  // current file and its options, with the errors merged and deduplicated
+  // afterwards; run-clang-tidy.py gets the same effect with one process per
+  // file.
   ActionFactory Factory(Context, std::move(BaseFS));
   Tool.run(&Factory);
   return DiagConsumer.take();
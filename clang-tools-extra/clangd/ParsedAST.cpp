@@ -403,6 +403,12 @@ ParsedAST::build(llvm::StringRef Filename, const ParseInputs &Inputs,
                  std::unique_ptr<clang::CompilerInvocation> CI,
                  llvm::ArrayRef<Diag> CompilerInvocationDiags,
                  std::shared_ptr<const PreambleData> Preamble) {
+  // FIXME: Every edit reparses the whole main file, even when it is confined
+  // to one function body. Re-parsing just that body would require removing
+  // the old body's AST nodes from the ASTContext, the redeclaration chains,
+  // the lookup tables and the template instantiations that used it, none of
+  // which Sema supports, and rerunning the PPCallbacks and token collection
+  // that produce the rest of ParsedAST for a partial main file.
   trace::Span Tracer("BuildAST");
   SPAN_ATTACH(Tracer, "File", Filename);
   const Config &Cfg = Config::current();
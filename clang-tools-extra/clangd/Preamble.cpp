@@ -598,6 +598,12 @@ buildPreamble(PathRef FileName, CompilerInvocation CI,
       llvm::MemoryBuffer::getMemBuffer(Inputs.Contents, FileName);
   auto Bounds = ComputePreambleBounds(CI.getLangOpts(), *ContentsBuffer, 0);
 
+  // FIXME: Files with byte-identical preambles and compatible commands still
+  // build one preamble each. The PCH records the main file it was built for:
+  // locations in the preamble region, the include graph and the main-file
+  // macros all belong to that file, and PrecompiledPreamble::CanReuse only
+  // validates against the file it was built from. Sharing would need the
+  // preamble to be built against a synthetic main file and remapped on use.
   trace::Span Tracer("BuildPreamble");
   SPAN_ATTACH(Tracer, "File", FileName);
   std::vector<std::unique_ptr<FeatureModule::ASTListener>> ASTListeners;
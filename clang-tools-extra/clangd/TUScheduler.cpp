@@ -974,7 +974,9 @@ void ASTWorker::runWithAST(
   // Tracks ast cache accesses for read operations.
   static constexpr trace::Metric ASTAccessForRead(
       "ast_access_read", trace::Metric::Counter, "result");
-  auto Task = [=, Action = std::move(Action)]() mutable {
+  // Background indexing yields while this read is pending.
+  auto Task = [=, Action = std::move(Action),
+               Pending = InteractiveRequest()]() mutable {
     if (auto Reason = isCancelled())
       return Action(llvm::make_error<CancelledError>(Reason));
     std::optional<std::unique_ptr<ParsedAST>> AST =
@@ -1782,7 +1784,8 @@ void TUScheduler::runWithPreamble(llvm::StringRef Name, PathRef File,
                Command = Worker->getCurrentCompileCommand(),
                Ctx = Context::current().derive(FileBeingProcessed,
                                                std::string(File)),
-               Action = std::move(Action), this]() mutable {
+               Action = std::move(Action), Pending = InteractiveRequest(),
+               this]() mutable {
     clang::noteBottomOfStack();
     ThreadCrashReporter ScopedReporter([&Name, &Contents, &Command]() {
       llvm::errs() << "Signalled during preamble action: " << Name << "\n";
@@ -24,6 +24,7 @@
 #include "llvm/ADT/StringMap.h"
 #include "llvm/Support/Threading.h"
 #include <atomic>
+#include <chrono>
 #include <condition_variable>
 #include <deque>
 #include <mutex>
@@ -78,6 +79,7 @@ public:
     std::string Tag;       // Allows priority to be boosted later.
     uint64_t Key = 0;      // If the key matches a previous task, drop this one.
                            // (in practice this means we never reindex a file).
+    std::chrono::steady_clock::time_point Enqueued; // Set when queued.
 
     bool operator<(const Task &O) const { return QueuePri < O.QueuePri; }
   };
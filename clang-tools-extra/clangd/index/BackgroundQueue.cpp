@@ -8,13 +8,41 @@
 
 #include "index/Background.h"
 #include "support/Logger.h"
+#include "support/Threading.h"
+#include "support/Trace.h"
 #include <optional>
+#include <thread>
 
 namespace clang {
 namespace clangd {
 
 static std::atomic<bool> PreventStarvation = {false};
 
+// Time from enqueueing a task to starting it, in milliseconds.
+constexpr trace::Metric QueueLatency("background_queue_latency",
+                                     trace::Metric::Distribution);
+// Time a low-priority task spent yielding to interactive requests before
+// starting, in milliseconds.
+constexpr trace::Metric YieldLatency("background_yield_latency",
+                                     trace::Metric::Distribution);
+
+// Delays a low-priority task while interactive requests are pending, so that
+// e.g. completion doesn't compete with indexing for cores. The delay is
+// bounded so indexing still makes progress under sustained load.
+static void yieldToInteractiveRequests() {
+  using namespace std::chrono;
+  constexpr auto MaxYield = milliseconds(500);
+  constexpr auto PollInterval = milliseconds(5);
+  if (!pendingInteractiveRequests())
+    return;
+  auto Start = steady_clock::now();
+  while (pendingInteractiveRequests() &&
+         steady_clock::now() - Start < MaxYield)
+    std::this_thread::sleep_for(PollInterval);
+  YieldLatency.record(
+      duration_cast<milliseconds>(steady_clock::now() - Start).count());
+}
+
 void BackgroundQueue::preventThreadStarvationInTests() {
   PreventStarvation.store(true);
 }
@@ -37,9 +65,14 @@ void BackgroundQueue::work(std::function<void()> OnIdle) {
       notifyProgress();
     }
 
+    QueueLatency.record(std::chrono::duration_cast<std::chrono::milliseconds>(
+                            std::chrono::steady_clock::now() - Task->Enqueued)
+                            .count());
     if (Task->ThreadPri != llvm::ThreadPriority::Default &&
-        !PreventStarvation.load())
+        !PreventStarvation.load()) {
+      yieldToInteractiveRequests();
       llvm::set_thread_priority(Task->ThreadPri);
+    }
     Task->Run();
     if (Task->ThreadPri != llvm::ThreadPriority::Default)
       llvm::set_thread_priority(llvm::ThreadPriority::Default);
@@ -83,6 +116,7 @@ bool BackgroundQueue::adjust(Task &T) {
   if (T.Key && !SeenKeys.insert(T.Key).second)
     return false;
   T.QueuePri = std::max(T.QueuePri, Boosts.lookup(T.Tag));
+  T.Enqueued = std::chrono::steady_clock::now();
   return true;
 }
 
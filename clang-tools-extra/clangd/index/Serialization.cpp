@@ -209,8 +209,12 @@ public:
   }
 };
 
+// The strings point into the (decompressed) table data, which is
+// null-terminated per string. They stay valid as long as the table and the
+// data it was read from; Storage has no inline capacity, so moving the table
+// doesn't move the strings.
 struct StringTableIn {
-  llvm::BumpPtrAllocator Arena;
+  llvm::SmallVector<uint8_t, 0> Storage;
   std::vector<llvm::StringRef> Strings;
 };
 
@@ -220,8 +224,8 @@ llvm::Expected<StringTableIn> readStringTable(llvm::StringRef Data) {
   if (R.err())
     return error("Truncated string table");
 
+  StringTableIn Table;
   llvm::StringRef Uncompressed;
-  llvm::SmallVector<uint8_t, 0> UncompressedStorage;
   if (UncompressedSize == 0) // No compression
     Uncompressed = R.rest();
   else if (llvm::compression::zlib::isAvailable()) {
@@ -235,21 +239,22 @@ llvm::Expected<StringTableIn> readStringTable(llvm::StringRef Data) {
                    R.rest().size(), UncompressedSize);
 
     if (llvm::Error E = llvm::compression::zlib::decompress(
-            llvm::arrayRefFromStringRef(R.rest()), UncompressedStorage,
+            llvm::arrayRefFromStringRef(R.rest()), Table.Storage,
             UncompressedSize))
       return std::move(E);
-    Uncompressed = toStringRef(UncompressedStorage);
+    Uncompressed = toStringRef(Table.Storage);
   } else
     return error("Compressed string table, but zlib is unavailable");
 
-  StringTableIn Table;
-  llvm::StringSaver Saver(Table.Arena);
+  // The strings are used in place rather than copied: the readers copy what
+  // they keep into their own slabs, and a string's terminator is what lets
+  // them be used as C strings.
   R = Reader(Uncompressed);
   for (Reader R(Uncompressed); !R.eof();) {
     auto Len = R.rest().find(0);
     if (Len == llvm::StringRef::npos)
       return error("Bad string table: not null terminated");
-    Table.Strings.push_back(Saver.save(R.consume(Len)));
+    Table.Strings.push_back(R.consume(Len));
     R.consume8();
   }
   if (R.err())
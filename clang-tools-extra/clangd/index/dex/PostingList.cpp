@@ -25,7 +25,7 @@ public:
   explicit ChunkIterator(const Token *Tok, llvm::ArrayRef<Chunk> Chunks)
       : Tok(Tok), Chunks(Chunks), CurrentChunk(Chunks.begin()) {
     if (!Chunks.empty()) {
-      DecompressedChunk = CurrentChunk->decompress();
+      CurrentChunk->decompress(DecompressedChunk);
       CurrentID = DecompressedChunk.begin();
     }
   }
@@ -93,7 +93,7 @@ private:
     ++CurrentChunk;
     if (CurrentChunk == Chunks.end()) // Reached the end of PostingList.
       return;
-    DecompressedChunk = CurrentChunk->decompress();
+    CurrentChunk->decompress(DecompressedChunk);
     CurrentID = DecompressedChunk.begin();
   }
 
@@ -105,7 +105,7 @@ private:
           std::partition_point(CurrentChunk + 1, Chunks.end(),
                                [&](const Chunk &C) { return C.Head < ID; });
       --CurrentChunk;
-      DecompressedChunk = CurrentChunk->decompress();
+      CurrentChunk->decompress(DecompressedChunk);
       CurrentID = DecompressedChunk.begin();
     }
   }
@@ -181,38 +181,34 @@ std::vector<Chunk> encodeStream(llvm::ArrayRef<DocID> Documents) {
   return std::vector<Chunk>(Result); // no move, shrink-to-fit
 }
 
-/// Reads variable length DocID from the buffer and updates the buffer size. If
-/// the stream is terminated, return std::nullopt.
-std::optional<DocID> readVByte(llvm::ArrayRef<uint8_t> &Bytes) {
-  if (Bytes.front() == 0 || Bytes.empty())
-    return std::nullopt;
-  DocID Result = 0;
-  bool HasNextByte = true;
-  for (size_t Length = 0; HasNextByte && !Bytes.empty(); ++Length) {
-    assert(Length <= 5 && "Malformed VByte encoding sequence.");
-    // Write meaningful bits to the correct place in the document decoding.
-    Result |= (Bytes.front() & 0x7f) << (BitsPerEncodingByte * Length);
-    if ((Bytes.front() & 0x80) == 0)
-      HasNextByte = false;
-    Bytes = Bytes.drop_front();
-  }
-  return Result;
-}
-
 } // namespace
 
 llvm::SmallVector<DocID, Chunk::PayloadSize + 1> Chunk::decompress() const {
-  llvm::SmallVector<DocID, Chunk::PayloadSize + 1> Result{Head};
-  llvm::ArrayRef<uint8_t> Bytes(Payload);
-  DocID Delta;
-  for (DocID Current = Head; !Bytes.empty(); Current += Delta) {
-    auto MaybeDelta = readVByte(Bytes);
-    if (!MaybeDelta)
-      break;
-    Delta = *MaybeDelta;
-    Result.push_back(Current + Delta);
+  llvm::SmallVector<DocID, Chunk::PayloadSize + 1> Result;
+  decompress(Result);
+  return Result;
+}
+
+void Chunk::decompress(llvm::SmallVectorImpl<DocID> &Out) const {
+  Out.clear();
+  Out.push_back(Head);
+  DocID Current = Head;
+  // Decode the VByte deltas in a single pass over the payload. A zero byte
+  // can't start a valid encoding, so it marks the end of the stream.
+  size_t I = 0;
+  while (I < PayloadSize && Payload[I] != 0) {
+    uint8_t Byte = Payload[I++];
+    DocID Delta = Byte & 0x7f;
+    for (unsigned Shift = BitsPerEncodingByte; (Byte & 0x80) && I < PayloadSize;
+         Shift += BitsPerEncodingByte) {
+      assert(Shift < BitsPerEncodingByte * 5 &&
+             "Malformed VByte encoding sequence.");
+      Byte = Payload[I++];
+      Delta |= DocID(Byte & 0x7f) << Shift;
+    }
+    Current += Delta;
+    Out.push_back(Current);
   }
-  return llvm::SmallVector<DocID, Chunk::PayloadSize + 1>{Result};
 }
 
 PostingList::PostingList(llvm::ArrayRef<DocID> Documents)
@@ -22,6 +22,7 @@
 #include "support/ThreadsafeFS.h"
 #include "support/Trace.h"
 #include "llvm/ADT/IntrusiveRefCntPtr.h"
+#include "llvm/ADT/StringMap.h"
 #include "llvm/ADT/StringRef.h"
 #include "llvm/Support/Chrono.h"
 #include "llvm/Support/CommandLine.h"
@@ -32,14 +33,18 @@
 #include "llvm/Support/Signals.h"
 #include "llvm/Support/VirtualFileSystem.h"
 
+#include <atomic>
 #include <chrono>
 #include <grpc++/grpc++.h>
 #include <grpc++/health_check_service_interface.h>
+#include <list>
 #include <memory>
+#include <mutex>
 #include <optional>
 #include <string>
 #include <thread>
 #include <utility>
+#include <vector>
 
 #if ENABLE_GRPC_REFLECTION
 #include <grpc++/ext/proto_server_reflection_plugin.h>
@@ -111,12 +116,92 @@ llvm::cl::opt<size_t> LimitResults(
                    "single request. Limit is to keep the server from being "
                    "DOS'd. Defaults to 10000."));
 
+llvm::cl::opt<size_t> CacheSize(
+    "cache-size", llvm::cl::init(0),
+    llvm::cl::desc("Number of most recent FuzzyFind and Refs responses to "
+                   "keep in memory and replay for identical requests. The "
+                   "cache is dropped whenever the index is reloaded. Defaults "
+                   "to 0 (disabled)."));
+
 static Key<grpc::ServerContext *> CurrentRequest;
 
+// LRU cache of the streamed replies to recent requests, keyed by the
+// serialized request message. Editors tend to issue the same queries over and
+// over (e.g. find-references on a symbol under the cursor), so replaying the
+// replies saves both the index query and the conversion to protobuf.
+template <typename ReplyT> class ReplyCache {
+public:
+  using Replies = std::vector<ReplyT>;
+
+  ReplyCache(size_t Capacity) : Capacity(Capacity) {}
+
+  bool enabled() const { return Capacity != 0; }
+
+  // Returns the replies previously recorded for \p Key, or null.
+  std::shared_ptr<const Replies> get(llvm::StringRef Key) {
+    std::lock_guard<std::mutex> Lock(Mu);
+    auto It = Lookup.find(Key);
+    if (It == Lookup.end())
+      return nullptr;
+    Entries.splice(Entries.begin(), Entries, It->second);
+    return It->second->second;
+  }
+
+  // Generation to pass to put(), which must be obtained before querying the
+  // index so that results computed against a replaced index are dropped.
+  unsigned generation() const { return Generation.load(); }
+
+  void put(llvm::StringRef Key, unsigned Gen, Replies R) {
+    if (!enabled())
+      return;
+    std::lock_guard<std::mutex> Lock(Mu);
+    if (Gen != Generation.load() || Lookup.count(Key))
+      return;
+    Entries.emplace_front(Key.str(),
+                          std::make_shared<const Replies>(std::move(R)));
+    Lookup[Key] = Entries.begin();
+    if (Entries.size() > Capacity) {
+      Lookup.erase(Entries.back().first);
+      Entries.pop_back();
+    }
+  }
+
+  void clear() {
+    std::lock_guard<std::mutex> Lock(Mu);
+    ++Generation;
+    Lookup.clear();
+    Entries.clear();
+  }
+
+private:
+  using EntryList =
+      std::list<std::pair<std::string, std::shared_ptr<const Replies>>>;
+
+  const size_t Capacity;
+  std::mutex Mu;
+  std::atomic<unsigned> Generation = {0};
+  EntryList Entries;
+  llvm::StringMap<typename EntryList::iterator> Lookup;
+};
+
+// Caches shared between the server and the index reloading thread.
+struct ReplyCaches {
+  ReplyCaches(size_t Capacity) : FuzzyFind(Capacity), Refs(Capacity) {}
+
+  void clear() {
+    FuzzyFind.clear();
+    Refs.clear();
+  }
+
+  ReplyCache<FuzzyFindReply> FuzzyFind;
+  ReplyCache<RefsReply> Refs;
+};
+
 class RemoteIndexServer final : public v1::SymbolIndex::Service {
 public:
-  RemoteIndexServer(clangd::SymbolIndex &Index, llvm::StringRef IndexRoot)
-      : Index(Index) {
+  RemoteIndexServer(clangd::SymbolIndex &Index, llvm::StringRef IndexRoot,
+                    ReplyCaches &Caches)
+      : Index(Index), Caches(Caches) {
     llvm::SmallString<256> NativePath = IndexRoot;
     llvm::sys::path::native(NativePath);
     ProtobufMarshaller = std::unique_ptr<Marshaller>(new Marshaller(
@@ -179,6 +264,17 @@ private:
     WithContextValue WithRequestContext(CurrentRequest, Context);
     logRequest(*Request);
     trace::Span Tracer("FuzzyFindRequest");
+    std::string CacheKey;
+    if (Caches.FuzzyFind.enabled()) {
+      CacheKey = Request->SerializeAsString();
+      if (auto Cached = Caches.FuzzyFind.get(CacheKey)) {
+        replayReplies(*Cached, Reply);
+        SPAN_ATTACH(Tracer, "Cached", true);
+        logRequestSummary("v1/FuzzyFind", Cached->size() - 1, StartTime);
+        return grpc::Status::OK;
+      }
+    }
+    unsigned Generation = Caches.FuzzyFind.generation();
     auto Req = ProtobufMarshaller->fromProtobuf(Request);
     if (!Req) {
       elog("Can not parse FuzzyFindRequest from protobuf: {0}",
@@ -192,6 +288,7 @@ private:
     }
     unsigned Sent = 0;
     unsigned FailedToSend = 0;
+    std::vector<FuzzyFindReply> Recorded;
     bool HasMore = Index.fuzzyFind(*Req, [&](const clangd::Symbol &Item) {
       auto SerializedItem = ProtobufMarshaller->toProtobuf(Item);
       if (!SerializedItem) {
@@ -204,12 +301,18 @@ private:
       *NextMessage.mutable_stream_result() = *SerializedItem;
       logResponse(NextMessage);
       Reply->Write(NextMessage);
+      if (!CacheKey.empty())
+        Recorded.push_back(std::move(NextMessage));
       ++Sent;
     });
     FuzzyFindReply LastMessage;
     LastMessage.mutable_final_result()->set_has_more(HasMore);
     logResponse(LastMessage);
     Reply->Write(LastMessage);
+    if (!CacheKey.empty()) {
+      Recorded.push_back(std::move(LastMessage));
+      Caches.FuzzyFind.put(CacheKey, Generation, std::move(Recorded));
+    }
     SPAN_ATTACH(Tracer, "Sent", Sent);
     SPAN_ATTACH(Tracer, "Failed to send", FailedToSend);
     logRequestSummary("v1/FuzzyFind", Sent, StartTime);
@@ -222,6 +325,17 @@ private:
     WithContextValue WithRequestContext(CurrentRequest, Context);
     logRequest(*Request);
     trace::Span Tracer("RefsRequest");
+    std::string CacheKey;
+    if (Caches.Refs.enabled()) {
+      CacheKey = Request->SerializeAsString();
+      if (auto Cached = Caches.Refs.get(CacheKey)) {
+        replayReplies(*Cached, Reply);
+        SPAN_ATTACH(Tracer, "Cached", true);
+        logRequestSummary("v1/Refs", Cached->size() - 1, StartTime);
+        return grpc::Status::OK;
+      }
+    }
+    unsigned Generation = Caches.Refs.generation();
     auto Req = ProtobufMarshaller->fromProtobuf(Request);
     if (!Req) {
       elog("Can not parse RefsRequest from protobuf: {0}", Req.takeError());
@@ -234,6 +348,7 @@ private:
     }
     unsigned Sent = 0;
     unsigned FailedToSend = 0;
+    std::vector<RefsReply> Recorded;
     bool HasMore = Index.refs(*Req, [&](const clangd::Ref &Item) {
       auto SerializedItem = ProtobufMarshaller->toProtobuf(Item);
       if (!SerializedItem) {
@@ -246,12 +361,18 @@ private:
       *NextMessage.mutable_stream_result() = *SerializedItem;
       logResponse(NextMessage);
       Reply->Write(NextMessage);
+      if (!CacheKey.empty())
+        Recorded.push_back(std::move(NextMessage));
       ++Sent;
     });
     RefsReply LastMessage;
     LastMessage.mutable_final_result()->set_has_more(HasMore);
     logResponse(LastMessage);
     Reply->Write(LastMessage);
+    if (!CacheKey.empty()) {
+      Recorded.push_back(std::move(LastMessage));
+      Caches.Refs.put(CacheKey, Generation, std::move(Recorded));
+    }
     SPAN_ATTACH(Tracer, "Sent", Sent);
     SPAN_ATTACH(Tracer, "Failed to send", FailedToSend);
     logRequestSummary("v1/Refs", Sent, StartTime);
@@ -319,6 +440,14 @@ private:
   void logResponse(const google::protobuf::Message &M) {
     vlog(">>> {0}\n{1}", M.GetDescriptor()->name(), TextProto{M});
   }
+  template <typename ReplyT>
+  void replayReplies(const std::vector<ReplyT> &Replies,
+                     grpc::ServerWriter<ReplyT> *Reply) {
+    for (const ReplyT &Message : Replies) {
+      logResponse(Message);
+      Reply->Write(Message);
+    }
+  }
   void logRequestSummary(llvm::StringLiteral RequestName, unsigned Sent,
                          stopwatch::time_point StartTime) {
     auto Duration = stopwatch::now() - StartTime;
@@ -330,6 +459,7 @@ private:
 
   std::unique_ptr<Marshaller> ProtobufMarshaller;
   clangd::SymbolIndex &Index;
+  ReplyCaches &Caches;
 };
 
 class Monitor final : public v1::Monitor::Service {
@@ -377,7 +507,7 @@ void maybeTrimMemory() {
 void hotReload(clangd::SwapIndex &Index, llvm::StringRef IndexPath,
                llvm::vfs::Status &LastStatus,
                llvm::IntrusiveRefCntPtr<llvm::vfs::FileSystem> &FS,
-               Monitor &Monitor) {
+               Monitor &Monitor, ReplyCaches &Caches) {
   // glibc malloc doesn't shrink an arena if there are items living at the end,
   // which might happen since we destroy the old index after building new one.
   // Trim more aggresively to keep memory usage of the server low.
@@ -402,14 +532,16 @@ void hotReload(clangd::SwapIndex &Index, llvm::StringRef IndexPath,
     return;
   }
   Index.reset(std::move(NewIndex));
+  Caches.clear();
   Monitor.updateIndex(Status->getLastModificationTime());
   log("New index version loaded. Last modification time: {0}, size: {1} bytes.",
       Status->getLastModificationTime(), Status->getSize());
 }
 
 void runServerAndWait(clangd::SymbolIndex &Index, llvm::StringRef ServerAddress,
-                      llvm::StringRef IndexPath, Monitor &Monitor) {
-  RemoteIndexServer Service(Index, IndexRoot);
+                      llvm::StringRef IndexPath, Monitor &Monitor,
+                      ReplyCaches &Caches) {
+  RemoteIndexServer Service(Index, IndexRoot, Caches);
 
   grpc::EnableDefaultHealthCheckService(true);
 #if ENABLE_GRPC_REFLECTION
@@ -543,17 +675,19 @@ int main(int argc, char *argv[]) {
   clang::clangd::SwapIndex Index(std::move(SymIndex));
 
   Monitor Monitor(Status->getLastModificationTime());
+  ReplyCaches Caches(CacheSize);
 
-  std::thread HotReloadThread([&Index, &Status, &FS, &Monitor]() {
+  std::thread HotReloadThread([&Index, &Status, &FS, &Monitor, &Caches]() {
     llvm::vfs::Status LastStatus = *Status;
     static constexpr auto RefreshFrequency = std::chrono::seconds(30);
     while (!clang::clangd::shutdownRequested()) {
-      hotReload(Index, llvm::StringRef(IndexPath), LastStatus, FS, Monitor);
+      hotReload(Index, llvm::StringRef(IndexPath), LastStatus, FS, Monitor,
+                Caches);
       std::this_thread::sleep_for(RefreshFrequency);
     }
   });
 
-  runServerAndWait(Index, ServerAddress, IndexPath, Monitor);
+  runServerAndWait(Index, ServerAddress, IndexPath, Monitor, Caches);
 
   HotReloadThread.join();
 }
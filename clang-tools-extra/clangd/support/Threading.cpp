@@ -127,6 +127,21 @@ void wait(std::unique_lock<std::mutex> &Lock, std::condition_variable &CV,
   CV.wait_until(Lock, D.time());
 }
 
+static std::atomic<unsigned> PendingInteractiveRequests = {0};
+
+InteractiveRequest::InteractiveRequest() {
+  PendingInteractiveRequests.fetch_add(1, std::memory_order_relaxed);
+}
+
+InteractiveRequest::~InteractiveRequest() {
+  if (Active)
+    PendingInteractiveRequests.fetch_sub(1, std::memory_order_relaxed);
+}
+
+unsigned pendingInteractiveRequests() {
+  return PendingInteractiveRequests.load(std::memory_order_relaxed);
+}
+
 bool PeriodicThrottler::operator()() {
   Rep Now = Stopwatch::now().time_since_epoch().count();
   Rep OldNext = Next.load(std::memory_order_acquire);
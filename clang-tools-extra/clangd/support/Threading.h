@@ -172,6 +172,28 @@ public:
   }
 };
 
+/// Held while a latency-sensitive request (e.g. hover or completion) is queued
+/// or running. Background work can yield while any are alive, see
+/// pendingInteractiveRequests().
+/// This class is threadsafe.
+class InteractiveRequest {
+public:
+  InteractiveRequest();
+  ~InteractiveRequest();
+  InteractiveRequest(InteractiveRequest &&Other) : Active(Other.Active) {
+    Other.Active = false;
+  }
+  InteractiveRequest(const InteractiveRequest &) = delete;
+  InteractiveRequest &operator=(const InteractiveRequest &) = delete;
+  InteractiveRequest &operator=(InteractiveRequest &&) = delete;
+
+private:
+  bool Active = true;
+};
+
+/// Returns the number of live InteractiveRequest objects.
+unsigned pendingInteractiveRequests();
+
 /// Used to guard an operation that should run at most every N seconds.
 ///
 /// Usage:
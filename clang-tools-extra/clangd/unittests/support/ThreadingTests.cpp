@@ -122,6 +122,22 @@ TEST_F(ThreadingTest, MemoizeDeterministic) {
   ASSERT_THAT(ValueA.load(), testing::AnyOf('A', 'B'));
 }
 
+TEST(InteractiveRequestTest, Counts) {
+  unsigned Before = pendingInteractiveRequests();
+  {
+    InteractiveRequest A;
+    EXPECT_EQ(pendingInteractiveRequests(), Before + 1);
+    {
+      InteractiveRequest B(std::move(A)); // Moving doesn't double count.
+      EXPECT_EQ(pendingInteractiveRequests(), Before + 1);
+      InteractiveRequest C;
+      EXPECT_EQ(pendingInteractiveRequests(), Before + 2);
+    }
+    EXPECT_EQ(pendingInteractiveRequests(), Before);
+  }
+  EXPECT_EQ(pendingInteractiveRequests(), Before);
+}
+
 // It's hard to write a real test of this class, std::chrono is awkward to mock.
 // But test some degenerate cases at least.
 TEST(PeriodicThrottlerTest, Minimal) {
@@ -620,6 +620,9 @@ private:
   /// AST objects will be released when the ASTContext itself is destroyed.
   mutable llvm::BumpPtrAllocator BumpAlloc;
 
+  /// The number of declarations allocated in this context.
+  mutable unsigned NumDeclsAllocated = 0;
+
   /// Allocator for partial diagnostics.
   PartialDiagnostic::DiagStorageAllocator DiagAllocator;
 
@@ -747,6 +750,17 @@ public:
     return BumpAlloc.getTotalMemory();
   }
 
+  /// Return the number of bytes handed out for AST nodes and type
+  /// information so far.
+  size_t getASTAllocatedBytes() const { return BumpAlloc.getBytesAllocated(); }
+
+  /// Return the number of declarations allocated in this context so far,
+  /// including deserialized ones.
+  unsigned getNumDeclsAllocated() const { return NumDeclsAllocated; }
+
+  /// Note that a declaration was allocated in this context.
+  void noteDeclAllocated() const { ++NumDeclsAllocated; }
+
   /// Return the total memory used for various side tables.
   size_t getSideTableAllocatedMemory() const;
 
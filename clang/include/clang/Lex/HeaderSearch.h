@@ -331,6 +331,31 @@ class HeaderSearch {
   };
   llvm::StringMap<LookupFileCacheInfo, llvm::BumpPtrAllocator> LookupFileCache;
 
+  /// A search directory lookup recorded in the persistent header search cache:
+  /// searching from the directory at index \c StartIdx found the file in the
+  /// directory at index \c HitIdx, or nowhere if \c HitIdx is the number of
+  /// search directories.
+  struct PersistentLookup {
+    unsigned StartIdx;
+    unsigned HitIdx;
+  };
+
+  /// Lookups loaded from and to be written to -fheader-search-cache=, keyed by
+  /// the spelling of the file name. Only valid while the search directories
+  /// keep the modification times in \c SearchDirModTimes.
+  llvm::StringMap<SmallVector<PersistentLookup, 1>> PersistentLookups;
+
+  /// The modification times of the search directories (zero for header maps
+  /// and frameworks) taken before the first lookup of this compilation.
+  SmallVector<uint64_t, 0> SearchDirModTimes;
+
+  /// Whether -fheader-search-cache= has been read for the current search
+  /// directories.
+  bool PersistentLookupCacheLoaded = false;
+
+  /// Whether new lookups were added to \c PersistentLookups since it was read.
+  bool PersistentLookupCacheDirty = false;
+
   /// Collection mapping a framework or subframework
   /// name like "Carbon" to the Carbon.framework directory.
   llvm::StringMap<FrameworkCacheEntry, llvm::BumpPtrAllocator> FrameworkMap;
@@ -930,7 +955,18 @@ public:
 
   size_t getTotalMemory() const;
 
+  /// Write the lookups of this compilation to -fheader-search-cache=, if set,
+  /// merged with the ones read from it.
+  void writePersistentLookupCache();
+
 private:
+  /// Read -fheader-search-cache= and snapshot the search directory times.
+  void loadPersistentLookupCache();
+
+  /// Record the result of a search directory walk in the persistent cache.
+  void notePersistentLookup(StringRef Filename, unsigned StartIdx,
+                            unsigned HitIdx);
+
   /// Describes what happened when we tried to load a module map file.
   enum LoadModuleMapResult {
     /// The module map file had already been loaded.
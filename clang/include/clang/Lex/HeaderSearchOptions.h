@@ -117,6 +117,10 @@ public:
   /// The directory used for a user build.
   std::string ModuleUserBuildPath;
 
+  /// The file used to persist header search results across invocations
+  /// (-fheader-search-cache=). Empty if disabled.
+  std::string HeaderSearchCachePath;
+
   /// The mapping of module names to prebuilt module files.
   std::map<std::string, std::string, std::less<>> PrebuiltModuleFiles;
 
@@ -271,6 +275,12 @@ public:
   LLVM_PREFERRED_TYPE(bool)
   unsigned ModulesIncludeVFSUsage : 1;
 
+  /// Whether to memory-map module files instead of reading them into heap
+  /// buffers. Module files are replaced by renaming, never rewritten in place,
+  /// so concurrent compiler processes can share the mapped pages.
+  LLVM_PREFERRED_TYPE(bool)
+  unsigned ModulesMmapPCMs : 1;
+
   HeaderSearchOptions(StringRef _Sysroot = "/")
       : Sysroot(_Sysroot), ModuleFormat("raw"), DisableModuleHash(false),
         ImplicitModuleMaps(false), ModuleMapFileHomeIsCwd(false),
@@ -286,7 +296,8 @@ public:
         ModulesSkipHeaderSearchPaths(false),
         ModulesSkipPragmaDiagnosticMappings(false),
         ModulesPruneNonAffectingModuleMaps(true), ModulesHashContent(false),
-        ModulesStrictContextHash(false), ModulesIncludeVFSUsage(false) {}
+        ModulesStrictContextHash(false), ModulesIncludeVFSUsage(false),
+        ModulesMmapPCMs(false) {}
 
   /// AddPath - Add the \p Path path to the specified \p Group list.
   void AddPath(StringRef Path, frontend::IncludeDirGroup Group,
@@ -26,6 +26,10 @@
 #include <optional>
 #include <utility>
 
+namespace llvm {
+class TimeTraceScope;
+} // namespace llvm
+
 namespace clang {
 
 class ASTContext;
@@ -43,6 +47,26 @@ class TypedefNameDecl;
 class TypeSourceInfo;
 class VarDecl;
 
+/// Records the AST memory allocated and the number of declarations created
+/// while it is alive as arguments of a time trace section, so that costly
+/// instantiations can be found with the -ftime-trace tooling.
+class TimeTraceASTAllocationScope {
+  const ASTContext &Context;
+  llvm::TimeTraceScope &TimeScope;
+  bool Enabled;
+  size_t StartBytes = 0;
+  unsigned StartDecls = 0;
+
+public:
+  TimeTraceASTAllocationScope(const ASTContext &Context,
+                              llvm::TimeTraceScope &TimeScope);
+  ~TimeTraceASTAllocationScope();
+
+  TimeTraceASTAllocationScope(const TimeTraceASTAllocationScope &) = delete;
+  TimeTraceASTAllocationScope &
+  operator=(const TimeTraceASTAllocationScope &) = delete;
+};
+
 /// The kind of template substitution being performed.
 enum class TemplateSubstitutionKind : char {
   /// We are substituting template parameters for template arguments in order
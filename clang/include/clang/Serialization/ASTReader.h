@@ -671,7 +671,7 @@ private:
   /// If the pointer at index I is non-NULL, then it refers to the
   /// IdentifierInfo for the identifier with ID=I+1 that has already
   /// been loaded.
-  std::vector<IdentifierInfo *> IdentifiersLoaded;
+  llvm::PagedVector<IdentifierInfo *> IdentifiersLoaded;
 
   using GlobalIdentifierMapType =
       ContinuousRangeMap<serialization::IdentID, ModuleFile *, 4>;
@@ -687,7 +687,7 @@ private:
   /// If the pointer at index I is non-NULL, then it refers to the
   /// MacroInfo for the identifier with ID=I+1 that has already
   /// been loaded.
-  std::vector<MacroInfo *> MacrosLoaded;
+  llvm::PagedVector<MacroInfo *> MacrosLoaded;
 
   using LoadedMacroInfo =
       std::pair<IdentifierInfo *, serialization::SubmoduleID>;
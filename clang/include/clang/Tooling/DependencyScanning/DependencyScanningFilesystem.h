@@ -16,6 +16,7 @@
 #include "llvm/Support/Allocator.h"
 #include "llvm/Support/ErrorOr.h"
 #include "llvm/Support/VirtualFileSystem.h"
+#include <atomic>
 #include <mutex>
 #include <optional>
 
@@ -220,9 +221,39 @@ public:
   CacheShard &getShardForFilename(StringRef Filename) const;
   CacheShard &getShardForUID(llvm::sys::fs::UniqueID UID) const;
 
+  /// Sets the directory in which the dependency directives of scanned files
+  /// are persisted across runs, keyed by a hash of the file contents. An
+  /// empty path disables the persistent cache. Entries are never removed
+  /// here; clients are expected to bound the directory with
+  /// llvm::pruneCache().
+  void setDirectivesCachePath(StringRef Path) {
+    DirectivesCachePath = Path.str();
+  }
+  StringRef getDirectivesCachePath() const { return DirectivesCachePath; }
+
+  /// Returns the filenames of all cached entries whose status in \p FS no
+  /// longer matches the cached status, e.g. because the file was modified,
+  /// created or removed since it was cached.
+  std::vector<std::string>
+  getOutOfDateEntries(llvm::vfs::FileSystem &FS) const;
+
+  /// Drops the entries (and real paths) cached for \p Filename and for all
+  /// other filenames that share its contents, so that the next lookup goes to
+  /// the underlying filesystem again. Worker filesystems
+  /// notice the invalidation and drop their local caches before their next
+  /// lookup. Entries handed out previously remain valid.
+  void invalidate(StringRef Filename);
+
+  /// Returns a counter that is incremented on each invalidation.
+  unsigned getGeneration() const {
+    return Generation.load(std::memory_order_acquire);
+  }
+
 private:
   std::unique_ptr<CacheShard[]> CacheShards;
   unsigned NumShards;
+  std::string DirectivesCachePath;
+  std::atomic<unsigned> Generation{0};
 };
 
 /// This class is a local cache, that caches the 'stat' and 'open' calls to the
@@ -234,6 +265,9 @@ class DependencyScanningFilesystemLocalCache {
       Cache;
 
 public:
+  /// Drops all cached entries.
+  void clear() { Cache.clear(); }
+
   /// Returns entry associated with the filename or nullptr if none is found.
   const CachedFileSystemEntry *findEntryByFilename(StringRef Filename) const {
     assert(llvm::sys::path::is_absolute_gnu(Filename));
@@ -400,6 +434,16 @@ private:
   const CachedFileSystemEntry &
   getOrEmplaceSharedEntryForUID(TentativeEntry TEntry);
 
+  /// Drops the local cache if the shared cache was invalidated since the local
+  /// cache was last populated.
+  void syncLocalCache() {
+    unsigned Generation = SharedCache.getGeneration();
+    if (Generation != LocalCacheGeneration) {
+      LocalCache.clear();
+      LocalCacheGeneration = Generation;
+    }
+  }
+
   /// Returns entry associated with the filename or nullptr if none is found.
   ///
   /// Returns entry from local cache if there is some. Otherwise, if the entry
@@ -455,6 +499,8 @@ private:
   /// The local cache is used by the worker thread to cache file system queries
   /// locally instead of querying the global cache every time.
   DependencyScanningFilesystemLocalCache LocalCache;
+  /// The generation of the shared cache the local cache is consistent with.
+  unsigned LocalCacheGeneration = 0;
 
   /// The working directory to use for making relative paths absolute before
   /// using them for cache lookups.
@@ -78,6 +78,7 @@ void *Decl::operator new(std::size_t Size, const ASTContext &Context,
                 "Decl won't be misaligned");
   void *Start = Context.Allocate(Size + Extra + 8);
   void *Result = (char*)Start + 8;
+  Context.noteDeclAllocated();
 
   unsigned *PrefixPtr = (unsigned *)Result - 2;
 
@@ -93,6 +94,7 @@ void *Decl::operator new(std::size_t Size, const ASTContext &Context,
 void *Decl::operator new(std::size_t Size, const ASTContext &Ctx,
                          DeclContext *Parent, std::size_t Extra) {
   assert(!Parent || &Parent->getParentASTContext() == &Ctx);
+  Ctx.noteDeclAllocated();
   // With local visibility enabled, we track the owning module even for local
   // declarations. We create the TU decl early and may not yet know what the
   // LangOpts are, so conservatively allocate the storage.
@@ -24,6 +24,14 @@
 #include <limits>
 #include <vector>
 
+// Dispatch the interpreter loop through a table of label addresses where the
+// compiler supports it; this is a GNU extension that Clang and GCC implement.
+#if defined(__GNUC__)
+#define CLANG_INTERP_COMPUTED_GOTO 1
+#else
+#define CLANG_INTERP_COMPUTED_GOTO 0
+#endif
+
 using namespace clang;
 
 using namespace clang;
@@ -704,16 +712,56 @@ bool Interpret(InterpState &S, APValue &Result) {
   if (!PC)
     return true;
 
+#if CLANG_INTERP_COMPUTED_GOTO
+  // Every handler jumps straight to the handler of the next opcode, so that
+  // each of them gets its own indirect branch to predict.
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wpedantic"
+#ifdef __clang__
+#pragma clang diagnostic ignored "-Wgnu-label-as-value"
+#endif
+  static const void *const DispatchTable[] = {
+#define INTERP_DISPATCH_ENTRY(Name) &&Handle_##Name,
+#define GET_INTERP_DISPATCH_TABLE
+#include "Opcodes.inc"
+#undef GET_INTERP_DISPATCH_TABLE
+#undef INTERP_DISPATCH_ENTRY
+  };
+
+  Opcode Op;
+  CodePtr OpPC;
+#define INTERP_CASE(Name) Handle_##Name:
+#define INTERP_NEXT                                                            \
+  do {                                                                         \
+    Op = PC.read<Opcode>();                                                    \
+    OpPC = PC;                                                                 \
+    goto *DispatchTable[Op];                                                   \
+  } while (0)
+
+  INTERP_NEXT;
+#define GET_INTERP
+#include "Opcodes.inc"
+#undef GET_INTERP
+#undef INTERP_NEXT
+#undef INTERP_CASE
+#pragma GCC diagnostic pop
+  llvm_unreachable("Opcode handlers do not fall through");
+#else
   for (;;) {
     auto Op = PC.read<Opcode>();
     CodePtr OpPC = PC;
 
     switch (Op) {
+#define INTERP_CASE(Name) case Name:
+#define INTERP_NEXT continue
 #define GET_INTERP
 #include "Opcodes.inc"
 #undef GET_INTERP
+#undef INTERP_NEXT
+#undef INTERP_CASE
     }
   }
+#endif
 }
 
 } // namespace interp
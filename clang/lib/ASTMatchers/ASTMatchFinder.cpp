@@ -22,6 +22,7 @@
 #include "clang/AST/RecursiveASTVisitor.h"
 #include "llvm/ADT/DenseMap.h"
 #include "llvm/ADT/SmallPtrSet.h"
+#include "llvm/ADT/Statistic.h"
 #include "llvm/ADT/StringMap.h"
 #include "llvm/Support/PrettyStackTrace.h"
 #include "llvm/Support/Timer.h"
@@ -29,6 +30,19 @@
 #include <memory>
 #include <set>
 
+#define DEBUG_TYPE "ast-matchers"
+
+STATISTIC(NumMemoizedChildHits,
+          "Number of child and descendant matches found in the cache");
+STATISTIC(NumMemoizedChildMisses,
+          "Number of child and descendant matches missing from the cache");
+STATISTIC(NumMemoizedAncestorHits,
+          "Number of ancestor matches found in the cache");
+STATISTIC(NumMemoizedAncestorMisses,
+          "Number of ancestor matches missing from the cache");
+STATISTIC(NumMemoizationResets,
+          "Number of times the match cache was full and cleared");
+
 namespace clang {
 namespace ast_matchers {
 namespace internal {
@@ -611,9 +625,11 @@ public:
     Key.Type = MaxDepth == 1 ? MatchType::Child : MatchType::Descendants;
     MemoizationMap::iterator I = ResultCache.find(Key);
     if (I != ResultCache.end()) {
+      ++NumMemoizedChildHits;
       *Builder = I->second.Nodes;
       return I->second.ResultOfMatch;
     }
+    ++NumMemoizedChildMisses;
 
     MemoizedMatchResult Result;
     Result.Nodes = *Builder;
@@ -667,12 +683,20 @@ public:
                               bool Directly) override;
 
 public:
+  // Bounds the memory used by the memoization cache. Must not be called while
+  // a recursive match holds iterators into the cache.
+  void clearCacheIfFull() {
+    if (ResultCache.size() > MaxMemoizationEntries) {
+      ++NumMemoizationResets;
+      ResultCache.clear();
+    }
+  }
+
   // Implements ASTMatchFinder::matchesChildOf.
   bool matchesChildOf(const DynTypedNode &Node, ASTContext &Ctx,
                       const DynTypedMatcher &Matcher,
                       BoundNodesTreeBuilder *Builder, BindKind Bind) override {
-    if (ResultCache.size() > MaxMemoizationEntries)
-      ResultCache.clear();
+    clearCacheIfFull();
     return memoizedMatchesRecursively(Node, Ctx, Matcher, Builder, 1, Bind);
   }
   // Implements ASTMatchFinder::matchesDescendantOf.
@@ -680,8 +704,7 @@ public:
                            const DynTypedMatcher &Matcher,
                            BoundNodesTreeBuilder *Builder,
                            BindKind Bind) override {
-    if (ResultCache.size() > MaxMemoizationEntries)
-      ResultCache.clear();
+    clearCacheIfFull();
     return memoizedMatchesRecursively(Node, Ctx, Matcher, Builder, INT_MAX,
                                       Bind);
   }
@@ -692,8 +715,7 @@ public:
                          AncestorMatchMode MatchMode) override {
     // Reset the cache outside of the recursive call to make sure we
     // don't invalidate any iterators.
-    if (ResultCache.size() > MaxMemoizationEntries)
-      ResultCache.clear();
+    clearCacheIfFull();
     if (MatchMode == AncestorMatchMode::AMM_ParentOnly)
       return matchesParentOf(Node, Matcher, Builder);
     return matchesAnyAncestorOf(Node, Ctx, Matcher, Builder);
@@ -1047,18 +1069,28 @@ private:
     const bool EnableCheckProfiling = Options.CheckProfiling.has_value();
     TimeBucketRegion Timer;
     auto &Matchers = this->Matchers->DeclOrStmt;
+    // Whether the node is skipped only depends on the traversal kind, so work
+    // it out once per kind rather than once per matcher.
+    const TraversalKind DefaultTraversal =
+        getASTContext().getParentMapContext().getTraversalKind();
+    std::optional<bool>
+        IsIgnoredByTraversal[TK_IgnoreUnlessSpelledInSource + 1];
     for (unsigned short I : Filter) {
       auto &MP = Matchers[I];
       if (EnableCheckProfiling)
         Timer.setBucket(&TimeByBucket[MP.second->getID()]);
       BoundNodesTreeBuilder Builder;
 
-      {
-        TraversalKindScope RAII(getASTContext(), MP.first.getTraversalKind());
-        if (getASTContext().getParentMapContext().traverseIgnored(DynNode) !=
-            DynNode)
-          continue;
+      TraversalKind TK = MP.first.getTraversalKind().value_or(DefaultTraversal);
+      std::optional<bool> &IsIgnored = IsIgnoredByTraversal[TK];
+      if (!IsIgnored) {
+        TraversalKindScope RAII(getASTContext(), TK);
+        IsIgnored =
+            getASTContext().getParentMapContext().traverseIgnored(DynNode) !=
+            DynNode;
       }
+      if (*IsIgnored)
+        continue;
 
       CurMatchRAII RAII(*this, MP.second, DynNode);
       if (MP.first.matches(DynNode, this, &Builder)) {
@@ -1179,10 +1211,12 @@ private:
         // Check the cache.
         MemoizationMap::iterator I = ResultCache.find(Keys.back());
         if (I != ResultCache.end()) {
+          ++NumMemoizedAncestorHits;
           Keys.pop_back(); // Don't populate the cache for the matching node!
           *Builder = I->second.Nodes;
           return Finish(I->second.ResultOfMatch);
         }
+        ++NumMemoizedAncestorMisses;
       }
 
       Parents = ActiveASTContext->getParents(Node);
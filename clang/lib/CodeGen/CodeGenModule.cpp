@@ -3119,6 +3119,13 @@ void CodeGenModule::EmitDeferred() {
   if (DeferredDeclsToEmit.empty())
     return;
 
+  // FIXME: Function bodies are emitted serially. Emitting them on a thread
+  // pool would require per-thread LLVMContexts (the module's context and its
+  // uniqued types and constants are not thread safe) plus a deterministic
+  // merge, and it would require making the CodeGenModule state touched while
+  // emitting a body (DeferredDecls, the mangled name tables, the vtable and
+  // RTTI builders, debug info) safe to share or to replay in order.
+
   // Grab the list of decls to emit. If EmitGlobalDefinition schedules more
   // work, it will not interfere with this.
   std::vector<GlobalDecl> CurDeclsToEmit;
@@ -2412,6 +2412,10 @@ public:
     tooling::Replacements Result;
     deriveLocalStyle(AnnotatedLines);
     AffectedRangeMgr.computeAffectedLines(AnnotatedLines);
+    // FIXME: With -lines or -offset, most of the file is neither affected nor
+    // reformatted, but every line is still lexed, parsed and annotated. Only
+    // annotating around the affected lines would need to know how far the
+    // line joiner and the alignment of consecutive lines look ahead.
     for (AnnotatedLine *Line : AnnotatedLines)
       Annotator.calculateFormattingInformation(*Line);
     Annotator.setCommentLineLevels(AnnotatedLines);
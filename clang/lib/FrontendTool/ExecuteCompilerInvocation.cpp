@@ -233,7 +233,12 @@ bool ExecuteCompilerInvocation(CompilerInstance *Clang) {
     for (unsigned i = 0; i != NumArgs; ++i)
       Args[i + 1] = Clang->getFrontendOpts().LLVMArgs[i].c_str();
     Args[NumArgs + 1] = nullptr;
-    llvm::cl::ParseCommandLineOptions(NumArgs + 1, Args.get());
+    // Report a bad option as a failure of this invocation rather than exiting,
+    // so that other invocations in the same process, e.g. in a driver batch,
+    // still run.
+    if (!llvm::cl::ParseCommandLineOptions(NumArgs + 1, Args.get(),
+                                           /*Overview=*/"", &llvm::errs()))
+      return false;
   }
 
 #if CLANG_ENABLE_STATIC_ANALYZER
@@ -73,6 +73,11 @@ llvm::Error IncrementalExecutor::addModule(PartialTranslationUnit &PTU) {
       Jit->getMainJITDylib().createResourceTracker();
   ResourceTrackers[&PTU] = RT;
 
+  // FIXME: Every PTU is compiled eagerly, and nothing survives the session.
+  // Adding it through a lazy reexports layer would defer codegen to the first
+  // call. Caching objects across sessions would need a key derived from the
+  // module contents, because PTU module names are only unique within a
+  // session.
   return Jit->addIRModule(RT, {std::move(PTU.TheModule), TSCtx});
 }
 
@@ -24,8 +24,14 @@
 #include "llvm/ADT/SmallString.h"
 #include "llvm/ADT/StringMap.h"
 #include "llvm/ADT/StringSwitch.h"
+#include "llvm/ADT/bit.h"
+#include <cstring>
 #include <optional>
 
+#ifdef __SSE2__
+#include <emmintrin.h>
+#endif
+
 using namespace clang;
 using namespace clang::dependency_directives_scan;
 using namespace llvm;
@@ -327,6 +333,25 @@ static bool wasLineContinuation(const char *First, unsigned EOLLen) {
   return *(First - (int)EOLLen - 1) == '\\';
 }
 
+/// \returns the first '\n' or '\r' in [First, End), or End if there is none.
+static const char *findVerticalWhitespace(const char *First,
+                                          const char *const End) {
+#ifdef __SSE2__
+  const __m128i NewLines = _mm_set1_epi8('\n');
+  const __m128i CarriageReturns = _mm_set1_epi8('\r');
+  for (; End - First >= 16; First += 16) {
+    __m128i Cv = _mm_loadu_si128((const __m128i *)First);
+    int Mask = _mm_movemask_epi8(_mm_or_si128(
+        _mm_cmpeq_epi8(Cv, NewLines), _mm_cmpeq_epi8(Cv, CarriageReturns)));
+    if (Mask != 0)
+      return First + llvm::countr_zero<unsigned>(Mask);
+  }
+#endif
+  while (First != End && !isVerticalWhitespace(*First))
+    ++First;
+  return First;
+}
+
 static void skipToNewlineRaw(const char *&First, const char *const End) {
   for (;;) {
     if (First == End)
@@ -336,11 +361,10 @@ static void skipToNewlineRaw(const char *&First, const char *const End) {
     if (Len)
       return;
 
-    do {
-      if (++First == End)
-        return;
-      Len = isEOL(First, End);
-    } while (!Len);
+    First = findVerticalWhitespace(First + 1, End);
+    if (First == End)
+      return;
+    Len = isEOL(First, End);
 
     if (First[-1] != '\\')
       return;
@@ -362,11 +386,19 @@ static void skipBlockComment(const char *&First, const char *const End) {
     First = End;
     return;
   }
-  for (First += 3; First != End; ++First)
-    if (First[-1] == '*' && First[0] == '/') {
+  for (First += 3; First != End; ++First) {
+    // memchr is vectorized by the C library; most of a comment is skipped
+    // there.
+    First = static_cast<const char *>(::memchr(First, '/', End - First));
+    if (!First) {
+      First = End;
+      return;
+    }
+    if (First[-1] == '*') {
       ++First;
       return;
     }
+  }
 }
 
 /// \returns True if the current single quotation mark character is a C++14
@@ -35,13 +35,16 @@
 #include "llvm/Support/Errc.h"
 #include "llvm/Support/ErrorHandling.h"
 #include "llvm/Support/FileSystem.h"
+#include "llvm/Support/MemoryBuffer.h"
 #include "llvm/Support/Path.h"
 #include "llvm/Support/VirtualFileSystem.h"
+#include "llvm/Support/raw_ostream.h"
 #include <algorithm>
 #include <cassert>
 #include <cstddef>
 #include <cstdio>
 #include <cstring>
+#include <optional>
 #include <string>
 #include <system_error>
 #include <utility>
@@ -114,6 +117,7 @@ void HeaderSearch::SetSearchPaths(
   SystemDirIdx = systemDirIdx;
   SearchDirToHSEntry = std::move(searchDirToHSEntry);
   //LookupFileCache.clear();
+  PersistentLookupCacheLoaded = false;
   indexInitialHeaderMaps();
 }
 
@@ -1031,6 +1035,10 @@ OptionalFileEntryRef HeaderSearch::LookupFile(
 
   ConstSearchDirIterator NextIt = std::next(It);
 
+  // The search directory this lookup started from, if its result should be
+  // recorded in the persistent header search cache.
+  std::optional<unsigned> PersistentStartIdx;
+
   if (!SkipCache) {
     if (CacheLookup.StartIt == NextIt &&
         CacheLookup.RequestingModule == RequestingModule) {
@@ -1060,6 +1068,28 @@ OptionalFileEntryRef HeaderSearch::LookupFile(
           // In index => Start with a specific header map
           It = search_dir_nth(Iter->second);
       }
+
+      // Jump straight to the directory that satisfied this lookup in an
+      // earlier compilation, or past all of them if none did. Otherwise
+      // remember where the search starts so that the result can be recorded.
+      if (!HSOpts->HeaderSearchCachePath.empty()) {
+        if (!PersistentLookupCacheLoaded)
+          loadPersistentLookupCache();
+        unsigned StartIdx =
+            It == search_dir_end() ? SearchDirs.size() : searchDirIdx(*It);
+        PersistentStartIdx = StartIdx;
+        auto Known = PersistentLookups.find(Filename);
+        if (Known != PersistentLookups.end()) {
+          for (const PersistentLookup &L : Known->second) {
+            if (L.StartIdx == StartIdx) {
+              It = L.HitIdx == SearchDirs.size() ? search_dir_end()
+                                                 : search_dir_nth(L.HitIdx);
+              PersistentStartIdx = std::nullopt;
+              break;
+            }
+          }
+        }
+      }
     }
   } else {
     CacheLookup.reset(RequestingModule, /*NewStartIt=*/NextIt);
@@ -1149,6 +1179,8 @@ OptionalFileEntryRef HeaderSearch::LookupFile(
 
     // Remember this location for the next lookup we do.
     cacheLookupSuccess(CacheLookup, It, IncludeLoc);
+    if (PersistentStartIdx && !CacheLookup.MappedName)
+      notePersistentLookup(Filename, *PersistentStartIdx, searchDirIdx(*It));
     return File;
   }
 
@@ -1195,9 +1227,131 @@ OptionalFileEntryRef HeaderSearch::LookupFile(
 
   // Otherwise, didn't find it. Remember we didn't find this.
   CacheLookup.HitIt = search_dir_end();
+  if (PersistentStartIdx && !CacheLookup.MappedName)
+    notePersistentLookup(Filename, *PersistentStartIdx, SearchDirs.size());
   return std::nullopt;
 }
 
+/// The modification time of a normal search directory, or zero if it is not
+/// one or cannot be stat'ed. Lookups are only cached across directories with a
+/// non-zero time.
+static uint64_t getSearchDirModTime(FileManager &FileMgr,
+                                    const DirectoryLookup &DL) {
+  if (!DL.isNormalDir())
+    return 0;
+  llvm::ErrorOr<llvm::vfs::Status> Status =
+      FileMgr.getVirtualFileSystem().status(DL.getDirRef()->getName());
+  if (!Status)
+    return 0;
+  return Status->getLastModificationTime().time_since_epoch().count();
+}
+
+/// The first part of the persistent header search cache. A cache file is only
+/// used if it starts with exactly this text, i.e. it was written for the same
+/// search directories, and none of them has been modified since.
+static std::string
+getPersistentLookupCacheKey(ArrayRef<DirectoryLookup> SearchDirs,
+                            ArrayRef<uint64_t> ModTimes, unsigned AngledDirIdx,
+                            unsigned SystemDirIdx) {
+  std::string Key;
+  llvm::raw_string_ostream OS(Key);
+  OS << "clang-header-search-cache 1 " << AngledDirIdx << ' ' << SystemDirIdx
+     << ' ' << SearchDirs.size() << '\n';
+  for (auto [DL, ModTime] : llvm::zip_equal(SearchDirs, ModTimes))
+    OS << (DL.isNormalDir() ? 'd' : DL.isFramework() ? 'f' : 'h') << ' '
+       << ModTime << ' ' << DL.getName() << '\n';
+  return Key;
+}
+
+void HeaderSearch::loadPersistentLookupCache() {
+  PersistentLookupCacheLoaded = true;
+  PersistentLookupCacheDirty = false;
+  PersistentLookups.clear();
+  SearchDirModTimes.clear();
+  for (const DirectoryLookup &DL : SearchDirs)
+    SearchDirModTimes.push_back(getSearchDirModTime(FileMgr, DL));
+
+  auto Buf = llvm::MemoryBuffer::getFile(HSOpts->HeaderSearchCachePath,
+                                         /*IsText=*/false,
+                                         /*RequiresNullTerminator=*/false);
+  if (!Buf)
+    return;
+  StringRef Contents = (*Buf)->getBuffer();
+  std::string Key = getPersistentLookupCacheKey(
+      SearchDirs, SearchDirModTimes, AngledDirIdx, SystemDirIdx);
+  if (!Contents.consume_front(Key))
+    return;
+
+  while (!Contents.empty()) {
+    StringRef Line;
+    std::tie(Line, Contents) = Contents.split('\n');
+    unsigned StartIdx, HitIdx;
+    if (Line.consumeInteger(10, StartIdx) || !Line.consume_front(" ") ||
+        Line.consumeInteger(10, HitIdx) || !Line.consume_front(" ") ||
+        Line.empty() || StartIdx > HitIdx || HitIdx > SearchDirs.size())
+      continue;
+    if (!llvm::all_of(ArrayRef(SearchDirModTimes).slice(StartIdx,
+                                                         HitIdx - StartIdx),
+                      [](uint64_t ModTime) { return ModTime != 0; }))
+      continue;
+    PersistentLookups[Line].push_back({StartIdx, HitIdx});
+  }
+}
+
+void HeaderSearch::notePersistentLookup(StringRef Filename, unsigned StartIdx,
+                                        unsigned HitIdx) {
+  if (Filename.contains('\n'))
+    return;
+  // A miss in a directory stays a miss as long as the directory's
+  // modification time is unchanged only if the first component of the file
+  // name does not exist there: files added to an existing subdirectory do not
+  // touch the search directory.
+  auto [FirstComponent, Rest] = Filename.split('/');
+  for (unsigned I = StartIdx; I != HitIdx; ++I) {
+    if (SearchDirModTimes[I] == 0)
+      return;
+    if (Rest.empty())
+      continue;
+    SmallString<128> Path(SearchDirs[I].getDirRef()->getName());
+    llvm::sys::path::append(Path, FirstComponent);
+    if (FileMgr.getVirtualFileSystem().exists(Path))
+      return;
+  }
+
+  SmallVector<PersistentLookup, 1> &Lookups = PersistentLookups[Filename];
+  if (llvm::any_of(Lookups, [&](const PersistentLookup &L) {
+        return L.StartIdx == StartIdx;
+      }))
+    return;
+  Lookups.push_back({StartIdx, HitIdx});
+  PersistentLookupCacheDirty = true;
+}
+
+void HeaderSearch::writePersistentLookupCache() {
+  if (!PersistentLookupCacheDirty)
+    return;
+  PersistentLookupCacheDirty = false;
+
+  // Lookups made while a search directory was being modified may be stale.
+  for (auto [DL, ModTime] : llvm::zip_equal(SearchDirs, SearchDirModTimes))
+    if (getSearchDirModTime(FileMgr, DL) != ModTime)
+      return;
+
+  // Without a written cache the next compile simply searches the directories
+  // again, so don't turn an unwritable -fheader-search-cache= into a
+  // diagnostic.
+  llvm::consumeError(llvm::writeToOutput(
+      HSOpts->HeaderSearchCachePath, [&](llvm::raw_ostream &OS) {
+        OS << getPersistentLookupCacheKey(SearchDirs, SearchDirModTimes,
+                                          AngledDirIdx, SystemDirIdx);
+        for (const auto &Entry : PersistentLookups)
+          for (const PersistentLookup &L : Entry.second)
+            OS << L.StartIdx << ' ' << L.HitIdx << ' ' << Entry.first()
+               << '\n';
+        return llvm::Error::success();
+      }));
+}
+
 /// LookupSubframeworkHeader - Look up a subframework for the specified
 /// \#include file.  For example, if \#include'ing <HIToolbox/HIToolbox.h> from
 /// within ".../Carbon.framework/Headers/Carbon.h", check to see if HIToolbox
@@ -51,6 +51,10 @@
 #include <nmmintrin.h>
 #endif
 
+#ifdef __SSE2__
+#include <emmintrin.h>
+#endif
+
 using namespace clang;
 
 //===----------------------------------------------------------------------===//
@@ -2545,6 +2549,41 @@ bool Lexer::SkipWhitespace(Token &Result, const char *CurPtr,
   return false;
 }
 
+/// Return a pointer to the first character at or after \p CurPtr that is
+/// non-ASCII, a NUL or a vertical whitespace, i.e. the first character the
+/// line comment fast loop cannot skip.
+static const char *
+fastSkipLineCommentBody(const char *CurPtr,
+                        [[maybe_unused]] const char *BufferEnd) {
+#ifdef __SSE2__
+  constexpr ptrdiff_t BytesPerRegister = 16;
+
+  const __m128i NewLines = _mm_set1_epi8('\n');
+  const __m128i CarriageReturns = _mm_set1_epi8('\r');
+  const __m128i Zeros = _mm_setzero_si128();
+
+  while (LLVM_LIKELY(BufferEnd - CurPtr >= BytesPerRegister)) {
+    __m128i Cv = _mm_loadu_si128((const __m128i *)CurPtr);
+    __m128i Stop = _mm_or_si128(
+        _mm_or_si128(_mm_cmpeq_epi8(Cv, NewLines),
+                     _mm_cmpeq_epi8(Cv, CarriageReturns)),
+        _mm_cmpeq_epi8(Cv, Zeros));
+    // Non-ASCII characters have their high bit set, so OR-ing in the raw bytes
+    // makes movemask report them as well.
+    int Mask = _mm_movemask_epi8(_mm_or_si128(Stop, Cv));
+    if (Mask != 0)
+      return CurPtr + llvm::countr_zero<unsigned>(Mask);
+    CurPtr += BytesPerRegister;
+  }
+#endif
+
+  char C = *CurPtr;
+  while (isASCII(C) && C != 0 && // Potentially EOF.
+         C != '\n' && C != '\r') // Newline or DOS-style newline.
+    C = *++CurPtr;
+  return CurPtr;
+}
+
 /// We have just read the // characters from input.  Skip until we find the
 /// newline character that terminates the comment.  Then update BufferPtr and
 /// return.
@@ -2579,13 +2618,13 @@ bool Lexer::SkipLineComment(Token &Result, const char *CurPtr,
 
   char C;
   while (true) {
-    C = *CurPtr;
     // Skip over characters in the fast loop.
-    while (isASCII(C) && C != 0 &&   // Potentially EOF.
-           C != '\n' && C != '\r') { // Newline or DOS-style newline.
-      C = *++CurPtr;
+    if (const char *End = fastSkipLineCommentBody(CurPtr, BufferEnd);
+        End != CurPtr) {
+      CurPtr = End;
       UnicodeDecodingAlreadyDiagnosed = false;
     }
+    C = *CurPtr;
 
     if (!isASCII(C)) {
       unsigned Length = llvm::getUTF8SequenceSize(
@@ -3475,6 +3475,24 @@ namespace clang {
   }
 }
 
+TimeTraceASTAllocationScope::TimeTraceASTAllocationScope(
+    const ASTContext &Context, llvm::TimeTraceScope &TimeScope)
+    : Context(Context), TimeScope(TimeScope),
+      Enabled(llvm::timeTraceProfilerEnabled()) {
+  if (Enabled) {
+    StartBytes = Context.getASTAllocatedBytes();
+    StartDecls = Context.getNumDeclsAllocated();
+  }
+}
+
+TimeTraceASTAllocationScope::~TimeTraceASTAllocationScope() {
+  if (!Enabled)
+    return;
+  TimeScope.addArgument("ast-bytes",
+                        Context.getASTAllocatedBytes() - StartBytes);
+  TimeScope.addArgument("decls", Context.getNumDeclsAllocated() - StartDecls);
+}
+
 /// Instantiate the definition of a class from a given pattern.
 ///
 /// \param PointOfInstantiation The point of instantiation within the
@@ -3517,6 +3535,7 @@ Sema::InstantiateClass(SourceLocation PointOfInstantiation,
                                         /*Qualified=*/true);
     return Name;
   });
+  TimeTraceASTAllocationScope AllocationScope(Context, TimeScope);
 
   Pattern = PatternDef;
 
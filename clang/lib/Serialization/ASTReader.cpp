@@ -8075,9 +8075,10 @@ void ASTReader::PrintStats() {
       llvm::count(DeclsLoaded.materialized(), (Decl *)nullptr);
   unsigned NumIdentifiersLoaded =
       IdentifiersLoaded.size() -
-      llvm::count(IdentifiersLoaded, (IdentifierInfo *)nullptr);
+      llvm::count(IdentifiersLoaded.materialized(), (IdentifierInfo *)nullptr);
   unsigned NumMacrosLoaded =
-      MacrosLoaded.size() - llvm::count(MacrosLoaded, (MacroInfo *)nullptr);
+      MacrosLoaded.size() -
+      llvm::count(MacrosLoaded.materialized(), (MacroInfo *)nullptr);
   unsigned NumSelectorsLoaded =
       SelectorsLoaded.size() - llvm::count(SelectorsLoaded, Selector());
 
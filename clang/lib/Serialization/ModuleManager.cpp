@@ -15,6 +15,7 @@
 #include "clang/Basic/FileManager.h"
 #include "clang/Basic/LLVM.h"
 #include "clang/Lex/HeaderSearch.h"
+#include "clang/Lex/HeaderSearchOptions.h"
 #include "clang/Lex/ModuleMap.h"
 #include "clang/Serialization/GlobalModuleIndex.h"
 #include "clang/Serialization/InMemoryModuleCache.h"
@@ -198,13 +199,16 @@ ModuleManager::addModule(StringRef FileName, ModuleKind Type,
     return OutOfDate;
   } else {
     // Get a buffer of the file and close the file descriptor when done.
-    // The file is volatile because in a parallel build we expect multiple
-    // compiler processes to use the same module file rebuilding it if needed.
+    // The file is volatile by default because in a parallel build we expect
+    // multiple compiler processes to use the same module file rebuilding it if
+    // needed. With -fmodules-mmap-pcms we rely on rebuilt module files being
+    // renamed into place, which leaves existing mappings intact, and map the
+    // file so that all processes importing it share the same pages.
     //
     // RequiresNullTerminator is false because module files don't need it, and
     // this allows the file to still be mmapped.
-    auto Buf = FileMgr.getBufferForFile(NewModule->File,
-                                        /*IsVolatile=*/true,
+    bool IsVolatile = !HeaderSearchInfo.getHeaderSearchOpts().ModulesMmapPCMs;
+    auto Buf = FileMgr.getBufferForFile(NewModule->File, IsVolatile,
                                         /*RequiresNullTerminator=*/false);
 
     if (!Buf) {
@@ -27,6 +27,7 @@
 #include "llvm/ADT/FoldingSet.h"
 #include "llvm/ADT/PointerUnion.h"
 #include "llvm/ADT/SmallVector.h"
+#include "llvm/ADT/Statistic.h"
 #include "llvm/Support/Casting.h"
 #include <cassert>
 #include <memory>
@@ -35,6 +36,13 @@
 using namespace clang;
 using namespace ento;
 
+#define DEBUG_TYPE "ExplodedGraph"
+
+STATISTIC(NumNodesAllocated,
+          "The # of exploded nodes allocated from the bump allocator");
+STATISTIC(NumNodesRecycled, "The # of exploded nodes reused after reclamation");
+STATISTIC(NumNodesReclaimed, "The # of exploded nodes reclaimed");
+
 //===----------------------------------------------------------------------===//
 // Cleanup.
 //===----------------------------------------------------------------------===//
@@ -163,6 +171,7 @@ void ExplodedGraph::collectNode(ExplodedNode *node) {
   FreeNodes.push_back(node);
   Nodes.RemoveNode(node);
   --NumNodes;
+  ++NumNodesReclaimed;
   node->~ExplodedNode();
 }
 
@@ -404,10 +413,12 @@ ExplodedNode *ExplodedGraph::getNode(const ProgramPoint &L,
     if (!FreeNodes.empty()) {
       V = FreeNodes.back();
       FreeNodes.pop_back();
+      ++NumNodesRecycled;
     }
     else {
       // Allocate a new node.
       V = getAllocator().Allocate<NodeTy>();
+      ++NumNodesAllocated;
     }
 
     ++NumNodes;
@@ -432,6 +443,7 @@ ExplodedNode *ExplodedGraph::createUncachedNode(const ProgramPoint &L,
                                                 int64_t Id,
                                                 bool IsSink) {
   NodeTy *V = getAllocator().Allocate<NodeTy>();
+  ++NumNodesAllocated;
   new (V) NodeTy(L, State, Id, IsSink);
   return V;
 }
@@ -451,6 +451,12 @@ void AnalysisConsumer::HandleDeclsCallGraph(const unsigned LocalTUDeclsSize) {
   // inlined functions. The topological order allows the "do not reanalyze
   // previously inlined function" performance heuristic to be triggered more
   // often.
+  //
+  // FIXME: Top-level functions are analyzed one after the other. Analyzing
+  // them concurrently would need more than a ProgramStateManager per thread:
+  // the engine creates types and declarations in the shared ASTContext and
+  // can deserialize from a PCH, and the Visited set that drives the inlining
+  // heuristic above depends on this order.
   SetOfConstDecls Visited;
   SetOfConstDecls VisitedAsTopLevel;
   llvm::ReversePostOrderTraversal<clang::CallGraph*> RPOT(&CG);
@@ -7,6 +7,11 @@
 //===----------------------------------------------------------------------===//
 
 #include "clang/Tooling/DependencyScanning/DependencyScanningFilesystem.h"
+#include "clang/Basic/TokenKinds.h"
+#include "clang/Basic/Version.h"
+#include "llvm/ADT/StringExtras.h"
+#include "llvm/Support/BLAKE3.h"
+#include "llvm/Support/EndianStream.h"
 #include "llvm/Support/MemoryBuffer.h"
 #include "llvm/Support/SmallVectorMemoryBuffer.h"
 #include "llvm/Support/Threading.h"
@@ -41,6 +46,130 @@ DependencyScanningWorkerFilesystem::readFile(StringRef Filename) {
   return TentativeEntry(Stat, std::move(Buffer));
 }
 
+/// The format of the files in the persistent directives cache. Every file is
+/// named after a hash of the compiler version and the scanned contents, with
+/// the "llvmcache-" prefix that llvm::pruneCache() looks for. It holds a
+/// header, the tokens and the directives, all little-endian:
+///
+///   header:    magic, version, contents size, token count, directive count
+///   token:     offset, length (uint32_t), kind, flags (uint16_t)
+///   directive: kind, token count (uint32_t)
+static constexpr char PersistentDirectivesMagic[4] = {'C', 'S', 'D', 'D'};
+static constexpr uint32_t PersistentDirectivesVersion = 1;
+
+static std::string getPersistentDirectivesPath(StringRef CacheDir,
+                                               StringRef Contents) {
+  llvm::BLAKE3 Hasher;
+  Hasher.update(getClangFullRepositoryVersion());
+  Hasher.update(Contents);
+  SmallString<256> Path(CacheDir);
+  llvm::sys::path::append(
+      Path, "llvmcache-" +
+                llvm::toHex(Hasher.final<16>(), /*LowerCase=*/true) +
+                ".ppdirs");
+  return std::string(Path);
+}
+
+/// Reads the directives of \p Contents from the persistent cache file at
+/// \p Path. Returns false if the file is missing or malformed, in which case
+/// \p Tokens and \p Directives are left untouched.
+static bool readPersistentDirectives(
+    StringRef Path, StringRef Contents,
+    SmallVectorImpl<dependency_directives_scan::Token> &Tokens,
+    SmallVectorImpl<dependency_directives_scan::Directive> &Directives) {
+  using namespace llvm::support;
+  auto Buf = llvm::MemoryBuffer::getFile(Path, /*IsText=*/false,
+                                         /*RequiresNullTerminator=*/false);
+  if (!Buf)
+    return false;
+  StringRef Data = (*Buf)->getBuffer();
+  constexpr size_t HeaderSize = 20, TokenSize = 12, DirectiveSize = 8;
+  if (Data.size() < HeaderSize ||
+      !Data.starts_with(StringRef(PersistentDirectivesMagic, 4)))
+    return false;
+  const char *P = Data.data() + 4;
+  uint32_t Version = endian::readNext<uint32_t, llvm::endianness::little>(P);
+  uint32_t Size = endian::readNext<uint32_t, llvm::endianness::little>(P);
+  uint32_t NumTokens = endian::readNext<uint32_t, llvm::endianness::little>(P);
+  uint32_t NumDirectives =
+      endian::readNext<uint32_t, llvm::endianness::little>(P);
+  if (Version != PersistentDirectivesVersion || Size != Contents.size() ||
+      Data.size() != HeaderSize + uint64_t(NumTokens) * TokenSize +
+                         uint64_t(NumDirectives) * DirectiveSize)
+    return false;
+
+  // Decode everything before touching the outputs, so that a corrupt file
+  // does not leave partial results behind for the rescan to append to.
+  SmallVector<dependency_directives_scan::Token, 0> NewTokens;
+  NewTokens.reserve(NumTokens);
+  for (uint32_t I = 0; I != NumTokens; ++I) {
+    uint32_t Offset = endian::readNext<uint32_t, llvm::endianness::little>(P);
+    uint32_t Length = endian::readNext<uint32_t, llvm::endianness::little>(P);
+    uint16_t Kind = endian::readNext<uint16_t, llvm::endianness::little>(P);
+    uint16_t Flags = endian::readNext<uint16_t, llvm::endianness::little>(P);
+    if (Kind >= tok::NUM_TOKENS || Offset > Size || Length > Size - Offset)
+      return false;
+    NewTokens.emplace_back(Offset, Length, tok::TokenKind(Kind), Flags);
+  }
+
+  SmallVector<std::pair<uint32_t, uint32_t>, 0> NewDirectives;
+  NewDirectives.reserve(NumDirectives);
+  uint64_t RemainingTokens = NumTokens;
+  for (uint32_t I = 0; I != NumDirectives; ++I) {
+    uint32_t Kind = endian::readNext<uint32_t, llvm::endianness::little>(P);
+    uint32_t Count = endian::readNext<uint32_t, llvm::endianness::little>(P);
+    if (Kind > dependency_directives_scan::pp_eof || Count > RemainingTokens)
+      return false;
+    NewDirectives.emplace_back(Kind, Count);
+    RemainingTokens -= Count;
+  }
+  if (RemainingTokens != 0)
+    return false;
+
+  // The directives refer to the tokens, so only build them once the tokens
+  // are in their final place.
+  Tokens.assign(NewTokens.begin(), NewTokens.end());
+  Directives.clear();
+  Directives.reserve(NumDirectives);
+  ArrayRef<dependency_directives_scan::Token> Remaining(Tokens);
+  for (auto [Kind, Count] : NewDirectives) {
+    Directives.emplace_back(dependency_directives_scan::DirectiveKind(Kind),
+                            Remaining.take_front(Count));
+    Remaining = Remaining.drop_front(Count);
+  }
+  return true;
+}
+
+/// Writes the directives of \p Contents to the persistent cache file at
+/// \p Path. The file is renamed into place, so concurrent readers never see
+/// partial contents.
+static void writePersistentDirectives(
+    StringRef Path, StringRef Contents,
+    ArrayRef<dependency_directives_scan::Token> Tokens,
+    ArrayRef<dependency_directives_scan::Directive> Directives) {
+  // The file has just been scanned successfully. A cache directory that is
+  // read-only or full only costs the next run a rescan, so ignore errors.
+  llvm::consumeError(llvm::writeToOutput(Path, [&](llvm::raw_ostream &OS) {
+    llvm::support::endian::Writer W(OS, llvm::endianness::little);
+    OS.write(PersistentDirectivesMagic, 4);
+    W.write<uint32_t>(PersistentDirectivesVersion);
+    W.write<uint32_t>(Contents.size());
+    W.write<uint32_t>(Tokens.size());
+    W.write<uint32_t>(Directives.size());
+    for (const dependency_directives_scan::Token &T : Tokens) {
+      W.write<uint32_t>(T.Offset);
+      W.write<uint32_t>(T.Length);
+      W.write<uint16_t>(T.Kind);
+      W.write<uint16_t>(T.Flags);
+    }
+    for (const dependency_directives_scan::Directive &D : Directives) {
+      W.write<uint32_t>(D.Kind);
+      W.write<uint32_t>(D.Tokens.size());
+    }
+    return llvm::Error::success();
+  }));
+}
+
 bool DependencyScanningWorkerFilesystem::ensureDirectiveTokensArePopulated(
     EntryRef Ref) {
   auto &Entry = Ref.Entry;
@@ -62,10 +191,25 @@ bool DependencyScanningWorkerFilesystem::ensureDirectiveTokensArePopulated(
     return true;
 
   SmallVector<dependency_directives_scan::Directive, 64> Directives;
+  StringRef Buffer = Contents->Original->getBuffer();
+
+  // Reuse the directives of identical contents scanned by an earlier run.
+  std::string PersistentPath;
+  if (!SharedCache.getDirectivesCachePath().empty() &&
+      Buffer.size() <= std::numeric_limits<uint32_t>::max()) {
+    PersistentPath = getPersistentDirectivesPath(
+        SharedCache.getDirectivesCachePath(), Buffer);
+    if (readPersistentDirectives(PersistentPath, Buffer,
+                                 Contents->DepDirectiveTokens, Directives)) {
+      Contents->DepDirectives.store(
+          new std::optional<DependencyDirectivesTy>(std::move(Directives)));
+      return true;
+    }
+  }
+
   // Scan the file for preprocessor directives that might affect the
   // dependencies.
-  if (scanSourceForDependencyDirectives(Contents->Original->getBuffer(),
-                                        Contents->DepDirectiveTokens,
+  if (scanSourceForDependencyDirectives(Buffer, Contents->DepDirectiveTokens,
                                         Directives)) {
     Contents->DepDirectiveTokens.clear();
     // FIXME: Propagate the diagnostic if desired by the client.
@@ -73,6 +217,10 @@ bool DependencyScanningWorkerFilesystem::ensureDirectiveTokensArePopulated(
     return false;
   }
 
+  if (!PersistentPath.empty())
+    writePersistentDirectives(PersistentPath, Buffer,
+                              Contents->DepDirectiveTokens, Directives);
+
   // This function performed double-checked locking using `DepDirectives`.
   // Assigning it must be the last thing this function does, otherwise other
   // threads may skip the critical section (`DepDirectives != nullptr`), leading
@@ -201,6 +349,75 @@ const CachedRealPath &DependencyScanningFilesystemSharedCache::CacheShard::
   return *StoredRealPath;
 }
 
+std::vector<std::string>
+DependencyScanningFilesystemSharedCache::getOutOfDateEntries(
+    llvm::vfs::FileSystem &FS) const {
+  // Collect the entries first so that the shard locks are not held while
+  // querying the filesystem.
+  std::vector<std::pair<std::string, const CachedFileSystemEntry *>> Entries;
+  for (unsigned I = 0; I < NumShards; ++I) {
+    const CacheShard &Shard = CacheShards[I];
+    std::lock_guard<std::mutex> LockGuard(Shard.CacheLock);
+    for (const auto &KV : Shard.CacheByFilename)
+      if (const CachedFileSystemEntry *Entry = KV.getValue().first)
+        Entries.emplace_back(KV.getKey().str(), Entry);
+  }
+
+  std::vector<std::string> OutOfDate;
+  for (auto &[Filename, Entry] : Entries) {
+    llvm::ErrorOr<llvm::vfs::Status> Stat = FS.status(Filename);
+    bool Stale;
+    if (Entry->isError())
+      Stale = static_cast<bool>(Stat);
+    else if (!Stat)
+      Stale = true;
+    else
+      Stale = Stat->getUniqueID() != Entry->getUniqueID() ||
+              Stat->getLastModificationTime() !=
+                  Entry->getStatus().getLastModificationTime() ||
+              Stat->getSize() != Entry->getStatus().getSize();
+    if (Stale)
+      OutOfDate.push_back(std::move(Filename));
+  }
+  return OutOfDate;
+}
+
+void DependencyScanningFilesystemSharedCache::invalidate(StringRef Filename) {
+  std::optional<llvm::sys::fs::UniqueID> UID;
+  {
+    CacheShard &Shard = getShardForFilename(Filename);
+    std::lock_guard<std::mutex> LockGuard(Shard.CacheLock);
+    auto It = Shard.CacheByFilename.find(Filename);
+    if (It == Shard.CacheByFilename.end())
+      return;
+    const CachedFileSystemEntry *Entry = It->getValue().first;
+    if (Entry && !Entry->isError())
+      UID = Entry->getUniqueID();
+    Shard.CacheByFilename.erase(It);
+  }
+  // The contents are shared between all filenames with the same unique ID
+  // (e.g. hard links or different spellings of the same path), so drop all of
+  // them as well to force a re-read.
+  if (UID) {
+    for (unsigned I = 0; I < NumShards; ++I) {
+      CacheShard &Shard = CacheShards[I];
+      std::lock_guard<std::mutex> LockGuard(Shard.CacheLock);
+      for (auto It = Shard.CacheByFilename.begin(),
+                End = Shard.CacheByFilename.end();
+           It != End;) {
+        auto Cur = It++;
+        const CachedFileSystemEntry *Entry = Cur->getValue().first;
+        if (Entry && !Entry->isError() && Entry->getUniqueID() == *UID)
+          Shard.CacheByFilename.erase(Cur);
+      }
+    }
+    CacheShard &Shard = getShardForUID(*UID);
+    std::lock_guard<std::mutex> LockGuard(Shard.CacheLock);
+    Shard.EntriesByUID.erase(*UID);
+  }
+  Generation.fetch_add(1, std::memory_order_acq_rel);
+}
+
 static bool shouldCacheStatFailures(StringRef Filename) {
   StringRef Ext = llvm::sys::path::extension(Filename);
   if (Ext.empty())
@@ -230,6 +447,7 @@ DependencyScanningWorkerFilesystem::getOrEmplaceSharedEntryForUID(
 const CachedFileSystemEntry *
 DependencyScanningWorkerFilesystem::findEntryByFilenameWithWriteThrough(
     StringRef Filename) {
+  syncLocalCache();
   if (const auto *Entry = LocalCache.findEntryByFilename(Filename))
     return Entry;
   auto &Shard = SharedCache.getShardForFilename(Filename);
@@ -390,6 +608,8 @@ DependencyScanningWorkerFilesystem::getRealPath(const Twine &Path,
     return {};
   };
 
+  syncLocalCache();
+
   // If we already have the result in local cache, no work required.
   if (const auto *RealPath =
           LocalCache.findRealPathByFilename(*FilenameForLookup))
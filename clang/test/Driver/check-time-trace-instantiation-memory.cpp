@@ -0,0 +1,24 @@
+// RUN: %clangxx -S -ftime-trace -ftime-trace-granularity=0 -o %T/check-time-trace-instantiation-memory %s
+// RUN: cat %T/check-time-trace-instantiation-memory.json \
+// RUN:   | %python -c 'import json, sys; json.dump(json.loads(sys.stdin.read()), sys.stdout, sort_keys=True, indent=2)' \
+// RUN:   | FileCheck %s
+
+// CHECK:      "args": {
+// CHECK-NEXT:   "ast-bytes": {{[1-9][0-9]*}},
+// CHECK-NEXT:   "decls": {{[1-9][0-9]*}},
+// CHECK-NEXT:   "detail": "S<int>"
+// CHECK-NEXT: },
+// CHECK:      "name": "InstantiateClass"
+
+// CHECK:      "args": {
+// CHECK-NEXT:   "ast-bytes": {{[0-9]+}},
+// CHECK-NEXT:   "decls": {{[0-9]+}},
+// CHECK-NEXT:   "detail": "S<int>::get"
+// CHECK-NEXT: },
+// CHECK:      "name": "InstantiateFunction"
+
+template <typename T> struct S {
+  T Value;
+  T get() { T Copy = Value; return Copy; }
+};
+int bar() { return S<int>().get(); }
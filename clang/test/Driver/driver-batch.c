@@ -0,0 +1,43 @@
+// RUN: echo '%clang -fsyntax-only -DOK %s' > %t.jobs
+// RUN: echo '%clang -fsyntax-only %s' >> %t.jobs
+// RUN: echo '%clang -fsyntax-only -DOK -DAGAIN %s' >> %t.jobs
+// RUN: not %clang --driver-batch=%t.jobs 2>&1 | FileCheck %s
+
+// Every job runs, even after one of them fails.
+// CHECK-NOT: error:
+// CHECK:     error: "not OK"
+// CHECK-NOT: error:
+// CHECK:     warning: again
+
+// A bad -mllvm option only fails its own job, and inputs after "--" are
+// accepted.
+// RUN: echo '%clang -fsyntax-only -DOK -mllvm -no-such-option %s' > %t.mllvm
+// RUN: echo '%clang -fsyntax-only -DOK -DAGAIN -- %s' >> %t.mllvm
+// RUN: not %clang --driver-batch=%t.mllvm 2>&1 \
+// RUN:   | FileCheck %s --check-prefix=MLLVM
+
+// MLLVM:     Unknown command line argument '-no-such-option'
+// MLLVM-NOT: error:
+// MLLVM:     warning: again
+
+// A fatal error only ends its own job, even in the first job of the batch.
+// RUN: echo '%clang -fsyntax-only -fno-crash-diagnostics -DOK -DFATAL %s' \
+// RUN:   > %t.fatal
+// RUN: echo '%clang -fsyntax-only -DOK -DAGAIN %s' >> %t.fatal
+// RUN: not %clang --driver-batch=%t.fatal 2>&1 \
+// RUN:   | FileCheck %s --check-prefix=FATAL
+
+// FATAL: #pragma clang __debug llvm_fatal_error
+// FATAL: warning: again
+
+#ifndef OK
+#error "not OK"
+#endif
+
+#ifdef FATAL
+#pragma clang __debug llvm_fatal_error
+#endif
+
+#ifdef AGAIN
+#warning again
+#endif
@@ -0,0 +1,24 @@
+// Check that importing memory-mapped module files from the module cache works,
+// including when the same cache is reused by a second compilation.
+
+// RUN: rm -rf %t
+// RUN: split-file %s %t
+
+// RUN: %clang_cc1 -fmodules -fimplicit-module-maps -fmodules-cache-path=%t/mcp \
+// RUN:   -fmodules-mmap-pcms -I %t %t/tu.c -fsyntax-only -verify
+// RUN: %clang_cc1 -fmodules -fimplicit-module-maps -fmodules-cache-path=%t/mcp \
+// RUN:   -fmodules-mmap-pcms -I %t %t/tu.c -fsyntax-only -verify
+
+//--- a.h
+int a(void);
+//--- b.h
+#include "a.h"
+int b(void);
+//--- module.modulemap
+module a { header "a.h" }
+module b { header "b.h" export * }
+
+//--- tu.c
+// expected-no-diagnostics
+#include "b.h"
+int c(void) { return a() + b(); }
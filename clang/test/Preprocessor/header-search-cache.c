@@ -0,0 +1,48 @@
+// Check that -fheader-search-cache= records lookups, reuses them, and drops
+// them once a search directory changes.
+
+// UNSUPPORTED: system-windows
+// RUN: rm -rf %t
+// RUN: split-file %s %t
+
+// RUN: %clang_cc1 -E -P -fheader-search-cache=%t/cache -I %t/a -I %t/b \
+// RUN:   %t/tu.c | FileCheck %s --check-prefix=FROM-B
+// RUN: FileCheck %s --check-prefix=CACHE --input-file=%t/cache
+// RUN: %clang_cc1 -E -P -fheader-search-cache=%t/cache -I %t/a -I %t/b \
+// RUN:   %t/tu.c | FileCheck %s --check-prefix=FROM-B
+
+// A different search path list ignores the cache.
+// RUN: %clang_cc1 -E -P -fheader-search-cache=%t/cache -I %t/b \
+// RUN:   %t/tu.c | FileCheck %s --check-prefix=FROM-B
+
+// Adding the header to an earlier directory modifies that directory, which
+// invalidates the cached lookups.
+// RUN: %clang_cc1 -E -P -fheader-search-cache=%t/cache -I %t/a -I %t/b \
+// RUN:   %t/tu.c | FileCheck %s --check-prefix=FROM-B
+// RUN: cp %t/foo-a.h %t/a/foo.h
+// RUN: touch -t 200001010000 %t/a
+// RUN: %clang_cc1 -E -P -fheader-search-cache=%t/cache -I %t/a -I %t/b \
+// RUN:   %t/tu.c | FileCheck %s --check-prefix=FROM-A
+
+// CACHE: clang-header-search-cache 1
+// CACHE-DAG: {{^}}0 1 foo.h{{$}}
+// CACHE-DAG: {{^}}0 {{[0-9]+}} missing.h{{$}}
+
+// FROM-B: int from_b;
+// FROM-B: int no_missing;
+// FROM-A: int from_a;
+// FROM-A: int no_missing;
+
+//--- tu.c
+#include "foo.h"
+#if __has_include("missing.h")
+int has_missing;
+#else
+int no_missing;
+#endif
+
+//--- a/.keep
+//--- b/foo.h
+int from_b;
+//--- foo-a.h
+int from_a;
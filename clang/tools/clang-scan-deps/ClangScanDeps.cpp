@@ -17,6 +17,7 @@
 #include "clang/Tooling/JSONCompilationDatabase.h"
 #include "llvm/ADT/STLExtras.h"
 #include "llvm/ADT/Twine.h"
+#include "llvm/Support/CachePruning.h"
 #include "llvm/Support/CommandLine.h"
 #include "llvm/Support/FileUtilities.h"
 #include "llvm/Support/Format.h"
@@ -77,6 +78,8 @@ static ScanningMode ScanMode = ScanningMode::DependencyDirectivesScan;
 static ScanningOutputFormat Format = ScanningOutputFormat::Make;
 static ScanningOptimizations OptimizeArgs;
 static std::string ModuleFilesDir;
+static std::string DirectivesCacheDir;
+static std::string DirectivesCachePolicy;
 static bool EagerLoadModules;
 static unsigned NumThreads = 0;
 static std::string CompilationDB;
@@ -176,6 +179,13 @@ static void ParseArgs(int argc, char **argv) {
   if (const llvm::opt::Arg *A = Args.getLastArg(OPT_module_files_dir_EQ))
     ModuleFilesDir = A->getValue();
 
+  if (const llvm::opt::Arg *A = Args.getLastArg(OPT_directives_cache_dir_EQ))
+    DirectivesCacheDir = A->getValue();
+
+  if (const llvm::opt::Arg *A =
+          Args.getLastArg(OPT_directives_cache_policy_EQ))
+    DirectivesCachePolicy = A->getValue();
+
   if (const llvm::opt::Arg *A = Args.getLastArg(OPT_o))
     OutputFileName = A->getValue();
 
@@ -985,6 +995,24 @@ int clang_scan_deps_main(int argc, char **argv, const llvm::ToolContext &) {
 
   DependencyScanningService Service(ScanMode, Format, OptimizeArgs,
                                     EagerLoadModules);
+  std::optional<llvm::CachePruningPolicy> DirectivesPruningPolicy;
+  if (!DirectivesCacheDir.empty()) {
+    auto PolicyOrErr = llvm::parseCachePruningPolicy(DirectivesCachePolicy);
+    if (!PolicyOrErr) {
+      llvm::errs() << "error: invalid directives cache policy '"
+                   << DirectivesCachePolicy
+                   << "': " << llvm::toString(PolicyOrErr.takeError()) << "\n";
+      return 1;
+    }
+    DirectivesPruningPolicy = *PolicyOrErr;
+    if (std::error_code EC =
+            llvm::sys::fs::create_directories(DirectivesCacheDir)) {
+      llvm::errs() << "error: unable to create directives cache directory '"
+                   << DirectivesCacheDir << "': " << EC.message() << "\n";
+      return 1;
+    }
+    Service.getSharedCache().setDirectivesCachePath(DirectivesCacheDir);
+  }
 
   llvm::Timer T;
   T.startTimer();
@@ -1007,6 +1035,12 @@ int clang_scan_deps_main(int argc, char **argv, const llvm::ToolContext &) {
   }
 
   T.stopTimer();
+
+  // Entries are added on every run, so keep the directives cache bounded the
+  // same way as the ThinLTO cache.
+  if (DirectivesPruningPolicy)
+    llvm::pruneCache(DirectivesCacheDir, *DirectivesPruningPolicy);
+
   if (PrintTiming)
     llvm::errs() << llvm::format(
         "clang-scan-deps timing: %0.2fs wall, %0.2fs process\n",
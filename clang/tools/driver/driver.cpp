@@ -38,6 +38,7 @@
 #include "llvm/Support/ErrorHandling.h"
 #include "llvm/Support/FileSystem.h"
 #include "llvm/Support/LLVMDriver.h"
+#include "llvm/Support/MemoryBuffer.h"
 #include "llvm/Support/Path.h"
 #include "llvm/Support/PrettyStackTrace.h"
 #include "llvm/Support/Process.h"
@@ -195,6 +196,9 @@ static void FixupDiagPrefixExeName(TextDiagnosticPrinter *DiagClient,
   DiagClient->setPrefix(std::string(ExeBasename));
 }
 
+/// Whether the driver is running the jobs of a --driver-batch= file.
+static bool InDriverBatch = false;
+
 static int ExecuteCC1Tool(SmallVectorImpl<const char *> &ArgV,
                           const llvm::ToolContext &ToolContext) {
   // If we call the cc1 tool from the clangDriver library (through
@@ -209,6 +213,12 @@ static int ExecuteCC1Tool(SmallVectorImpl<const char *> &ArgV,
     llvm::errs() << toString(std::move(Err)) << '\n';
     return 1;
   }
+  // Memory is only left to the OS at exit when the process exits after the
+  // job; in a batch the process outlives it.
+  if (InDriverBatch)
+    llvm::erase_if(ArgV, [](const char *Arg) {
+      return Arg && StringRef(Arg) == "-disable-free";
+    });
   StringRef Tool = ArgV[1];
   void *GetExecutablePathVP = (void *)(intptr_t)GetExecutablePath;
   if (Tool == "-cc1")
@@ -225,6 +235,65 @@ static int ExecuteCC1Tool(SmallVectorImpl<const char *> &ArgV,
   return 1;
 }
 
+int clang_main(int Argc, char **Argv, const llvm::ToolContext &ToolContext);
+
+/// Runs each line of \p BatchFile, a full command line starting with the
+/// program name, as a separate driver invocation in this process, with the cc1
+/// jobs integrated. This avoids paying process startup and target
+/// initialization for every job when a build spawns many small compiles. Jobs
+/// run in order, as the cc1 tool relies on global state such as the llvm::cl
+/// options, which are reset before each job. A job that exits through
+/// llvm::sys::Process::Exit, e.g. on a fatal error, only ends that job; options
+/// that print help and exit, such as -mllvm -help, still end the batch.
+/// Returns the result of the first failing job.
+static int ExecuteDriverBatch(StringRef BatchFile,
+                              const llvm::ToolContext &ToolContext) {
+  llvm::ErrorOr<std::unique_ptr<llvm::MemoryBuffer>> Buf =
+      llvm::MemoryBuffer::getFileOrSTDIN(BatchFile);
+  if (!Buf) {
+    llvm::errs() << "error: could not read batch file '" << BatchFile
+                 << "': " << Buf.getError().message() << '\n';
+    return 1;
+  }
+
+  // RunSafely only catches exits and crashes once crash recovery is enabled.
+  // clang_main enables it too, but only after the first job has started.
+  llvm::CrashRecoveryContext::Enable();
+  InDriverBatch = true;
+  int Res = 0;
+  SmallVector<StringRef, 0> Lines;
+  (*Buf)->getBuffer().split(Lines, '\n', /*MaxSplit=*/-1, /*KeepEmpty=*/false);
+  for (StringRef Line : Lines) {
+    if (Line.trim().empty())
+      continue;
+    llvm::BumpPtrAllocator A;
+    llvm::StringSaver Saver(A);
+    SmallVector<const char *, 64> JobArgs;
+    llvm::cl::TokenizeGNUCommandLine(Line, Saver, JobArgs);
+    // Everything after "--" is an input, so the flag must come before it.
+    auto *DashDash = llvm::find_if(
+        JobArgs, [](const char *Arg) { return StringRef(Arg) == "--"; });
+    JobArgs.insert(DashDash, "-fintegrated-cc1");
+    SmallVector<char *, 64> JobArgv;
+    for (const char *Arg : JobArgs)
+      JobArgv.push_back(const_cast<char *>(Arg));
+
+    // Start each job from the default option values, whatever -mllvm options
+    // the previous jobs used.
+    llvm::cl::ResetAllOptionOccurrences();
+    int JobRes = 1;
+    llvm::CrashRecoveryContext CRC;
+    if (!CRC.RunSafely([&]() {
+          JobRes = clang_main(JobArgv.size(), JobArgv.data(), ToolContext);
+        }))
+      JobRes = CRC.RetCode;
+    if (!Res)
+      Res = JobRes;
+  }
+  InDriverBatch = false;
+  return Res;
+}
+
 int clang_main(int Argc, char **Argv, const llvm::ToolContext &ToolContext) {
   noteBottomOfStack();
   llvm::setBugReportMsg("PLEASE submit a bug report to " BUG_REPORT_URL
@@ -255,6 +324,13 @@ int clang_main(int Argc, char **Argv, const llvm::ToolContext &ToolContext) {
   if (Args.size() >= 2 && StringRef(Args[1]).starts_with("-cc1"))
     return ExecuteCC1Tool(Args, ToolContext);
 
+  // Handle a batch of driver invocations, one per line of the given file.
+  if (Args.size() == 2 && StringRef(Args[1]).starts_with("--driver-batch=") &&
+      !InDriverBatch)
+    return ExecuteDriverBatch(StringRef(Args[1]).drop_front(
+                                  strlen("--driver-batch=")),
+                              ToolContext);
+
   // Handle options that need handling before the real command line parsing in
   // Driver::BuildCompilation()
   bool CanonicalPrefixes = true;
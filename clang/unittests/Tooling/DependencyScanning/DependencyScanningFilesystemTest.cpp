@@ -7,7 +7,10 @@
 //===----------------------------------------------------------------------===//
 
 #include "clang/Tooling/DependencyScanning/DependencyScanningFilesystem.h"
+#include "llvm/ADT/STLExtras.h"
 #include "llvm/ADT/SmallString.h"
+#include "llvm/Support/EndianStream.h"
+#include "llvm/Support/FileSystem.h"
 #include "llvm/Support/VirtualFileSystem.h"
 #include "gtest/gtest.h"
 
@@ -174,3 +177,149 @@ TEST(DependencyScanningFilesystem, CacheStatOnExists) {
   EXPECT_EQ(InstrumentingFS->NumStatusCalls, 2u);
   EXPECT_EQ(InstrumentingFS->NumExistsCalls, 0u);
 }
+
+TEST(DependencyScanningFilesystem, PersistentDirectivesCache) {
+  llvm::SmallString<128> CacheDir;
+  ASSERT_FALSE(
+      llvm::sys::fs::createUniqueDirectory("scan-deps-directives", CacheDir));
+
+  llvm::StringRef FooContents = "#include \"bar.h\"\n"
+                                "#define FOO 1\n";
+  auto InMemoryFS = llvm::makeIntrusiveRefCnt<llvm::vfs::InMemoryFileSystem>();
+  InMemoryFS->setCurrentWorkingDirectory("/");
+  InMemoryFS->addFile("/foo.h", 0,
+                      llvm::MemoryBuffer::getMemBuffer(FooContents));
+
+  // Scans /foo.h with a fresh shared cache and returns the number of
+  // directives.
+  auto ScanFoo = [&]() -> size_t {
+    DependencyScanningFilesystemSharedCache SharedCache;
+    SharedCache.setDirectivesCachePath(CacheDir);
+    DependencyScanningWorkerFilesystem DepFS(SharedCache, InMemoryFS);
+    auto Entry = DepFS.getOrCreateFileSystemEntry("/foo.h");
+    EXPECT_TRUE(Entry);
+    if (!Entry || !DepFS.ensureDirectiveTokensArePopulated(*Entry))
+      return 0;
+    return (*Entry->getDirectiveTokens()).size();
+  };
+
+  size_t NumDirectives = ScanFoo();
+  EXPECT_GT(NumDirectives, 0u);
+
+  std::error_code EC;
+  llvm::sys::fs::directory_iterator It(CacheDir, EC);
+  ASSERT_FALSE(EC);
+  ASSERT_NE(It, llvm::sys::fs::directory_iterator());
+  std::string EntryPath = It->path();
+  EXPECT_TRUE(llvm::StringRef(EntryPath).ends_with(".ppdirs"));
+
+  // A fresh shared cache picks up the directives written above.
+  EXPECT_EQ(ScanFoo(), NumDirectives);
+
+  // Replace the entry with a well-formed one that holds no directives at all.
+  // Getting no directives back shows that the scan was served from the cache.
+  {
+    llvm::raw_fd_ostream OS(EntryPath, EC);
+    ASSERT_FALSE(EC);
+    llvm::support::endian::Writer W(OS, llvm::endianness::little);
+    OS << "CSDD";
+    W.write<uint32_t>(1);
+    W.write<uint32_t>(FooContents.size());
+    W.write<uint32_t>(0);
+    W.write<uint32_t>(0);
+  }
+  EXPECT_EQ(ScanFoo(), 0u);
+
+  // A truncated entry is ignored, and the file is scanned again from scratch.
+  {
+    llvm::raw_fd_ostream OS(EntryPath, EC);
+    ASSERT_FALSE(EC);
+    OS << "CSDD\1\0\0\0";
+  }
+  EXPECT_EQ(ScanFoo(), NumDirectives);
+  EXPECT_EQ(ScanFoo(), NumDirectives);
+
+  llvm::sys::fs::remove_directories(CacheDir);
+}
+
+TEST(DependencyScanningFilesystem, OutOfDateEntriesAndInvalidation) {
+  auto InMemoryFS = llvm::makeIntrusiveRefCnt<llvm::vfs::InMemoryFileSystem>();
+  InMemoryFS->setCurrentWorkingDirectory("/");
+  InMemoryFS->addFile("/foo.h", 0, llvm::MemoryBuffer::getMemBuffer("a"));
+  InMemoryFS->addFile("/bar.h", 0, llvm::MemoryBuffer::getMemBuffer("b"));
+
+  DependencyScanningFilesystemSharedCache SharedCache;
+  DependencyScanningWorkerFilesystem DepFS(SharedCache, InMemoryFS);
+  EXPECT_TRUE(DepFS.status("/foo.h"));
+  EXPECT_TRUE(DepFS.status("/bar.h"));
+  EXPECT_FALSE(DepFS.status("/missing.h"));
+  EXPECT_TRUE(SharedCache.getOutOfDateEntries(*InMemoryFS).empty());
+
+  // Simulate edits by swapping in a new underlying filesystem.
+  auto NewFS = llvm::makeIntrusiveRefCnt<llvm::vfs::InMemoryFileSystem>();
+  NewFS->setCurrentWorkingDirectory("/");
+  NewFS->addFile("/foo.h", 0, llvm::MemoryBuffer::getMemBuffer("a"));
+  NewFS->addFile("/bar.h", 1, llvm::MemoryBuffer::getMemBuffer("bb"));
+  NewFS->addFile("/missing.h", 0, llvm::MemoryBuffer::getMemBuffer("c"));
+
+  std::vector<std::string> OutOfDate = SharedCache.getOutOfDateEntries(*NewFS);
+  llvm::sort(OutOfDate);
+  // "/foo.h" has the same path and contents, hence the same unique ID, in the
+  // new filesystem.
+  ASSERT_EQ(OutOfDate.size(), 2u);
+  EXPECT_EQ(OutOfDate[0], "/bar.h");
+  EXPECT_EQ(OutOfDate[1], "/missing.h");
+
+  unsigned Generation = SharedCache.getGeneration();
+  SharedCache.invalidate("/bar.h");
+  EXPECT_NE(SharedCache.getGeneration(), Generation);
+
+  // The worker drops its local cache and sees the new contents.
+  DependencyScanningWorkerFilesystem NewDepFS(SharedCache, NewFS);
+  auto Stat = NewDepFS.status("/bar.h");
+  ASSERT_TRUE(Stat);
+  EXPECT_EQ(Stat->getSize(), 2u);
+  // Unrelated entries are still served from the shared cache.
+  EXPECT_FALSE(NewDepFS.status("/missing.h"));
+}
+
+TEST(DependencyScanningFilesystem, InvalidationDropsWorkerCaches) {
+  llvm::SmallString<128> Dir;
+  ASSERT_FALSE(
+      llvm::sys::fs::createUniqueDirectory("scan-deps-invalidate", Dir));
+  llvm::SmallString<128> Foo(Dir), Link(Dir);
+  llvm::sys::path::append(Foo, "foo.h");
+  llvm::sys::path::append(Link, "link.h");
+
+  // Rewrites the file in place, so that it keeps its unique ID.
+  auto WriteFoo = [&](llvm::StringRef Contents) {
+    std::error_code EC;
+    llvm::raw_fd_ostream OS(Foo, EC);
+    ASSERT_FALSE(EC);
+    OS << Contents;
+  };
+  WriteFoo("a");
+  ASSERT_FALSE(llvm::sys::fs::create_hard_link(Foo, Link));
+
+  DependencyScanningFilesystemSharedCache SharedCache;
+  DependencyScanningWorkerFilesystem DepFS(SharedCache,
+                                           llvm::vfs::getRealFileSystem());
+  auto GetContents = [&](llvm::StringRef Filename) -> std::string {
+    auto Entry = DepFS.getOrCreateFileSystemEntry(Filename);
+    return Entry ? Entry->getContents().str() : "";
+  };
+  EXPECT_EQ(GetContents(Foo), "a");
+  EXPECT_EQ(GetContents(Link), "a");
+
+  // Edits are not visible until the file is invalidated.
+  WriteFoo("bb");
+  EXPECT_EQ(GetContents(Foo), "a");
+
+  // The worker drops its local cache, and the hard link that shares the
+  // contents is invalidated as well.
+  SharedCache.invalidate(Foo);
+  EXPECT_EQ(GetContents(Foo), "bb");
+  EXPECT_EQ(GetContents(Link), "bb");
+
+  llvm::sys::fs::remove_directories(Dir);
+}
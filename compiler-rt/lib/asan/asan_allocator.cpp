@@ -1262,6 +1262,7 @@ void __sanitizer_purge_allocator() {
 }
 
 int __asan_update_allocation_context(void* addr) {
-  GET_STACK_TRACE_MALLOC;
+  // The user asked for this stack explicitly, so it is never sampled.
+  GET_STACK_TRACE_MALLOC_UNSAMPLED;
   return instance.UpdateAllocationStack((uptr)addr, &stack);
 }
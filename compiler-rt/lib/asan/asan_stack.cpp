@@ -26,6 +26,18 @@ u32 GetMallocContextSize() {
   return atomic_load(&malloc_context_size, memory_order_acquire);
 }
 
+u32 GetSampledMallocContextSize() {
+  u32 size = GetMallocContextSize();
+  int period = flags()->malloc_context_sample_period;
+  if (LIKELY(period <= 1) || size <= 2)
+    return size;
+  AsanThread *t = GetCurrentThread();
+  if (!t || t->NextMallocContextSample() % period == 0)
+    return size;
+  // Two frames are taken without unwinding and still identify the caller.
+  return 2;
+}
+
 namespace {
 
 // ScopedUnwinding is a scope for stacktracing member of a context
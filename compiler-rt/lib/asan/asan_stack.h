@@ -25,6 +25,8 @@ static const u32 kDefaultMallocContextSize = 30;
 
 void SetMallocContextSize(u32 size);
 u32 GetMallocContextSize();
+// Like GetMallocContextSize(), but honors malloc_context_sample_period.
+u32 GetSampledMallocContextSize();
 
 } // namespace __asan
 
@@ -57,11 +59,17 @@ u32 GetMallocContextSize();
 #define GET_STACK_TRACE_THREAD                                    \
   GET_STACK_TRACE(kStackTraceMax, true)
 
+// GET_STACK_TRACE evaluates max_size more than once, so the sampled size is
+// taken up front.
 #define GET_STACK_TRACE_MALLOC                                                 \
-  GET_STACK_TRACE(GetMallocContextSize(), common_flags()->fast_unwind_on_malloc)
+  u32 sampled_context_size = GetSampledMallocContextSize();                    \
+  GET_STACK_TRACE(sampled_context_size, common_flags()->fast_unwind_on_malloc)
 
 #define GET_STACK_TRACE_FREE GET_STACK_TRACE_MALLOC
 
+#define GET_STACK_TRACE_MALLOC_UNSAMPLED                                       \
+  GET_STACK_TRACE(GetMallocContextSize(), common_flags()->fast_unwind_on_malloc)
+
 #define PRINT_CURRENT_STACK()   \
   {                             \
     GET_STACK_TRACE_FATAL_HERE; \
@@ -139,6 +139,10 @@ class AsanThread {
   bool isUnwinding() const { return unwinding_; }
   void setUnwinding(bool b) { unwinding_ = b; }
 
+  // Counts the malloc and free stacks taken by this thread, so that only
+  // every malloc_context_sample_period-th of them is unwound in full.
+  u32 NextMallocContextSample() { return malloc_context_samples_++; }
+
   AsanThreadLocalMallocStorage &malloc_storage() { return malloc_storage_; }
   AsanStats &stats() { return stats_; }
 
@@ -187,6 +191,7 @@ class AsanThread {
   AsanThreadLocalMallocStorage malloc_storage_;
   AsanStats stats_;
   bool unwinding_;
+  u32 malloc_context_samples_;
   uptr extra_spill_area_;
 
   char start_data_[];
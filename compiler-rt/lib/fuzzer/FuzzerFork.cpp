@@ -309,6 +309,12 @@ void WorkerThread(JobQueue *FuzzQ, JobQueue *MergeQ) {
 }
 
 // This is just a skeleton of an experimental -fork=1 feature.
+//
+// FIXME: Workers are processes because the coverage counters in TracePC are
+// per module, not per thread. Threads fuzzing in one process would bump the
+// same counters, so an input could not be credited with the coverage it
+// found. An in-process threaded mode would first need per-thread counter
+// regions from the instrumentation.
 void FuzzWithFork(Random &Rand, const FuzzingOptions &Options,
                   const std::vector<std::string> &Args,
                   const std::vector<std::string> &CorpusDirs, int NumJobs) {
@@ -639,7 +639,10 @@ static void initializeProfileForContinuousMode(void) {
     /* We are merging profiles. Map the counter section as shared memory into
      * the profile, i.e. into each participating process. An increment in one
      * process should be visible to every other process with the same counter
-     * section mapped. */
+     * section mapped. With a %m pattern the file is keyed by the binary's
+     * signature, so short-lived processes accumulate into one segment and
+     * never merge at exit. Processes that run concurrently only accumulate
+     * exactly if the counters were built with -fprofile-update=atomic. */
     File = lprofOpenFileEx(Filename);
     if (!File)
       return;
@@ -133,6 +133,9 @@ struct TSDRegistrySharedT {
   }
 
 private:
+  // Threads contend here for the TSD they were assigned to. A per-CPU cache
+  // built on Linux restartable sequences would not need the lock, but it needs
+  // rseq versions of the cache fast paths and a registry of its own.
   ALWAYS_INLINE TSD<Allocator> *getTSDAndLock() NO_THREAD_SAFETY_ANALYSIS {
     TSD<Allocator> *TSD = getCurrentTSD();
     DCHECK(TSD);
@@ -936,6 +936,24 @@ static bool TraceSkipGap(ThreadState* thr) {
   return false;
 }
 
+// With access_sample_period > 1 only every N-th trace part of a thread checks
+// memory accesses. The accesses are ignored with the regular ignore bit, so
+// the MemoryAccess fast path does not need any additional checks. The parts
+// are phased by tid, so that not all threads are checked at the same time.
+static void UpdateAccessSampling(ThreadState* thr) {
+  int period = flags()->access_sample_period;
+  if (period <= 1)
+    return;
+  bool ignore = (thr->trace_parts_started++ + thr->tid) % period != 0;
+  if (ignore == thr->access_sampling_ignored)
+    return;
+  thr->access_sampling_ignored = ignore;
+  if (ignore)
+    ThreadIgnoreBegin(thr, 0);
+  else
+    ThreadIgnoreEnd(thr);
+}
+
 NOINLINE
 void TraceSwitchPart(ThreadState* thr) {
   if (TraceSkipGap(thr))
@@ -952,6 +970,7 @@ void TraceSwitchPart(ThreadState* thr) {
   }
 #endif
   TraceSwitchPartImpl(thr);
+  UpdateAccessSampling(thr);
 }
 
 void TraceSwitchPartImpl(ThreadState* thr) {
@@ -181,6 +181,10 @@ struct ThreadState {
   // We do not distinguish beteween ignoring reads and writes
   // for better performance.
   int ignore_reads_and_writes;
+  // Number of trace parts started by the thread, and whether memory accesses
+  // are currently ignored because of flags()->access_sample_period.
+  u32 trace_parts_started;
+  bool access_sampling_ignored;
   int suppress_reports;
   // Go does not support ignores.
 #if !SANITIZER_GO
@@ -83,7 +83,16 @@ static void ThreadCheckIgnore(ThreadState *thr) {
 static void ThreadCheckIgnore(ThreadState *thr) {}
 #endif
 
+// The ignore taken for access_sample_period is not an unmatched user ignore.
+static void ThreadEndAccessSampling(ThreadState *thr) {
+  if (!thr->access_sampling_ignored)
+    return;
+  thr->access_sampling_ignored = false;
+  ThreadIgnoreEnd(thr);
+}
+
 void ThreadFinalize(ThreadState *thr) {
+  ThreadEndAccessSampling(thr);
   ThreadCheckIgnore(thr);
 #if !SANITIZER_GO
   if (!ShouldReport(thr, ReportTypeThreadLeak))
@@ -213,6 +222,7 @@ void ThreadContext::OnStarted(void *arg) {
 
 void ThreadFinish(ThreadState *thr) {
   DPrintf("#%d: ThreadFinish\n", thr->tid);
+  ThreadEndAccessSampling(thr);
   ThreadCheckIgnore(thr);
   if (thr->stk_addr && thr->stk_size)
     DontNeedShadowFor(thr->stk_addr, thr->stk_size);
@@ -28,6 +28,14 @@ namespace __xray {
 /// get from or return buffers to the queue. This is one key component of the
 /// "flight data recorder" (FDR) mode to support ongoing XRay function call
 /// trace collection.
+///
+/// FIXME: Buffers are only handed to a consumer through the log flush once
+/// tracing has been finalized. Continuous tracing would need a BackingStore
+/// that is shared with another process, e.g. backed by a memfd. It would also
+/// need a way to publish a buffer's Extents when the buffer is released, so
+/// the reader can consume it and retire it for reuse while the application
+/// runs. The mutex is only taken when a thread switches buffers, so it is not
+/// on the per-event path.
 class BufferQueue {
 public:
   /// ControlBlock represents the memory layout of how we interpret the backing
@@ -0,0 +1,47 @@
+// RUN: %clangxx_asan -O0 %s -o %t
+// RUN: %env_asan_opts=malloc_context_sample_period=1 not %run %t 0 2>&1 | FileCheck %s --check-prefix=FULL
+// RUN: %env_asan_opts=malloc_context_sample_period=1000000 not %run %t 0 2>&1 | FileCheck %s --check-prefix=SAMPLED
+// RUN: %env_asan_opts=malloc_context_sample_period=1000000 not %run %t 1 2>&1 | FileCheck %s --check-prefix=UPDATE
+
+// REQUIRES: stable-runtime
+
+#include <sanitizer/asan_interface.h>
+#include <stdlib.h>
+
+__attribute__((noinline)) char *Alloc() { return (char *)malloc(10); }
+
+__attribute__((noinline)) char *AllocFromOuter() { return Alloc(); }
+
+__attribute__((noinline)) void Update(char *p) {
+  __asan_update_allocation_context(p);
+}
+
+int main(int argc, char **argv) {
+  // Makes sure that the allocation below is not the first one on this thread,
+  // which is always unwound in full.
+  free(malloc(1));
+
+  char *x = AllocFromOuter();
+  if (atoi(argv[1]))
+    Update(x);
+  free(x);
+  return x[5];
+
+  // FULL: previously allocated by thread T0 here:
+  // FULL-NEXT: #0 0x{{.*}} in {{.*}}malloc
+  // FULL-NEXT: #1 0x{{.*}} in Alloc{{.*}}malloc_context_sample_period.cpp
+  // FULL-NEXT: #2 0x{{.*}} in AllocFromOuter{{.*}}malloc_context_sample_period.cpp
+
+  // Sampled-out stacks only keep the allocation function and its caller.
+  // SAMPLED: previously allocated by thread T0 here:
+  // SAMPLED-NEXT: #0 0x{{.*}} in {{.*}}malloc
+  // SAMPLED-NEXT: #1 0x{{.*}} in Alloc{{.*}}malloc_context_sample_period.cpp
+  // SAMPLED-NOT: #2 0x{{.*}}
+  // SAMPLED: SUMMARY: AddressSanitizer: heap-use-after-free
+
+  // __asan_update_allocation_context is never sampled.
+  // UPDATE: previously allocated by thread T0 here:
+  // UPDATE-NEXT: #0 0x{{.*}} in __asan_update_allocation_context
+  // UPDATE-NEXT: #1 0x{{.*}} in Update{{.*}}malloc_context_sample_period.cpp
+  // UPDATE-NEXT: #2 0x{{.*}} in main{{.*}}malloc_context_sample_period.cpp
+}
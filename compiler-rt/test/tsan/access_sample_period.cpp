@@ -0,0 +1,40 @@
+// RUN: %clangxx_tsan -O1 %s -o %t
+// RUN: %deflake %run %t | FileCheck %s --check-prefix=CHECK-RACE
+// RUN: %env_tsan_opts=access_sample_period=1000000 %run %t 2>&1 \
+// RUN:   | FileCheck %s --check-prefix=CHECK-SAMPLED
+#include "test.h"
+
+// Thread 1 and 2 only check memory accesses in the trace parts that are
+// sampled for them, and with such a large period their first parts are not.
+
+int Global;
+
+void *Thread1(void *x) {
+  barrier_wait(&barrier);
+  Global = 42;
+  return NULL;
+}
+
+void *Thread2(void *x) {
+  Global = 43;
+  barrier_wait(&barrier);
+  return NULL;
+}
+
+int main() {
+  barrier_init(&barrier, 2);
+  pthread_t t[2];
+  pthread_create(&t[0], NULL, Thread1, NULL);
+  pthread_create(&t[1], NULL, Thread2, NULL);
+  pthread_join(t[0], NULL);
+  pthread_join(t[1], NULL);
+  fprintf(stderr, "DONE\n");
+  return 0;
+}
+
+// CHECK-RACE: WARNING: ThreadSanitizer: data race
+// CHECK-RACE: DONE
+
+// CHECK-SAMPLED-NOT: ThreadSanitizer
+// CHECK-SAMPLED: DONE
+// CHECK-SAMPLED-NOT: ThreadSanitizer
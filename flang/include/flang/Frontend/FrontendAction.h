@@ -20,6 +20,7 @@
 
 #include "flang/Frontend/FrontendOptions.h"
 #include "llvm/Support/Error.h"
+#include "llvm/Support/Timer.h"
 
 namespace Fortran::frontend {
 class CompilerInstance;
@@ -121,6 +122,11 @@ protected:
   // otherwise.
   bool generateRtTypeTables();
 
+  // Time the compilation phase \p name until the returned timer goes out of
+  // scope. The timer only runs with -ftime-report.
+  llvm::NamedRegionTimer timePhase(llvm::StringRef name,
+                                   llvm::StringRef description);
+
   // Report fatal semantic errors. Return True if present, false otherwise.
   bool reportFatalSemanticErrors();
 
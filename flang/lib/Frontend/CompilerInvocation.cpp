@@ -246,6 +246,9 @@ static void parseCodeGenArgs(Fortran::frontend::CodeGenOptions &opts,
 
   opts.AliasAnalysis = opts.OptimizationLevel > 0;
 
+  if (args.hasArg(clang::driver::options::OPT_ftime_report))
+    opts.TimePasses = 1;
+
   // -mframe-pointer=none/non-leaf/all option.
   if (const llvm::opt::Arg *a =
           args.getLastArg(clang::driver::options::OPT_mframe_pointer_EQ)) {
@@ -1198,6 +1201,11 @@ bool CompilerInvocation::createFromArgs(
     invoc.loweringOpts.setNoPPCNativeVecElemOrder(true);
   }
 
+  // -ftime-report
+  if (args.hasArg(clang::driver::options::OPT_ftime_report)) {
+    invoc.loweringOpts.setTimeProcedures(true);
+  }
+
   // Preserve all the remark options requested, i.e. -Rpass, -Rpass-missed or
   // -Rpass-analysis. This will be used later when processing and outputting the
   // remarks generated by LLVM in ExecuteCompilerInvocation.cpp.
@@ -148,7 +148,10 @@ bool FrontendAction::runPrescan() {
   }
 
   // Prescan. In case of failure, report and return.
-  ci.getParsing().Prescan(currentInputPath, parserOptions);
+  {
+    llvm::NamedRegionTimer timer = timePhase("prescan", "Prescan");
+    ci.getParsing().Prescan(currentInputPath, parserOptions);
+  }
 
   return !reportFatalScanningErrors();
 }
@@ -157,7 +160,10 @@ bool FrontendAction::runParse() {
   CompilerInstance &ci = this->getInstance();
 
   // Parse. In case of failure, report and return.
-  ci.getParsing().Parse(llvm::outs());
+  {
+    llvm::NamedRegionTimer timer = timePhase("parse", "Parse");
+    ci.getParsing().Parse(llvm::outs());
+  }
 
   if (reportFatalParsingErrors()) {
     return false;
@@ -181,7 +187,11 @@ bool FrontendAction::runSemanticChecks() {
   auto &semantics = ci.getSemantics();
 
   // Run semantic checks
-  semantics.Perform();
+  {
+    llvm::NamedRegionTimer timer =
+        timePhase("semantics", "Semantic analysis");
+    semantics.Perform();
+  }
 
   if (reportFatalSemanticErrors()) {
     return false;
@@ -193,6 +203,13 @@ bool FrontendAction::runSemanticChecks() {
   return true;
 }
 
+llvm::NamedRegionTimer FrontendAction::timePhase(llvm::StringRef name,
+                                                 llvm::StringRef description) {
+  return llvm::NamedRegionTimer(
+      name, description, "flang", "Flang compilation phases",
+      getInstance().getInvocation().getCodeGenOpts().TimePasses);
+}
+
 bool FrontendAction::generateRtTypeTables() {
   getInstance().setRtTyTables(
       std::make_unique<Fortran::semantics::RuntimeDerivedTypeTables>(
@@ -307,7 +307,10 @@ bool CodeGenAction::beginSourceFileAction() {
 
   // Create a parse tree and lower it to FIR
   Fortran::parser::Program &parseTree{*ci.getParsing().parseTree()};
-  lb.lower(parseTree, ci.getSemanticsContext());
+  {
+    llvm::NamedRegionTimer timer = timePhase("lower", "Lowering to FIR");
+    lb.lower(parseTree, ci.getSemanticsContext());
+  }
 
   // Add target specific items like dependent libraries, target specific
   // constants etc.
@@ -333,6 +336,8 @@ bool CodeGenAction::beginSourceFileAction() {
   }
 
   pm.enableVerifier(/*verifyPasses=*/true);
+  if (ci.getInvocation().getCodeGenOpts().TimePasses)
+    pm.enableTiming();
   pm.addPass(std::make_unique<Fortran::lower::VerifierPass>());
 
   if (mlir::failed(pm.run(*mlirModule))) {
@@ -694,6 +699,8 @@ void CodeGenAction::lowerHLFIRToFIR() {
 
   pm.addPass(std::make_unique<Fortran::lower::VerifierPass>());
   pm.enableVerifier(/*verifyPasses=*/true);
+  if (opts.TimePasses)
+    pm.enableTiming();
 
   // Create the pass pipeline
   fir::createHLFIRToFIRPassPipeline(pm, level);
@@ -800,6 +807,8 @@ void CodeGenAction::generateLLVMIR() {
 
   pm.addPass(std::make_unique<Fortran::lower::VerifierPass>());
   pm.enableVerifier(/*verifyPasses=*/true);
+  if (opts.TimePasses)
+    pm.enableTiming();
 
   MLIRToLLVMPassPipelineConfig config(level, opts, mathOpts);
 
@@ -831,8 +840,12 @@ void CodeGenAction::generateLLVMIR() {
 
   // Translate to LLVM IR
   std::optional<llvm::StringRef> moduleName = mlirModule->getName();
-  llvmModule = mlir::translateModuleToLLVMIR(
-      *mlirModule, *llvmCtx, moduleName ? *moduleName : "FIRModule");
+  {
+    llvm::NamedRegionTimer timer =
+        timePhase("translate", "Translation to LLVM IR");
+    llvmModule = mlir::translateModuleToLLVMIR(
+        *mlirModule, *llvmCtx, moduleName ? *moduleName : "FIRModule");
+  }
 
   if (!llvmModule) {
     unsigned diagID = ci.getDiagnostics().getCustomDiagID(
@@ -1256,7 +1269,12 @@ void CodeGenAction::executeAction() {
   }
 
   // Run LLVM's middle-end (i.e. the optimizer).
-  runOptimizationPipeline(ci.isOutputStreamNull() ? *os : ci.getOutputStream());
+  {
+    llvm::NamedRegionTimer timer =
+        timePhase("optimize", "LLVM IR optimization");
+    runOptimizationPipeline(ci.isOutputStreamNull() ? *os
+                                                    : ci.getOutputStream());
+  }
 
   if (action == BackendActionTy::Backend_EmitLL) {
     llvmModule->print(ci.isOutputStreamNull() ? *os : ci.getOutputStream(),
@@ -1272,6 +1290,7 @@ void CodeGenAction::executeAction() {
   // Run LLVM's backend and generate either assembly or machine code
   if (action == BackendActionTy::Backend_EmitAssembly ||
       action == BackendActionTy::Backend_EmitObj) {
+    llvm::NamedRegionTimer timer = timePhase("codegen", "Code generation");
     generateMachineCodeOrAssemblyImpl(
         diags, targetMachine, action, *llvmModule, codeGenOpts,
         ci.isOutputStreamNull() ? *os : ci.getOutputStream());
@@ -26,6 +26,7 @@
 #include "clang/Driver/Options.h"
 #include "llvm/Option/OptTable.h"
 #include "llvm/Option/Option.h"
+#include "llvm/Pass.h"
 #include "llvm/Support/BuryPointer.h"
 #include "llvm/Support/CommandLine.h"
 
@@ -213,6 +214,11 @@ bool executeCompilerInvocation(CompilerInstance *flang) {
   updateDiagEngineForOptRemarks(flang->getDiagnostics(),
                                 flang->getDiagnosticOpts());
 
+  // Honor -ftime-report for the LLVM passes. The MLIR pass managers and the
+  // frontend phases check the option themselves.
+  llvm::TimePassesIsEnabled =
+      flang->getInvocation().getCodeGenOpts().TimePasses;
+
   // Create and execute the frontend action.
   std::unique_ptr<FrontendAction> act(createFrontendAction(*flang));
   if (!act)
@@ -64,6 +64,7 @@
 #include "llvm/Support/ErrorHandling.h"
 #include "llvm/Support/FileSystem.h"
 #include "llvm/Support/Path.h"
+#include "llvm/Support/Timer.h"
 #include "llvm/Target/TargetMachine.h"
 #include <optional>
 
@@ -5008,6 +5009,14 @@ private:
     for (int entryIndex = 0, last = funit.entryPointList.size();
          entryIndex < last; ++entryIndex) {
       funit.setActiveEntry(entryIndex);
+      // With -ftime-report, entry points with the same name share a timer.
+      const Fortran::semantics::Symbol *symbol =
+          funit.entryPointList[entryIndex].first;
+      llvm::NamedRegionTimer timer(
+          symbol ? symbol->name().ToString() : "<main program>",
+          symbol ? symbol->name().ToString() : "<main program>",
+          "flang-lower", "Lowering to FIR by procedure",
+          bridge.getLoweringOptions().getTimeProcedures());
       startNewFunction(funit); // the entry point for lowering this procedure
       for (Fortran::lower::pft::Evaluation &eval : funit.evaluationList)
         genFIR(eval);
@@ -1406,6 +1406,11 @@ Scope *ModFileReader::Read(SourceName name, std::optional<bool> isIntrinsic,
         "'"s + name.ToString() + "': "s + sourceFile->path());
     return nullptr;
   }
+  // FIXME: Every compilation that USEs a module prescans, parses and
+  // resolves its module file again.  A binary form that could be mapped and
+  // loaded without parsing would have to serialize symbols, scopes, types
+  // and expressions, none of which have a serialized form today; the
+  // checksum in the header is what would key such a cache.
   llvm::raw_null_ostream NullStream;
   parsing.Parse(NullStream);
   std::optional<parser::Program> &parsedProgram{parsing.parseTree()};
@@ -77,6 +77,30 @@ private:
 //    DO 2 J = 1, NCOLS
 //     DO 2 I = 1, NROWS
 //   2  RES(I,J) = RES(I,J) + X(I,K)*Y(K,J) ! loop-invariant last term
+// Once X and RES no longer fit in the cache, every iteration of loop 2's K
+// streams all of RES through memory.  So the columns of X are taken in blocks
+// that fit in the cache along with a column of RES, and the K loop is unrolled
+// by four so that each pass over a column of RES applies four columns of X:
+//   DO 2 KB = 1, N, KBLOCK
+//    DO 2 J = 1, NCOLS
+//     DO 2 K = KB, MIN(N, KB+KBLOCK-1), 4
+//      DO 2 I = 1, NROWS
+//   2   RES(I,J) = (((RES(I,J) + X(I,K)*Y(K,J)) + X(I,K+1)*Y(K+1,J)) + ...
+// Each element of RES still accumulates its terms in order of K, so the
+// result is the same as without blocking.
+static constexpr std::size_t matrixTimesMatrixBlockBytes{128 * 1024};
+
+template <typename T, bool HAS_STRIDED_COLUMNS>
+inline RT_API_ATTRS const T *MatrixColumn(const T *matrix, SubscriptValue j,
+    SubscriptValue columnLength, std::size_t columnByteStride) {
+  if constexpr (!HAS_STRIDED_COLUMNS) {
+    return matrix + j * columnLength;
+  } else {
+    return reinterpret_cast<const T *>(
+        reinterpret_cast<const char *>(matrix) + j * columnByteStride);
+  }
+}
+
 template <TypeCategory RCAT, int RKIND, typename XT, typename YT,
     bool X_HAS_STRIDED_COLUMNS, bool Y_HAS_STRIDED_COLUMNS>
 inline RT_API_ATTRS void MatrixTimesMatrix(
@@ -86,28 +110,46 @@ inline RT_API_ATTRS void MatrixTimesMatrix(
     std::size_t yColumnByteStride = 0) {
   using ResultType = CppTypeFor<RCAT, RKIND>;
   std::memset(product, 0, rows * cols * sizeof *product);
-  const XT *RESTRICT xp0{x};
-  for (SubscriptValue k{0}; k < n; ++k) {
+  std::size_t columnBytes{rows * sizeof(XT)};
+  SubscriptValue kBlock{static_cast<SubscriptValue>(
+      matrixTimesMatrixBlockBytes / (columnBytes ? columnBytes : 1))};
+  kBlock = kBlock < 4 ? 4 : kBlock - kBlock % 4;
+  for (SubscriptValue kb{0}; kb < n; kb += kBlock) {
+    SubscriptValue kEnd{n - kb > kBlock ? kb + kBlock : n};
     ResultType *RESTRICT p{product};
-    for (SubscriptValue j{0}; j < cols; ++j) {
-      const XT *RESTRICT xp{xp0};
-      ResultType yv;
-      if constexpr (!Y_HAS_STRIDED_COLUMNS) {
-        yv = static_cast<ResultType>(y[k + j * n]);
-      } else {
-        yv = static_cast<ResultType>(reinterpret_cast<const YT *>(
-            reinterpret_cast<const char *>(y) + j * yColumnByteStride)[k]);
+    for (SubscriptValue j{0}; j < cols; ++j, p += rows) {
+      const YT *RESTRICT yCol{
+          MatrixColumn<YT, Y_HAS_STRIDED_COLUMNS>(y, j, n, yColumnByteStride)};
+      SubscriptValue k{kb};
+      for (; k + 4 <= kEnd; k += 4) {
+        const XT *RESTRICT x0{MatrixColumn<XT, X_HAS_STRIDED_COLUMNS>(
+            x, k, rows, xColumnByteStride)};
+        const XT *RESTRICT x1{MatrixColumn<XT, X_HAS_STRIDED_COLUMNS>(
+            x, k + 1, rows, xColumnByteStride)};
+        const XT *RESTRICT x2{MatrixColumn<XT, X_HAS_STRIDED_COLUMNS>(
+            x, k + 2, rows, xColumnByteStride)};
+        const XT *RESTRICT x3{MatrixColumn<XT, X_HAS_STRIDED_COLUMNS>(
+            x, k + 3, rows, xColumnByteStride)};
+        ResultType y0{static_cast<ResultType>(yCol[k])};
+        ResultType y1{static_cast<ResultType>(yCol[k + 1])};
+        ResultType y2{static_cast<ResultType>(yCol[k + 2])};
+        ResultType y3{static_cast<ResultType>(yCol[k + 3])};
+        for (SubscriptValue i{0}; i < rows; ++i) {
+          p[i] = (((p[i] + static_cast<ResultType>(x0[i]) * y0) +
+                      static_cast<ResultType>(x1[i]) * y1) +
+                     static_cast<ResultType>(x2[i]) * y2) +
+              static_cast<ResultType>(x3[i]) * y3;
+        }
       }
-      for (SubscriptValue i{0}; i < rows; ++i) {
-        *p++ += static_cast<ResultType>(*xp++) * yv;
+      for (; k < kEnd; ++k) {
+        const XT *RESTRICT xp{MatrixColumn<XT, X_HAS_STRIDED_COLUMNS>(
+            x, k, rows, xColumnByteStride)};
+        ResultType yv{static_cast<ResultType>(yCol[k])};
+        for (SubscriptValue i{0}; i < rows; ++i) {
+          p[i] += static_cast<ResultType>(xp[i]) * yv;
+        }
       }
     }
-    if constexpr (!X_HAS_STRIDED_COLUMNS) {
-      xp0 += rows;
-    } else {
-      xp0 = reinterpret_cast<const XT *>(
-          reinterpret_cast<const char *>(xp0) + xColumnByteStride);
-    }
   }
 }
 
@@ -198,3 +198,88 @@ TEST(Matmul, Basic) {
   EXPECT_TRUE(
       static_cast<bool>(*result.ZeroBasedIndexedElement<std::uint16_t>(3)));
 }
+
+// The matrix*matrix kernel takes the columns of X in cache-sized blocks and
+// applies four of them at a time.  With 512 rows of INTEGER(4), a block has 64
+// columns, so the inner extents below cover a single group of four, a partial
+// group, and several blocks that end in a partial group.
+TEST(Matmul, Blocked) {
+  static constexpr int rows{512}, cols{3};
+  for (int n : {4, 7, 70, 131}) {
+    // The contiguous X and Y, and copies with one more row whose sections
+    // have strided columns.
+    std::vector<std::int32_t> xData, yData, xPadded, yPadded;
+    for (int k{0}; k < n; ++k) {
+      for (int i{0}; i < rows; ++i) {
+        xData.push_back((i * 7 + k * 3) % 11 - 5);
+        xPadded.push_back(xData.back());
+      }
+      xPadded.push_back(-99);
+    }
+    for (int j{0}; j < cols; ++j) {
+      for (int k{0}; k < n; ++k) {
+        yData.push_back((k * 5 + j) % 7 - 3);
+        yPadded.push_back(yData.back());
+      }
+      yPadded.push_back(-99);
+    }
+    auto x{MakeArray<TypeCategory::Integer, 4>(
+        std::vector<int>{rows, n}, xData)};
+    auto y{MakeArray<TypeCategory::Integer, 4>(
+        std::vector<int>{n, cols}, yData)};
+    auto x2{MakeArray<TypeCategory::Integer, 4>(
+        std::vector<int>{rows + 1, n}, xPadded)};
+    auto y2{MakeArray<TypeCategory::Integer, 4>(
+        std::vector<int>{n + 1, cols}, yPadded)};
+
+    StaticDescriptor<2> sectionStaticDescriptorX2;
+    Descriptor &sectionX2{sectionStaticDescriptorX2.descriptor()};
+    sectionX2.Establish(x2->type(), x2->ElementBytes(), /*p=*/nullptr,
+        /*rank=*/2);
+    const SubscriptValue lowersX2[]{1, 1}, uppersX2[]{rows, n};
+    ASSERT_EQ(CFI_section(&sectionX2.raw(), &x2->raw(), lowersX2, uppersX2,
+                  /*strides=*/nullptr),
+        0);
+    StaticDescriptor<2> sectionStaticDescriptorY2;
+    Descriptor &sectionY2{sectionStaticDescriptorY2.descriptor()};
+    sectionY2.Establish(y2->type(), y2->ElementBytes(), /*p=*/nullptr,
+        /*rank=*/2);
+    const SubscriptValue lowersY2[]{1, 1}, uppersY2[]{n, cols};
+    ASSERT_EQ(CFI_section(&sectionY2.raw(), &y2->raw(), lowersY2, uppersY2,
+                  /*strides=*/nullptr),
+        0);
+
+    auto check{[&](const Descriptor &xArg, const Descriptor &yArg) {
+      StaticDescriptor<2, true> statDesc;
+      Descriptor &result{statDesc.descriptor()};
+      RTNAME(Matmul)(result, xArg, yArg, __FILE__, __LINE__);
+      ASSERT_EQ(result.rank(), 2);
+      ASSERT_EQ(result.GetDimension(0).Extent(), rows);
+      ASSERT_EQ(result.GetDimension(1).Extent(), cols);
+      ASSERT_EQ(result.type(), (TypeCode{TypeCategory::Integer, 4}));
+      int mismatches{0};
+      for (int j{0}; j < cols; ++j) {
+        for (int i{0}; i < rows; ++i) {
+          std::int32_t expect{0};
+          for (int k{0}; k < n; ++k) {
+            expect += xData[i + k * rows] * yData[k + j * n];
+          }
+          std::int32_t actual{
+              *result.ZeroBasedIndexedElement<std::int32_t>(i + j * rows)};
+          if (actual != expect && mismatches++ < 4) {
+            ADD_FAILURE() << "n=" << n << " X"
+                          << (xArg.IsContiguous() ? "" : "2") << " Y"
+                          << (yArg.IsContiguous() ? "" : "2") << " (" << i
+                          << "," << j << "): " << actual << " != " << expect;
+          }
+        }
+      }
+      EXPECT_EQ(mismatches, 0);
+      result.Destroy();
+    }};
+    check(*x, *y);
+    check(sectionX2, *y);
+    check(*x, sectionY2);
+    check(sectionX2, sectionY2);
+  }
+}
@@ -15,6 +15,12 @@
 
 #include <stddef.h> // size_t
 
+// FIXME: The implementation is chosen at compile time from the target flags,
+// so a binary built for a baseline x86-64 or AArch64 never uses AVX-512 or
+// SVE. Runtime dispatch would need an ifunc (or equivalent) entrypoint in
+// src/string/memcpy.cpp, a CPU feature probe that is safe to run before
+// relocations are processed, and per-microarchitecture thresholds for the
+// rep;movsb and non-temporal store paths.
 #if defined(LIBC_COPT_MEMCPY_USE_EMBEDDED_TINY)
 #include "src/string/memory_utils/generic/byte_per_byte.h"
 #define LIBC_SRC_STRING_MEMORY_UTILS_MEMCPY inline_memcpy_byte_per_byte
@@ -12,6 +12,7 @@
 #include <__algorithm/min.h>
 #include <__bit/bit_cast.h>
 #include <__bit/countr.h>
+#include <__bit/popcount.h>
 #include <__config>
 #include <__type_traits/is_arithmetic.h>
 #include <__type_traits/is_same.h>
@@ -121,6 +122,33 @@ _LIBCPP_NODISCARD _LIBCPP_HIDE_FROM_ABI size_t __find_first_not_set(__simd_vecto
   return std::__find_first_set(~__vec);
 }
 
+template <class _Tp, size_t _Np>
+_LIBCPP_NODISCARD _LIBCPP_HIDE_FROM_ABI size_t __count_set(__simd_vector<_Tp, _Np> __vec) noexcept {
+  using __mask_vec = __simd_vector<bool, _Np>;
+
+  // This has MSan disabled du to https://github.com/llvm/llvm-project/issues/85876
+  auto __impl = [&]<class _MaskT>(_MaskT) _LIBCPP_NO_SANITIZE("memory") noexcept -> size_t {
+    _MaskT __mask = __builtin_bit_cast(_MaskT, __builtin_convertvector(__vec, __mask_vec));
+    // The bits above _Np are unspecified.
+    if constexpr (_Np < sizeof(_MaskT) * 8)
+      __mask &= static_cast<_MaskT>((_MaskT(1) << _Np) - 1);
+    return std::__libcpp_popcount(static_cast<unsigned long long>(__mask));
+  };
+
+  if constexpr (sizeof(__mask_vec) == sizeof(uint8_t)) {
+    return __impl(uint8_t{});
+  } else if constexpr (sizeof(__mask_vec) == sizeof(uint16_t)) {
+    return __impl(uint16_t{});
+  } else if constexpr (sizeof(__mask_vec) == sizeof(uint32_t)) {
+    return __impl(uint32_t{});
+  } else if constexpr (sizeof(__mask_vec) == sizeof(uint64_t)) {
+    return __impl(uint64_t{});
+  } else {
+    static_assert(sizeof(__mask_vec) == 0, "unexpected required size for mask integer type");
+    return 0;
+  }
+}
+
 _LIBCPP_END_NAMESPACE_STD
 
 #endif // _LIBCPP_HAS_ALGORITHM_VECTOR_UTILS
@@ -0,0 +1,360 @@
+//===----------------------------------------------------------------------===//
+//
+// Part of the LLVM Project, under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+//===----------------------------------------------------------------------===//
+
+#ifndef _LIBCPP___PSTL_BACKENDS_STD_THREAD_H
+#define _LIBCPP___PSTL_BACKENDS_STD_THREAD_H
+
+#include <__algorithm/inplace_merge.h>
+#include <__algorithm/lower_bound.h>
+#include <__algorithm/max.h>
+#include <__algorithm/min.h>
+#include <__algorithm/upper_bound.h>
+#include <__atomic/atomic.h>
+#include <__atomic/memory_order.h>
+#include <__condition_variable/condition_variable.h>
+#include <__config>
+#include <__memory/addressof.h>
+#include <__memory/unique_ptr.h>
+#include <__mutex/lock_guard.h>
+#include <__mutex/mutex.h>
+#include <__mutex/unique_lock.h>
+#include <__pstl/configuration_fwd.h>
+#include <__pstl/cpu_algos/any_of.h>
+#include <__pstl/cpu_algos/cpu_traits.h>
+#include <__pstl/cpu_algos/fill.h>
+#include <__pstl/cpu_algos/find_if.h>
+#include <__pstl/cpu_algos/for_each.h>
+#include <__pstl/cpu_algos/merge.h>
+#include <__pstl/cpu_algos/stable_sort.h>
+#include <__pstl/cpu_algos/transform.h>
+#include <__pstl/cpu_algos/transform_reduce.h>
+#include <__thread/thread.h>
+#include <__utility/empty.h>
+#include <__utility/move.h>
+#include <__utility/pair.h>
+#include <cstddef>
+#include <new>
+#include <optional>
+
+#if !defined(_LIBCPP_HAS_NO_PRAGMA_SYSTEM_HEADER)
+#  pragma GCC system_header
+#endif
+
+_LIBCPP_PUSH_MACROS
+#include <__undef_macros>
+
+#if !defined(_LIBCPP_HAS_NO_INCOMPLETE_PSTL) && _LIBCPP_STD_VER >= 17 && defined(_LIBCPP_PSTL_BACKEND_STD_THREAD)
+
+_LIBCPP_BEGIN_NAMESPACE_STD
+namespace __pstl {
+namespace __std_thread {
+
+// Ranges shorter than this are processed serially, since handing them to other threads costs more than it saves.
+inline constexpr ptrdiff_t __min_chunk_size = 2048;
+
+// Each thread gets this many chunks on average, so that threads which finish their chunks early can pick up
+// the remaining ones.
+inline constexpr ptrdiff_t __chunks_per_thread = 8;
+
+_LIBCPP_HIDE_FROM_ABI inline ptrdiff_t __thread_count() {
+  return std::max<ptrdiff_t>(1, thread::hardware_concurrency());
+}
+
+struct __chunk_partitions {
+  ptrdiff_t __chunk_count_;
+  ptrdiff_t __chunk_size_;
+};
+
+_LIBCPP_HIDE_FROM_ABI inline __chunk_partitions __partition_chunks(ptrdiff_t __element_count) {
+  ptrdiff_t __chunk_count =
+      std::min(__element_count / __min_chunk_size, __thread_count() * __chunks_per_thread);
+  if (__chunk_count <= 1 || __thread_count() == 1)
+    return {1, __element_count};
+  ptrdiff_t __chunk_size = (__element_count + __chunk_count - 1) / __chunk_count;
+  return {(__element_count + __chunk_size - 1) / __chunk_size, __chunk_size};
+}
+
+// A job handed to the thread pool: __run_(__func_, __index) is called for every __index in [0, __count_). The
+// threads working on the job take the next index from a shared counter until all of them have been handed out,
+// which balances the load when chunks take different amounts of time.
+struct __job {
+  atomic<ptrdiff_t> __next_{0};
+  ptrdiff_t __count_;
+  void (*__run_)(void*, ptrdiff_t);
+  void* __func_;
+  // The number of pool threads currently working on the job. Only accessed with the pool's mutex held.
+  ptrdiff_t __helpers_ = 0;
+  __job* __next_job_   = nullptr;
+
+  _LIBCPP_HIDE_FROM_ABI void __work() {
+    for (ptrdiff_t __index = __next_.fetch_add(1, memory_order_relaxed); __index < __count_;
+         __index           = __next_.fetch_add(1, memory_order_relaxed))
+      __run_(__func_, __index);
+  }
+};
+
+// A pool of one thread per hardware thread besides the calling one, started on first use and kept until exit, so
+// that every parallel algorithm doesn't pay for starting and joining threads. Threads that submit a job work on
+// it themselves, which makes nested parallel calls and failing to start pool threads harmless: the job gets done
+// even if no pool thread ever picks it up.
+class __thread_pool {
+  mutex __mutex_;
+  condition_variable __work_cv_;
+  condition_variable __done_cv_;
+  __job* __jobs_ = nullptr;
+  bool __stop_   = false;
+  ptrdiff_t __thread_count_;
+  unique_ptr<thread[]> __threads_;
+
+  // Removes __j from the list of jobs waiting for helpers, if it's still there. Requires the mutex to be held.
+  _LIBCPP_HIDE_FROM_ABI void __unlink(__job* __j) {
+    for (__job** __p = &__jobs_; *__p; __p = &(*__p)->__next_job_)
+      if (*__p == __j) {
+        *__p = __j->__next_job_;
+        return;
+      }
+  }
+
+  _LIBCPP_HIDE_FROM_ABI void __worker() {
+    unique_lock<mutex> __lock(__mutex_);
+    while (true) {
+      __work_cv_.wait(__lock, [this] { return __stop_ || __jobs_; });
+      if (__stop_)
+        return;
+      __job* __j = __jobs_;
+      ++__j->__helpers_;
+      __lock.unlock();
+      __j->__work();
+      __lock.lock();
+      // All indices have been handed out, so there is nothing left for other threads to help with.
+      __unlink(__j);
+      if (--__j->__helpers_ == 0)
+        __done_cv_.notify_all();
+    }
+  }
+
+public:
+  _LIBCPP_HIDE_FROM_ABI __thread_pool() : __thread_count_(0) {
+    ptrdiff_t __count = std::max<ptrdiff_t>(1, thread::hardware_concurrency()) - 1;
+    if (__count == 0)
+      return;
+    __threads_.reset(new (nothrow) thread[__count]);
+    if (!__threads_)
+      return;
+#  ifndef _LIBCPP_HAS_NO_EXCEPTIONS
+    try {
+#  endif
+      for (; __thread_count_ != __count; ++__thread_count_)
+        __threads_[__thread_count_] = thread([this] { __worker(); });
+#  ifndef _LIBCPP_HAS_NO_EXCEPTIONS
+    } catch (...) {
+      // Running out of threads isn't an error; the threads that did start do the work.
+    }
+#  endif
+  }
+
+  _LIBCPP_HIDE_FROM_ABI ~__thread_pool() {
+    {
+      lock_guard<mutex> __lock(__mutex_);
+      __stop_ = true;
+    }
+    __work_cv_.notify_all();
+    for (ptrdiff_t __i = 0; __i != __thread_count_; ++__i)
+      __threads_[__i].join();
+  }
+
+  __thread_pool(const __thread_pool&)            = delete;
+  __thread_pool& operator=(const __thread_pool&) = delete;
+
+  _LIBCPP_HIDE_FROM_ABI void __run(__job& __j) {
+    if (__thread_count_ != 0) {
+      {
+        lock_guard<mutex> __lock(__mutex_);
+        __j.__next_job_ = __jobs_;
+        __jobs_         = &__j;
+      }
+      __work_cv_.notify_all();
+    }
+
+    __j.__work();
+
+    if (__thread_count_ != 0) {
+      // __j lives on our stack, so wait for the pool threads still running its last chunks. Once it is unlinked,
+      // no new helper can pick it up.
+      unique_lock<mutex> __lock(__mutex_);
+      __unlink(&__j);
+      __done_cv_.wait(__lock, [&__j] { return __j.__helpers_ == 0; });
+    }
+  }
+};
+
+// The pool has hidden visibility like the rest of the backend, so each shared object that uses the parallel
+// algorithms gets its own pool.
+_LIBCPP_HIDE_FROM_ABI inline __thread_pool& __get_thread_pool() {
+  static __thread_pool __pool;
+  return __pool;
+}
+
+// Calls __func(__index) for every __index in [0, __count) on the calling thread and the thread pool.
+template <class _Func>
+_LIBCPP_HIDE_FROM_ABI void __parallel_for(ptrdiff_t __count, _Func __func) {
+  __job __j;
+  __j.__count_ = __count;
+  __j.__run_   = [](void* __f, ptrdiff_t __index) { (*static_cast<_Func*>(__f))(__index); };
+  __j.__func_  = std::addressof(__func);
+  __std_thread::__get_thread_pool().__run(__j);
+}
+
+} // namespace __std_thread
+
+template <>
+struct __cpu_traits<__cpu_backend_tag> {
+  template <class _RandomAccessIterator, class _Functor>
+  _LIBCPP_HIDE_FROM_ABI static optional<__empty>
+  __for_each(_RandomAccessIterator __first, _RandomAccessIterator __last, _Functor __func) {
+    auto __partitions = __std_thread::__partition_chunks(__last - __first);
+    if (__partitions.__chunk_count_ == 1) {
+      __func(__first, __last);
+      return __empty{};
+    }
+
+    __std_thread::__parallel_for(__partitions.__chunk_count_, [&](ptrdiff_t __chunk) {
+      auto __chunk_first = __first + __chunk * __partitions.__chunk_size_;
+      auto __chunk_last  = __last - __chunk_first <= __partitions.__chunk_size_
+                             ? __last
+                             : __chunk_first + __partitions.__chunk_size_;
+      __func(__chunk_first, __chunk_last);
+    });
+    return __empty{};
+  }
+
+  template <class _Index, class _UnaryOp, class _Tp, class _BinaryOp, class _Reduction>
+  _LIBCPP_HIDE_FROM_ABI static optional<_Tp> __transform_reduce(
+      _Index __first, _Index __last, _UnaryOp __transform, _Tp __init, _BinaryOp __combiner, _Reduction __reduce) {
+    auto __partitions = __std_thread::__partition_chunks(__last - __first);
+    if (__partitions.__chunk_count_ == 1)
+      return __reduce(std::move(__first), std::move(__last), std::move(__init));
+
+    // Every chunk is reduced with its first element as the initial value, since _Tp doesn't have to be default
+    // constructible. The partial results are then combined in order.
+    unique_ptr<optional<_Tp>[]> __values(new (nothrow) optional<_Tp>[__partitions.__chunk_count_]);
+    if (!__values)
+      return nullopt;
+
+    __std_thread::__parallel_for(__partitions.__chunk_count_, [&](ptrdiff_t __chunk) {
+      auto __chunk_first = __first + __chunk * __partitions.__chunk_size_;
+      auto __chunk_last  = __last - __chunk_first <= __partitions.__chunk_size_
+                             ? __last
+                             : __chunk_first + __partitions.__chunk_size_;
+      __values[__chunk].emplace(__reduce(__chunk_first + 1, __chunk_last, __transform(__chunk_first)));
+    });
+
+    for (ptrdiff_t __chunk = 0; __chunk != __partitions.__chunk_count_; ++__chunk)
+      __init = __combiner(std::move(__init), *std::move(__values[__chunk]));
+    return __init;
+  }
+
+  template <class _RandomAccessIterator, class _Compare, class _LeafSort>
+  _LIBCPP_HIDE_FROM_ABI static optional<__empty>
+  __stable_sort(_RandomAccessIterator __first, _RandomAccessIterator __last, _Compare __comp, _LeafSort __leaf_sort) {
+    const ptrdiff_t __size = __last - __first;
+    auto __partitions      = __std_thread::__partition_chunks(__size);
+    if (__partitions.__chunk_count_ == 1) {
+      __leaf_sort(__first, __last, __comp);
+      return __empty{};
+    }
+
+    const ptrdiff_t __chunk_size = __partitions.__chunk_size_;
+    __std_thread::__parallel_for(__partitions.__chunk_count_, [&](ptrdiff_t __chunk) {
+      auto __chunk_first = __first + __chunk * __chunk_size;
+      __leaf_sort(__chunk_first, __first + std::min(__size, (__chunk + 1) * __chunk_size), __comp);
+    });
+
+    // Merge neighbouring sorted runs until a single one is left. std::inplace_merge is stable and falls back
+    // to a slower algorithm if it can't get a buffer, so there is nothing to report here.
+    for (ptrdiff_t __width = __chunk_size; __width < __size; __width *= 2) {
+      const ptrdiff_t __pair_count = (__size + 2 * __width - 1) / (2 * __width);
+      __std_thread::__parallel_for(__pair_count, [&](ptrdiff_t __pair) {
+        const ptrdiff_t __begin = __pair * 2 * __width;
+        const ptrdiff_t __mid   = std::min(__size, __begin + __width);
+        const ptrdiff_t __end   = std::min(__size, __begin + 2 * __width);
+        if (__mid != __end)
+          std::inplace_merge(__first + __begin, __first + __mid, __first + __end, __comp);
+      });
+    }
+    return __empty{};
+  }
+
+  template <class _RandomAccessIterator1,
+            class _RandomAccessIterator2,
+            class _RandomAccessIterator3,
+            class _Compare,
+            class _LeafMerge>
+  _LIBCPP_HIDE_FROM_ABI static optional<_RandomAccessIterator3>
+  __merge(_RandomAccessIterator1 __first1,
+          _RandomAccessIterator1 __last1,
+          _RandomAccessIterator2 __first2,
+          _RandomAccessIterator2 __last2,
+          _RandomAccessIterator3 __outit,
+          _Compare __comp,
+          _LeafMerge __leaf_merge) {
+    const ptrdiff_t __size1 = __last1 - __first1;
+    const ptrdiff_t __size2 = __last2 - __first2;
+    auto __partitions       = __std_thread::__partition_chunks(__size1 + __size2);
+    if (__partitions.__chunk_count_ == 1) {
+      __leaf_merge(__first1, __last1, __first2, __last2, __outit, __comp);
+      return __outit + __size1 + __size2;
+    }
+
+    // Cut the longer range into chunks and find where each cut falls in the other range. Elements of the first
+    // range go before equivalent elements of the second one, so the second range is cut with lower_bound and the
+    // first one with upper_bound. Each pair of subranges can then be merged on its own.
+    const bool __split_first     = __size1 >= __size2;
+    const ptrdiff_t __long_size  = __split_first ? __size1 : __size2;
+    const ptrdiff_t __chunk_size = (__long_size + __partitions.__chunk_count_ - 1) / __partitions.__chunk_count_;
+    const ptrdiff_t __chunk_count = (__long_size + __chunk_size - 1) / __chunk_size;
+
+    auto __cut = [&](ptrdiff_t __chunk) -> pair<_RandomAccessIterator1, _RandomAccessIterator2> {
+      if (__chunk == 0)
+        return {__first1, __first2};
+      if (__chunk == __chunk_count)
+        return {__last1, __last2};
+      if (__split_first) {
+        auto __cut1 = __first1 + __chunk * __chunk_size;
+        return {__cut1, std::lower_bound(__first2, __last2, *__cut1, __comp)};
+      }
+      auto __cut2 = __first2 + __chunk * __chunk_size;
+      return {std::upper_bound(__first1, __last1, *__cut2, __comp), __cut2};
+    };
+
+    __std_thread::__parallel_for(__chunk_count, [&](ptrdiff_t __chunk) {
+      auto [__begin1, __begin2] = __cut(__chunk);
+      auto [__end1, __end2]     = __cut(__chunk + 1);
+      __leaf_merge(__begin1,
+                   __end1,
+                   __begin2,
+                   __end2,
+                   __outit + (__begin1 - __first1) + (__begin2 - __first2),
+                   __comp);
+    });
+    return __outit + __size1 + __size2;
+  }
+
+  _LIBCPP_HIDE_FROM_ABI static void __cancel_execution() {}
+
+  static constexpr size_t __lane_size = 64;
+};
+
+} // namespace __pstl
+_LIBCPP_END_NAMESPACE_STD
+
+#endif // !defined(_LIBCPP_HAS_NO_INCOMPLETE_PSTL) && _LIBCPP_STD_VER >= 17 && defined(_LIBCPP_PSTL_BACKEND_STD_THREAD)
+
+_LIBCPP_POP_MACROS
+
+#endif // _LIBCPP___PSTL_BACKENDS_STD_THREAD_H
@@ -134,6 +134,11 @@ memory_resource* set_default_resource(memory_resource* __new_res) noexcept {
 
 // 23.12.5, mem.res.pool
 
+// FIXME: synchronized_pool_resource serializes every allocation on the mutex of the resource and then forwards to the
+// unsynchronized_pool_resource it wraps. Per-thread caches with lock-free returns of blocks freed on another thread
+// would scale better, but both the class layout and the inline do_allocate()/do_deallocate() are part of the ABI, so
+// that needs a new ABI-versioned implementation rather than a change to the pool below.
+
 static size_t roundup(size_t count, size_t alignment) {
   size_t mask = alignment - 1;
   return (count + mask) & ~mask;
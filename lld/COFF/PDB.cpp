@@ -1170,6 +1170,12 @@ void PDBLinker::addObjectsToPDB() {
       for (TpiSource *source : tMerger.dependencySources)
         addDebug(source);
     }
+    // FIXME: Symbols are analyzed one object at a time. Relocating each
+    // object's .debug$S sections could happen in parallel ahead of this loop,
+    // but relocateDebugChunk allocates from the shared bump allocator, and
+    // the analysis adds to the global symbol, string table and file checksum
+    // builders, which would need per-object buffers that are merged in object
+    // order to keep the PDB deterministic.
     {
       llvm::TimeTraceScope timeScope("Merge debug info (objects)");
       for (TpiSource *source : tMerger.objectSources)
@@ -162,6 +162,7 @@ struct Config {
   llvm::StringRef entry;
   llvm::StringRef emulation;
   llvm::StringRef fini;
+  llvm::StringRef incrementalStamp;
   llvm::StringRef init;
   llvm::StringRef ltoAAPipeline;
   llvm::StringRef ltoCSProfileFile;
@@ -177,6 +178,7 @@ struct Config {
   llvm::StringRef optStatsFilename;
   llvm::StringRef progName;
   llvm::StringRef printArchiveStats;
+  llvm::StringRef printInputCost;
   llvm::StringRef printSymbolOrder;
   llvm::StringRef soName;
   llvm::StringRef sysroot;
@@ -479,7 +481,13 @@ struct Ctx {
   llvm::DenseMap<const Symbol *,
                  std::pair<const InputFile *, const InputFile *>>
       backwardReferences;
+  // Time in microseconds spent parsing each input file, excluding files
+  // extracted while parsing it. Used by --print-input-cost=.
+  llvm::DenseMap<const InputFile *, uint64_t> inputParseTimes;
   llvm::SmallSet<llvm::StringRef, 0> auxiliaryFiles;
+  // Paths probed while looking for input files, and whether they existed.
+  // Used by --incremental-stamp=.
+  SmallVector<std::pair<std::string, bool>, 0> probedPaths;
   // InputFile for linker created symbols with no source location.
   InputFile *internalFile;
   // True if SHT_LLVM_SYMPART is used.
@@ -66,6 +66,7 @@
 #include "llvm/Support/TargetSelect.h"
 #include "llvm/Support/TimeProfiler.h"
 #include "llvm/Support/raw_ostream.h"
+#include "llvm/Support/xxhash.h"
 #include <cstdlib>
 #include <tuple>
 #include <utility>
@@ -105,6 +106,7 @@ void Ctx::reset() {
   nonPrevailingSyms.clear();
   whyExtractRecords.clear();
   backwardReferences.clear();
+  inputParseTimes.clear();
   auxiliaryFiles.clear();
   internalFile = nullptr;
   hasSympart.store(false, std::memory_order_relaxed);
@@ -256,8 +258,9 @@ bool LinkerDriver::tryAddFatLTOFile(MemoryBufferRef mb, StringRef archiveName,
       IRObjectFile::findBitcodeInMemBuffer(mb);
   if (errorToBool(fatLTOData.takeError()))
     return false;
-  files.push_back(
-      make<BitcodeFile>(*fatLTOData, archiveName, offsetInArchive, lazy));
+  auto *f = make<BitcodeFile>(*fatLTOData, archiveName, offsetInArchive, lazy);
+  f->init();
+  files.push_back(f);
   return true;
 }
 
@@ -281,13 +284,31 @@ void LinkerDriver::addFile(StringRef path, bool withLOption) {
     return;
   case file_magic::archive: {
     auto members = getArchiveMembers(mbref);
+    // Reading the section and symbol tables of each member is independent of
+    // other members. Create the files first and initialize them in parallel.
+    SmallVector<ELFFileBase *, 0> objs;
+    SmallVector<BitcodeFile *, 0> bitcodes;
+    auto addObj = [&](MemoryBufferRef mb, bool lazy) {
+      objs.push_back(createUninitializedObjFile(mb, path, lazy));
+      files.push_back(objs.back());
+    };
+    auto addBitcode = [&](MemoryBufferRef mb, uint64_t offset, bool lazy) {
+      bitcodes.push_back(make<BitcodeFile>(mb, path, offset, lazy));
+      files.push_back(bitcodes.back());
+    };
+    auto initObjs = [&] {
+      parallelForEach(objs, [](ELFFileBase *f) { f->init(); });
+      parallelForEach(bitcodes, [](BitcodeFile *f) { f->init(); });
+    };
+
     if (inWholeArchive) {
       for (const std::pair<MemoryBufferRef, uint64_t> &p : members) {
         if (isBitcode(p.first))
-          files.push_back(make<BitcodeFile>(p.first, path, p.second, false));
+          addBitcode(p.first, p.second, false);
         else if (!tryAddFatLTOFile(p.first, path, p.second, false))
-          files.push_back(createObjFile(p.first, path));
+          addObj(p.first, false);
       }
+      initObjs();
       return;
     }
 
@@ -311,9 +332,9 @@ void LinkerDriver::addFile(StringRef path, bool withLOption) {
       auto magic = identify_magic(p.first.getBuffer());
       if (magic == file_magic::elf_relocatable) {
         if (!tryAddFatLTOFile(p.first, path, p.second, true))
-          files.push_back(createObjFile(p.first, path, true));
+          addObj(p.first, true);
       } else if (magic == file_magic::bitcode)
-        files.push_back(make<BitcodeFile>(p.first, path, p.second, true));
+        addBitcode(p.first, p.second, true);
       else
         warn(path + ": archive member '" + p.first.getBufferIdentifier() +
              "' is neither ET_REL nor LLVM bitcode");
@@ -321,6 +342,7 @@ void LinkerDriver::addFile(StringRef path, bool withLOption) {
     InputFile::isInGroup = saved;
     if (!saved)
       ++InputFile::nextGroupId;
+    initObjs();
     return;
   }
   case file_magic::elf_shared_object: {
@@ -340,9 +362,12 @@ void LinkerDriver::addFile(StringRef path, bool withLOption) {
     files.push_back(f);
     return;
   }
-  case file_magic::bitcode:
-    files.push_back(make<BitcodeFile>(mbref, "", 0, inLib));
+  case file_magic::bitcode: {
+    auto *f = make<BitcodeFile>(mbref, "", 0, inLib);
+    f->init();
+    files.push_back(f);
     break;
+  }
   case file_magic::elf_relocatable:
     if (!tryAddFatLTOFile(mbref, "", 0, inLib))
       files.push_back(createObjFile(mbref, "", inLib));
@@ -572,6 +597,159 @@ static void checkZOptions(opt::InputArgList &args) {
       warn("unknown -z value: " + StringRef(arg->getValue()));
 }
 
+// --incremental-stamp support. A stamp records a digest of everything that
+// determines the output (the linker version, the command line after response
+// file expansion and the contents of all files read by the driver) together
+// with the size and modification time of the output file and of every side
+// output, such as the map file. If a later link computes the same digest and
+// none of the outputs has been touched since, linking would produce identical
+// files, so we can skip it. This helps build systems that relink whenever an
+// input's timestamp changes, even if the recompiled objects are bit-identical.
+//
+// Some inputs are only discovered while linking (e.g. libraries named by
+// .deplibs sections). They cannot affect the output unless the inputs read
+// before the link have changed, which the digest catches, so the stamp lists
+// them with their own hashes and they are rehashed before a link is skipped.
+// The stamp also lists every path probed while searching for inputs, so that
+// a library that appears earlier on the search path is noticed.
+static std::string computeIncrementalDigest(opt::InputArgList &args) {
+  llvm::TimeTraceScope timeScope("Compute incremental digest");
+
+  // These files are only read after input files are parsed. Read them here
+  // so that they contribute to the digest.
+  if (!config->ltoSampleProfile.empty())
+    readFile(config->ltoSampleProfile);
+  if (!config->ltoCSProfileFile.empty() && !config->ltoCSProfileGenerate)
+    readFile(config->ltoCSProfileFile);
+  if (auto *arg = args.getLastArg(OPT_call_graph_ordering_file))
+    readFile(arg->getValue());
+
+  SmallVector<uint64_t, 0> hashes(ctx.memoryBuffers.size());
+  parallelFor(0, hashes.size(), [&](size_t i) {
+    const MemoryBuffer &mb = *ctx.memoryBuffers[i];
+    hashes[i] = xxh3_64bits(mb.getBufferIdentifier()) ^
+                xxh3_64bits(mb.getBuffer());
+  });
+
+  std::string str = getLLDVersion();
+  for (unsigned i = 0, e = args.getNumInputArgStrings(); i != e; ++i) {
+    str += '\0';
+    str += args.getArgString(i);
+  }
+  uint64_t argsHash = xxh3_64bits(str);
+  uint64_t filesHash = xxh3_64bits(ArrayRef<uint8_t>(
+      reinterpret_cast<const uint8_t *>(hashes.data()),
+      hashes.size() * sizeof(uint64_t)));
+  return utohexstr(argsHash, /*LowerCase=*/true) + "-" +
+         utohexstr(filesHash, /*LowerCase=*/true);
+}
+
+// Returns false if the link prints something to stdout or writes files that
+// are not tracked by the stamp, so that skipping it would lose output.
+static bool canSkipIncrementalLink(opt::InputArgList &args) {
+  if (config->mapFile == "-" || config->whyExtract == "-" ||
+      config->printArchiveStats == "-" ||
+      (config->cref && config->mapFile.empty()))
+    return false;
+  if (config->trace || args.hasArg(OPT_trace_symbol) ||
+      config->printGcSections || config->printIcfSections ||
+      config->printMemoryUsage)
+    return false;
+  // These describe how the link itself went, so they cannot be reused.
+  if (!config->printInputCost.empty() || config->timeTraceEnabled || tar)
+    return false;
+  return config->saveTempsArgs.empty() && !config->thinLTOIndexOnly &&
+         !config->thinLTOEmitImportsFiles && config->ltoObjPath.empty() &&
+         config->optRemarksFilename.empty();
+}
+
+// Returns the lines describing the current state of the output file and of the
+// side outputs, or an empty string if the output file does not exist.
+static std::string getIncrementalOutputLines(StringRef digest) {
+  auto getStatus = [](StringRef path) -> std::string {
+    fs::file_status st;
+    if (fs::status(path, st) || !fs::is_regular_file(st))
+      return "-";
+    return (Twine(st.getSize()) + " " +
+            Twine(st.getLastModificationTime().time_since_epoch().count()))
+        .str();
+  };
+
+  std::string status = getStatus(config->outputFile);
+  if (status == "-")
+    return "";
+  std::string lines = (digest + " " + status + "\n").str();
+  for (StringRef path :
+       {config->mapFile, config->whyExtract, config->printArchiveStats,
+        config->dependencyFile, config->printSymbolOrder})
+    if (!path.empty())
+      lines += ("output " + getStatus(path) + " " + path + "\n").str();
+  return lines;
+}
+
+// Returns true if the output file and the side outputs are up to date with
+// respect to the stamp.
+static bool isIncrementalStampUpToDate(StringRef digest) {
+  ErrorOr<std::unique_ptr<MemoryBuffer>> mbOrErr =
+      MemoryBuffer::getFile(config->incrementalStamp, /*IsText=*/true);
+  if (!mbOrErr)
+    return false;
+  StringRef stamp = (*mbOrErr)->getBuffer();
+  std::string lines = getIncrementalOutputLines(digest);
+  if (lines.empty() || !stamp.consume_front(lines))
+    return false;
+
+  // The rest of the stamp lists the paths probed while searching for inputs
+  // and the inputs read while linking.
+  SmallVector<StringRef, 0> inputs;
+  stamp.split(inputs, '\n', /*MaxSplit=*/-1, /*KeepEmpty=*/false);
+  for (StringRef line : inputs) {
+    StringRef hash, path;
+    if (line.consume_front("probe ")) {
+      std::tie(hash, path) = line.split(' ');
+      if ((hash == "1") != fs::exists(path))
+        return false;
+      continue;
+    }
+    if (!line.consume_front("input "))
+      return false;
+    std::tie(hash, path) = line.split(' ');
+    ErrorOr<std::unique_ptr<MemoryBuffer>> inputOrErr =
+        MemoryBuffer::getFile(path, /*IsText=*/false,
+                              /*RequiresNullTerminator=*/false);
+    if (!inputOrErr ||
+        hash != utohexstr(xxh3_64bits((*inputOrErr)->getBuffer()),
+                          /*LowerCase=*/true))
+      return false;
+  }
+  return true;
+}
+
+// Writes the stamp. numInputs is the number of files that had been read when
+// the digest was computed; those read after it are listed in the stamp.
+static void writeIncrementalStamp(StringRef digest, size_t numInputs) {
+  std::string lines = getIncrementalOutputLines(digest);
+  if (lines.empty())
+    return;
+  for (const auto &[path, exists] : ctx.probedPaths)
+    lines += ("probe " + Twine(exists ? "1" : "0") + " " + path + "\n").str();
+  for (size_t i = numInputs, e = ctx.memoryBuffers.size(); i != e; ++i) {
+    const MemoryBuffer &mb = *ctx.memoryBuffers[i];
+    lines += ("input " +
+              utohexstr(xxh3_64bits(mb.getBuffer()), /*LowerCase=*/true) +
+              " " + mb.getBufferIdentifier() + "\n")
+                 .str();
+  }
+
+  std::error_code ec;
+  raw_fd_ostream os(config->incrementalStamp, ec, fs::OF_Text);
+  if (ec) {
+    error("cannot open " + config->incrementalStamp + ": " + ec.message());
+    return;
+  }
+  os << lines;
+}
+
 constexpr const char *saveTempsValues[] = {
     "resolution", "preopt",     "promote", "internalize",  "import",
     "opt",        "precodegen", "prelink", "combinedindex"};
@@ -655,7 +833,23 @@ void LinkerDriver::linkerMain(ArrayRef<const char *> argsArr) {
     if (errorCount())
       return;
 
-    invokeELFT(link, args);
+    if (config->incrementalStamp.empty()) {
+      invokeELFT(link, args);
+    } else {
+      std::string digest = computeIncrementalDigest(args);
+      size_t numInputs = ctx.memoryBuffers.size();
+      bool canSkip = canSkipIncrementalLink(args);
+      if (canSkip && isIncrementalStampUpToDate(digest)) {
+        log("--incremental-stamp: " + config->outputFile + " is up to date");
+      } else {
+        // Remove the stale stamp first so that a failed link is never
+        // mistaken for an up-to-date one.
+        fs::remove(config->incrementalStamp);
+        invokeELFT(link, args);
+        if (canSkip && !errorCount())
+          writeIncrementalStamp(digest, numInputs);
+      }
+    }
   }
 
   if (config->timeTraceEnabled) {
@@ -1279,6 +1473,7 @@ static void readConfigs(opt::InputArgList &args) {
       args.hasArg(OPT_ignore_data_address_equality);
   config->ignoreFunctionAddressEquality =
       args.hasArg(OPT_ignore_function_address_equality);
+  config->incrementalStamp = args.getLastArgValue(OPT_incremental_stamp);
   config->init = args.getLastArgValue(OPT_init, "_init");
   config->ltoAAPipeline = args.getLastArgValue(OPT_lto_aa_pipeline);
   config->ltoCSProfileGenerate = args.hasArg(OPT_lto_cs_profile_generate);
@@ -1352,6 +1547,7 @@ static void readConfigs(opt::InputArgList &args) {
       args.hasFlag(OPT_print_gc_sections, OPT_no_print_gc_sections, false);
   config->printMemoryUsage = args.hasArg(OPT_print_memory_usage);
   config->printArchiveStats = args.getLastArgValue(OPT_print_archive_stats);
+  config->printInputCost = args.getLastArgValue(OPT_print_input_cost);
   config->printSymbolOrder =
       args.getLastArgValue(OPT_print_symbol_order);
   config->rejectMismatch = !args.hasArg(OPT_no_warn_mismatch);
@@ -1606,17 +1802,21 @@ static void readConfigs(opt::InputArgList &args) {
       error("unknown LTO mode: " + s);
   }
 
-  // --threads= takes a positive integer and provides the default value for
-  // --thinlto-jobs=. If unspecified, cap the number of threads since
+  // --threads= takes a positive integer or "pinned" and provides the default
+  // value for --thinlto-jobs=. If unspecified, cap the number of threads since
   // overhead outweighs optimization for used parallel algorithms for the
   // non-LTO parts.
   if (auto *arg = args.getLastArg(OPT_threads)) {
     StringRef v(arg->getValue());
     unsigned threads = 0;
-    if (!llvm::to_integer(v, threads, 0) || threads == 0)
-      error(arg->getSpelling() + ": expected a positive integer, but got '" +
+    if (v == "pinned")
+      parallel::strategy = *get_threadpool_strategy(v);
+    else if (!llvm::to_integer(v, threads, 0) || threads == 0)
+      error(arg->getSpelling() +
+            ": expected a positive integer or 'pinned', but got '" +
             arg->getValue() + "'");
-    parallel::strategy = hardware_concurrency(threads);
+    else
+      parallel::strategy = hardware_concurrency(threads);
     config->thinLTOJobs = v;
   } else if (parallel::strategy.compute_thread_count() > 16) {
     log("set maximum concurrency to 16, specify --threads= to change");
@@ -2168,6 +2368,47 @@ static void writeArchiveStats() {
   }
 }
 
+// Write a TSV report that helps to find input files that make a link slow.
+template <class ELFT> static void writeInputCost() {
+  if (config->printInputCost.empty())
+    return;
+
+  std::error_code ec;
+  raw_fd_ostream os = ctx.openAuxiliaryFile(config->printInputCost, ec);
+  if (ec) {
+    error("--print-input-cost=: cannot open " + config->printInputCost + ": " +
+          ec.message());
+    return;
+  }
+
+  os << "bytes\tsections\tlive\trelocs\tsymbols\tparse_us\tfile\n";
+  auto print = [&](const InputFile *file, size_t sections, size_t live,
+                   size_t relocs, size_t symbols) {
+    os << file->mb.getBufferSize() << '\t' << sections << '\t' << live << '\t'
+       << relocs << '\t' << symbols << '\t'
+       << ctx.inputParseTimes.lookup(file) << '\t' << toString(file) << '\n';
+  };
+  for (ELFFileBase *file : ctx.objectFiles) {
+    size_t sections = 0, live = 0, relocs = 0;
+    for (InputSectionBase *sec : file->getSections()) {
+      if (!sec || sec == &InputSection::discarded)
+        continue;
+      ++sections;
+      if (sec->isLive())
+        ++live;
+    }
+    for (const typename ELFT::Shdr &shdr : file->getELFShdrs<ELFT>())
+      if ((shdr.sh_type == SHT_REL || shdr.sh_type == SHT_RELA) &&
+          shdr.sh_entsize)
+        relocs += shdr.sh_size / shdr.sh_entsize;
+    print(file, sections, live, relocs, file->getELFSyms<ELFT>().size());
+  }
+  for (BitcodeFile *file : ctx.bitcodeFiles)
+    print(file, 0, 0, 0, file->getSymbols().size());
+  for (SharedFile *file : ctx.sharedFiles)
+    print(file, 0, 0, 0, file->getELFSyms<ELFT>().size());
+}
+
 static void writeWhyExtract() {
   if (config->whyExtract.empty())
     return;
@@ -3095,6 +3336,8 @@ template <class ELFT> void LinkerDriver::link(opt::InputArgList &args) {
     readCallGraphsFromObjectFiles<ELFT>();
   }
 
+  writeInputCost<ELFT>();
+
   // Write the result to the file.
   writeResult<ELFT>();
 }
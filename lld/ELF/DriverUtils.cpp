@@ -208,6 +208,16 @@ std::string elf::createResponseFile(const opt::InputArgList &args) {
   return std::string(data);
 }
 
+// Returns true if a file exists at the given path. The result is recorded for
+// --incremental-stamp=, because a file appearing or disappearing on a search
+// path changes which input a later link picks.
+bool elf::fileExists(StringRef path) {
+  bool exists = fs::exists(path);
+  if (!config->incrementalStamp.empty())
+    ctx.probedPaths.emplace_back(path.str(), exists);
+  return exists;
+}
+
 // Find a file by concatenating given paths. If a resulting path
 // starts with "=", the character is replaced with a --sysroot value.
 static std::optional<std::string> findFile(StringRef path1,
@@ -218,7 +228,7 @@ static std::optional<std::string> findFile(StringRef path1,
   else
     path::append(s, path1, path2);
 
-  if (fs::exists(s))
+  if (fileExists(s))
     return std::string(s);
   return std::nullopt;
 }
@@ -255,7 +265,7 @@ std::optional<std::string> elf::searchLibrary(StringRef name) {
 // look for the script in the '-L' search paths. This matches the behaviour of
 // '-T', --version-script=, and linker script INPUT() command in ld.bfd.
 std::optional<std::string> elf::searchScript(StringRef name) {
-  if (fs::exists(name))
+  if (fileExists(name))
     return name.str();
   return findFromSearchPaths(name);
 }
@@ -518,6 +518,27 @@ template <class ELFT> void ICF<ELFT>::run() {
     return a->eqClass[0] < b->eqClass[0];
   });
 
+  // Identical sections always have identical hash values, so a section whose
+  // hash value is unique cannot be folded. Usually most sections are like
+  // that. Assign them unique IDs like ineligible sections and exclude them
+  // from segregate(), which we may call many times.
+  size_t numCandidates = sections.size();
+  size_t numKept = 0;
+  for (size_t begin = 0, end; begin != numCandidates; begin = end) {
+    for (end = begin + 1; end != numCandidates; ++end)
+      if (sections[end]->eqClass[0] != sections[begin]->eqClass[0])
+        break;
+    if (end - begin == 1) {
+      sections[begin]->eqClass[0] = sections[begin]->eqClass[1] = ++uniqueId;
+      continue;
+    }
+    for (size_t i = begin; i != end; ++i)
+      sections[numKept++] = sections[i];
+  }
+  sections.truncate(numKept);
+  log("ICF: " + Twine(numCandidates - numKept) + " of " +
+      Twine(numCandidates) + " sections have a unique hash");
+
   // Compare static contents and assign unique equivalence class IDs for each
   // static content. Use a base offset for these IDs to ensure no overlap with
   // the unique IDs already assigned.
@@ -26,10 +26,12 @@
 #include "llvm/Support/ARMBuildAttributes.h"
 #include "llvm/Support/Endian.h"
 #include "llvm/Support/FileSystem.h"
+#include "llvm/Support/Parallel.h"
 #include "llvm/Support/Path.h"
 #include "llvm/Support/RISCVAttributeParser.h"
 #include "llvm/Support/TarWriter.h"
 #include "llvm/Support/raw_ostream.h"
+#include <chrono>
 #include <optional>
 
 using namespace llvm;
@@ -288,7 +290,7 @@ static bool isCompatible(InputFile *file) {
   return false;
 }
 
-template <class ELFT> static void doParseFile(InputFile *file) {
+template <class ELFT> static void doParseFileImpl(InputFile *file) {
   if (!isCompatible(file))
     return;
 
@@ -320,6 +322,25 @@ template <class ELFT> static void doParseFile(InputFile *file) {
   }
 }
 
+template <class ELFT> static void doParseFile(InputFile *file) {
+  if (config->printInputCost.empty()) {
+    doParseFileImpl<ELFT>(file);
+    return;
+  }
+
+  // Parsing a file may extract and parse archive members. Attribute the time
+  // spent on them to the extracted files rather than to this one.
+  static uint64_t nestedTime = 0;
+  uint64_t savedNestedTime = std::exchange(nestedTime, 0);
+  auto start = std::chrono::steady_clock::now();
+  doParseFileImpl<ELFT>(file);
+  uint64_t elapsed = std::chrono::duration_cast<std::chrono::microseconds>(
+                         std::chrono::steady_clock::now() - start)
+                         .count();
+  ctx.inputParseTimes[file] += elapsed - std::min(elapsed, nestedTime);
+  nestedTime = savedNestedTime + elapsed;
+}
+
 // Add symbols in File to the symbol table.
 void elf::parseFile(InputFile *file) { invokeELFT(doParseFile, file); }
 
@@ -333,6 +354,16 @@ extern template void ObjFile<ELF64BE>::importCmseSymbols();
 template <class ELFT>
 static void doParseFiles(const std::vector<InputFile *> &files,
                          InputFile *armCmseImpLib) {
+  // Hash symbol names of relocatable object files in parallel.
+  {
+    llvm::TimeTraceScope timeScope("Hash symbol names");
+    SmallVector<ObjFile<ELFT> *, 0> objs;
+    for (InputFile *file : files)
+      if (file->kind() == InputFile::ObjKind && file->ekind == config->ekind)
+        objs.push_back(cast<ObjFile<ELFT>>(file));
+    parallelForEach(objs, [](ObjFile<ELFT> *f) { f->hashSymbolNames(); });
+  }
+
   // Add all files to the symbol table. This will add almost all symbols that we
   // need to the symbol table. This process might add files to the link due to
   // addDependentLibrary.
@@ -417,7 +448,7 @@ static void addDependentLibrary(StringRef specifier, const InputFile *f) {
     ctx.driver.addFile(saver().save(*s), /*withLOption=*/true);
   else if (std::optional<std::string> s = findFromSearchPaths(specifier))
     ctx.driver.addFile(saver().save(*s), /*withLOption=*/true);
-  else if (fs::exists(specifier))
+  else if (fileExists(specifier))
     ctx.driver.addFile(specifier, /*withLOption=*/false);
   else
     error(toString(f) +
@@ -1100,6 +1131,33 @@ InputSectionBase *ObjFile<ELFT>::createInputSection(uint32_t idx,
   return makeThreadLocal<InputSection>(*this, sec, name);
 }
 
+// Symbol resolution must be done sequentially, but computing hash values of
+// symbol names does not have to. doParseFiles calls this function for input
+// files in parallel so that the sequential part only needs to probe the symbol
+// table.
+template <class ELFT> void ObjFile<ELFT>::hashSymbolNames() {
+  ArrayRef<Elf_Sym> eSyms = this->getELFSyms<ELFT>();
+  symNameHashes.resize_for_overwrite(eSyms.size() - firstGlobal);
+  for (size_t i = firstGlobal, end = eSyms.size(); i != end; ++i) {
+    Expected<StringRef> name = eSyms[i].getName(stringTable);
+    if (!name) {
+      // Leave the error to insertSymbol, which reports it sequentially.
+      consumeError(name.takeError());
+      symNameHashes.clear();
+      return;
+    }
+    symNameHashes[i - firstGlobal] = SymbolTable::hashName(*name);
+  }
+}
+
+template <class ELFT>
+Symbol *ObjFile<ELFT>::insertSymbol(ArrayRef<Elf_Sym> eSyms, size_t i) {
+  StringRef name = CHECK(eSyms[i].getName(stringTable), this);
+  if (symNameHashes.empty())
+    return symtab.insert(name);
+  return symtab.insert(name, symNameHashes[i - firstGlobal]);
+}
+
 // Initialize symbols. symbols is a parallel array to the corresponding ELF
 // symbol table.
 template <class ELFT>
@@ -1113,7 +1171,8 @@ void ObjFile<ELFT>::initializeSymbols(const object::ELFFile<ELFT> &obj) {
   // Some entries have been filled by LazyObjFile.
   for (size_t i = firstGlobal, end = eSyms.size(); i != end; ++i)
     if (!symbols[i])
-      symbols[i] = symtab.insert(CHECK(eSyms[i].getName(stringTable), this));
+      symbols[i] = insertSymbol(eSyms, i);
+  symNameHashes = {};
 
   // Perform symbol resolution on non-local symbols.
   SmallVector<unsigned, 32> undefineds;
@@ -1698,9 +1757,11 @@ BitcodeFile::BitcodeFile(MemoryBufferRef mb, StringRef archiveName,
                        ? saver().save(path)
                        : saver().save(archiveName + "(" + path::filename(path) +
                                       " at " + utostr(offsetInArchive) + ")");
-  MemoryBufferRef mbref(mb.getBuffer(), name);
+  ltoBuffer = MemoryBufferRef(mb.getBuffer(), name);
+}
 
-  obj = CHECK(lto::InputFile::create(mbref), this);
+void BitcodeFile::init() {
+  obj = CHECK(lto::InputFile::create(ltoBuffer), this);
 
   Triple t(obj->getTargetTriple());
   ekind = getBitcodeELFKind(t);
@@ -1838,6 +1899,13 @@ InputFile *elf::createInternalFile(StringRef name) {
 
 ELFFileBase *elf::createObjFile(MemoryBufferRef mb, StringRef archiveName,
                                 bool lazy) {
+  ELFFileBase *f = createUninitializedObjFile(mb, archiveName, lazy);
+  f->init();
+  return f;
+}
+
+ELFFileBase *elf::createUninitializedObjFile(MemoryBufferRef mb,
+                                             StringRef archiveName, bool lazy) {
   ELFFileBase *f;
   switch (getELFKind(mb, archiveName)) {
   case ELF32LEKind:
@@ -1855,7 +1923,6 @@ ELFFileBase *elf::createObjFile(MemoryBufferRef mb, StringRef archiveName,
   default:
     llvm_unreachable("getELFKind");
   }
-  f->init();
   f->lazy = lazy;
   return f;
 }
@@ -1871,11 +1938,12 @@ template <class ELFT> void ObjFile<ELFT>::parseLazy() {
   for (size_t i = firstGlobal, end = eSyms.size(); i != end; ++i) {
     if (eSyms[i].st_shndx == SHN_UNDEF)
       continue;
-    symbols[i] = symtab.insert(CHECK(eSyms[i].getName(stringTable), this));
+    symbols[i] = insertSymbol(eSyms, i);
     symbols[i]->resolve(LazySymbol{*this});
     if (!lazy)
       break;
   }
+  symNameHashes = {};
 }
 
 bool InputFile::shouldExtractForCommon(StringRef name) const {
@@ -251,6 +251,7 @@ public:
 
   void parse(bool ignoreComdats = false);
   void parseLazy();
+  void hashSymbolNames();
 
   StringRef getShtGroupSignature(ArrayRef<Elf_Shdr> sections,
                                  const Elf_Shdr &sec);
@@ -298,6 +299,7 @@ private:
                           const llvm::object::ELFFile<ELFT> &obj);
   void initializeSymbols(const llvm::object::ELFFile<ELFT> &obj);
   void initializeJustSymbols();
+  Symbol *insertSymbol(ArrayRef<Elf_Sym> eSyms, size_t i);
 
   InputSectionBase *getRelocTarget(uint32_t idx, const Elf_Shdr &sec,
                                    uint32_t info);
@@ -320,6 +322,10 @@ private:
   // If the section does not exist (which is common), the array is empty.
   ArrayRef<Elf_Word> shndxTable;
 
+  // Hash values of global symbol names computed by hashSymbolNames(). Empty
+  // if not computed or after symbols have been inserted into the symbol table.
+  SmallVector<uint32_t, 0> symNameHashes;
+
   // Debugging information to retrieve source file and line for error
   // reporting. Linker may find reasonable number of errors in a
   // single object file, so we cache debugging information in order to
@@ -333,11 +339,17 @@ public:
   BitcodeFile(MemoryBufferRef m, StringRef archiveName,
               uint64_t offsetInArchive, bool lazy);
   static bool classof(const InputFile *f) { return f->kind() == BitcodeKind; }
+  // Reads the irsymtab. This is independent of other files, so archive
+  // members are initialized in parallel.
+  void init();
   void parse();
   void parseLazy();
   void postParse();
   std::unique_ptr<llvm::lto::InputFile> obj;
   std::vector<bool> keptComdats;
+
+private:
+  MemoryBufferRef ltoBuffer;
 };
 
 // .so file.
@@ -385,6 +397,11 @@ public:
 InputFile *createInternalFile(StringRef name);
 ELFFileBase *createObjFile(MemoryBufferRef mb, StringRef archiveName = "",
                            bool lazy = false);
+// Same as createObjFile, but does not read the section and symbol tables. The
+// caller must call ELFFileBase::init() before using the file. This allows
+// initializing many archive members in parallel.
+ELFFileBase *createUninitializedObjFile(MemoryBufferRef mb,
+                                        StringRef archiveName, bool lazy);
 
 std::string replaceThinLTOSuffix(StringRef path);
 
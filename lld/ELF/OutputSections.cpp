@@ -378,9 +378,23 @@ template <class ELFT> void OutputSection::maybeCompress() {
     size_t pos = 0;
 
     ZSTD_CCtx *cctx = ZSTD_createCCtx();
-    // Ignore error if zstd was not built with ZSTD_MULTITHREAD.
+    // -O0 favors link time and uses the fastest regular level. Otherwise use
+    // zstd's default level.
+    (void)ZSTD_CCtx_setParameter(cctx, ZSTD_c_compressionLevel,
+                                 config->optimize == 0 ? 1
+                                                       : ZSTD_CLEVEL_DEFAULT);
+    // Ignore errors if zstd was not built with ZSTD_MULTITHREAD.
     (void)ZSTD_CCtx_setParameter(cctx, ZSTD_c_nbWorkers,
                                  parallel::strategy.compute_thread_count());
+    // The default job size is several times the window size, which leaves
+    // most workers idle for all but the largest sections. Split the section
+    // into about 16 jobs instead; zstd clamps the value to its minimum
+    // (512 KiB). The output depends on the job size but not on the number of
+    // workers, so the job size must only depend on the section size to keep
+    // the output independent of the host and of --threads.
+    (void)ZSTD_CCtx_setParameter(
+        cctx, ZSTD_c_jobSize,
+        static_cast<int>(std::min<uint64_t>(size / 16, 1 << 29)));
     ZSTD_outBuffer zob = {out.data(), out.size(), 0};
     ZSTD_EndDirective directive = ZSTD_e_continue;
     const size_t blockSize = ZSTD_CStreamInSize();
@@ -419,8 +433,11 @@ template <class ELFT> void OutputSection::maybeCompress() {
   // seems enough.
   const int level = config->optimize >= 2 ? 6 : Z_BEST_SPEED;
 
-  // Split input into 1-MiB shards.
-  constexpr size_t shardSize = 1 << 20;
+  // Split input into shards of at most 1 MiB. Sections smaller than 16 MiB use
+  // smaller shards (down to 64 KiB) so that several threads have work. The
+  // shard size only depends on the section size, as the output depends on it.
+  const size_t shardSize = std::clamp<size_t>(
+      PowerOf2Ceil(size / 16), size_t(1) << 16, size_t(1) << 20);
   auto shardsIn = split(ArrayRef<uint8_t>(buf.get(), size), shardSize);
   const size_t numShards = shardsIn.size();
 
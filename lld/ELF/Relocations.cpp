@@ -1146,22 +1146,25 @@ void RelocationScanner::processAux(RelExpr expr, RelType type, uint64_t offset,
     if (rel != 0) {
       if (config->emachine == EM_MIPS && rel == target->symbolicRel)
         rel = target->relativeRel;
-      std::lock_guard<std::mutex> lock(relocMutex);
+      // Symbolic relocations go to per-thread shards like relative ones do.
+      // mergeRels() concatenates the shards and computeRels() sorts them by
+      // (r_sym, r_offset), so the output does not depend on scheduling.
       Partition &part = sec->getPartition();
       if (config->emachine == EM_AARCH64 && type == R_AARCH64_AUTH_ABS64) {
         // For a preemptible symbol, we can't use a relative relocation. For an
         // undefined symbol, we can't compute offset at link-time and use a
         // relative relocation. Use a symbolic relocation instead.
         if (sym.isPreemptible) {
-          part.relaDyn->addSymbolReloc(type, *sec, offset, sym, addend, type);
+          part.relaDyn->addSymbolReloc<true>(type, *sec, offset, sym, addend,
+                                             type);
         } else {
-          part.relaDyn->addReloc({R_AARCH64_AUTH_RELATIVE, sec, offset,
-                                  DynamicReloc::AddendOnlyWithTargetVA, sym,
-                                  addend, R_ABS});
+          part.relaDyn->addReloc<true>({R_AARCH64_AUTH_RELATIVE, sec, offset,
+                                        DynamicReloc::AddendOnlyWithTargetVA,
+                                        sym, addend, R_ABS});
         }
         return;
       }
-      part.relaDyn->addSymbolReloc(rel, *sec, offset, sym, addend, type);
+      part.relaDyn->addSymbolReloc<true>(rel, *sec, offset, sym, addend, type);
 
       // MIPS ABI turns using of GOT and dynamic relocations inside out.
       // While regular ABI uses dynamic relocations to fill up GOT entries
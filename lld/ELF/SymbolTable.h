@@ -44,6 +44,11 @@ public:
 
   Symbol *insert(StringRef name);
 
+  // Same as insert(name), but takes hashName(name) computed ahead of time,
+  // e.g. in parallel while parsing input files.
+  Symbol *insert(StringRef name, uint32_t hash);
+  static uint32_t hashName(StringRef name);
+
   template <typename T> Symbol *addSymbol(const T &newSym) {
     Symbol *sym = insert(newSym.getName());
     sym->resolve(newSym);
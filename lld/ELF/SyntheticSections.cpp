@@ -1623,13 +1623,22 @@ RelocationBaseSection::RelocationBaseSection(StringRef name, uint32_t type,
       dynamicTag(dynamicTag), sizeDynamicTag(sizeDynamicTag),
       relocsVec(concurrency), combreloc(combreloc) {}
 
+template <bool shard>
 void RelocationBaseSection::addSymbolReloc(
     RelType dynType, InputSectionBase &isec, uint64_t offsetInSec, Symbol &sym,
     int64_t addend, std::optional<RelType> addendRelType) {
-  addReloc(DynamicReloc::AgainstSymbol, dynType, isec, offsetInSec, sym, addend,
-           R_ADDEND, addendRelType ? *addendRelType : target->noneRel);
+  addReloc<shard>(DynamicReloc::AgainstSymbol, dynType, isec, offsetInSec, sym,
+                  addend, R_ADDEND,
+                  addendRelType ? *addendRelType : target->noneRel);
 }
 
+template void RelocationBaseSection::addSymbolReloc<false>(
+    RelType, InputSectionBase &, uint64_t, Symbol &, int64_t,
+    std::optional<RelType>);
+template void RelocationBaseSection::addSymbolReloc<true>(
+    RelType, InputSectionBase &, uint64_t, Symbol &, int64_t,
+    std::optional<RelType>);
+
 void RelocationBaseSection::addAddendOnlyRelocIfNonPreemptible(
     RelType dynType, GotSection &sec, uint64_t offsetInSec, Symbol &sym,
     RelType addendRelType) {
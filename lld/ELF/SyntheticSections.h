@@ -505,6 +505,7 @@ public:
     relocs.push_back(reloc);
   }
   /// Add a dynamic relocation against \p sym with an optional addend.
+  template <bool shard = false>
   void addSymbolReloc(RelType dynType, InputSectionBase &isec,
                       uint64_t offsetInSec, Symbol &sym, int64_t addend = 0,
                       std::optional<RelType> addendRelType = {});
@@ -2789,6 +2789,10 @@ template <class ELFT> void Writer<ELFT>::writeBuildId() {
     return;
   }
 
+  // Hashing a large output takes a while. Let the OS start writing the output
+  // file in the meantime.
+  buffer->startWriteback();
+
   // Compute a hash of all sections of the output file.
   size_t hashSize = mainPart->buildId->hashSize;
   std::unique_ptr<uint8_t[]> buildId(new uint8_t[hashSize]);
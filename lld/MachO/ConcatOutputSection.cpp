@@ -15,6 +15,7 @@
 #include "Target.h"
 #include "lld/Common/CommonLinkerContext.h"
 #include "llvm/BinaryFormat/MachO.h"
+#include "llvm/Support/Parallel.h"
 #include "llvm/Support/ScopedPrinter.h"
 #include "llvm/Support/TimeProfiler.h"
 
@@ -131,23 +132,35 @@ bool TextOutputSection::needsThunks() const {
       std::min(target->backwardBranchRange, target->forwardBranchRange))
     return false;
   // Yes, this program is large enough to need thunks.
-  for (ConcatInputSection *isec : inputs) {
-    for (Reloc &r : isec->relocs) {
-      if (!target->hasAttr(r.type, RelocAttrBits::BRANCH))
-        continue;
-      auto *sym = r.referent.get<Symbol *>();
-      // Pre-populate the thunkMap and memoize call site counts for every
-      // InputSection and ThunkInfo. We do this for the benefit of
-      // estimateStubsInRangeVA().
-      ThunkInfo &thunkInfo = thunkMap[sym];
-      // Knowing ThunkInfo call site count will help us know whether or not we
-      // might need to create more for this referent at the time we are
-      // estimating distance to __stubs in estimateStubsInRangeVA().
-      ++thunkInfo.callSiteCount;
-      // We can avoid work on InputSections that have no BRANCH relocs.
-      isec->hasCallSites = true;
-    }
-  }
+  //
+  // Pre-populate the thunkMap and memoize call site counts for every
+  // InputSection and ThunkInfo. We do this for the benefit of
+  // estimateStubsInRangeVA(). Knowing ThunkInfo call site count will help us
+  // know whether or not we might need to create more for this referent at the
+  // time we are estimating distance to __stubs in estimateStubsInRangeVA().
+  //
+  // Large programs have millions of call sites, so count them in parallel:
+  // each task counts the call sites of a contiguous range of input sections,
+  // and the per-task counts are summed up afterwards. The result does not
+  // depend on the number of tasks.
+  size_t numTasks = std::min<size_t>(
+      inputs.size(), parallel::strategy.compute_thread_count() * 4);
+  std::vector<DenseMap<Symbol *, uint32_t>> counts(numTasks);
+  parallelFor(0, numTasks, [&](size_t task) {
+    size_t begin = inputs.size() * task / numTasks;
+    size_t end = inputs.size() * (task + 1) / numTasks;
+    for (ConcatInputSection *isec : ArrayRef(inputs).slice(begin, end - begin))
+      for (Reloc &r : isec->relocs) {
+        if (!target->hasAttr(r.type, RelocAttrBits::BRANCH))
+          continue;
+        ++counts[task][r.referent.get<Symbol *>()];
+        // We can avoid work on InputSections that have no BRANCH relocs.
+        isec->hasCallSites = true;
+      }
+  });
+  for (DenseMap<Symbol *, uint32_t> &m : counts)
+    for (const auto &[sym, count] : m)
+      thunkMap[sym].callSiteCount += count;
   return true;
 }
 
@@ -817,11 +817,18 @@ void ObjCSelRefsHelper::initialize() {
   // Search methnames already referenced in __objc_selrefs
   // Map the name to the corresponding selref entry
   // which we will reuse when creating objc stubs.
-  for (ConcatInputSection *isec : inputSections) {
+  //
+  // Looking up the method name of a selref requires a binary search over the
+  // pieces of the __objc_methname section it refers to. Do that in parallel,
+  // then fill the map sequentially so that later selrefs still take
+  // precedence over earlier ones with the same name.
+  std::vector<StringRef> methnames(inputSections.size());
+  parallelFor(0, inputSections.size(), [&](size_t i) {
+    ConcatInputSection *isec = inputSections[i];
     if (isec->shouldOmitFromOutput())
-      continue;
+      return;
     if (isec->getName() != section_names::objcSelrefs)
-      continue;
+      return;
     // We expect a single relocation per selref entry to __objc_methname that
     // might be aggregated.
     assert(isec->relocs.size() == 1);
@@ -829,11 +836,13 @@ void ObjCSelRefsHelper::initialize() {
     if (const auto *sym = Reloc.referent.dyn_cast<Symbol *>()) {
       if (const auto *d = dyn_cast<Defined>(sym)) {
         auto *cisec = cast<CStringInputSection>(d->isec());
-        auto methname = cisec->getStringRefAtOffset(d->value);
-        methnameToSelref[CachedHashStringRef(methname)] = isec;
+        methnames[i] = cisec->getStringRefAtOffset(d->value);
       }
     }
-  }
+  });
+  for (size_t i = 0, e = inputSections.size(); i != e; ++i)
+    if (methnames[i].data())
+      methnameToSelref[CachedHashStringRef(methnames[i])] = inputSections[i];
 }
 
 void ObjCSelRefsHelper::cleanup() { methnameToSelref.clear(); }
@@ -65,7 +65,29 @@ void CodeSection::finalizeContents() {
   createHeader(bodySize);
 }
 
-void CodeSection::writeTo(uint8_t *buf) {
+// Spawns tasks that write `chunks`, each covering roughly 4 MiB of output.
+// Every chunk writes its own disjoint range of `buf`, including the
+// relocations it applies.
+template <class ChunkT>
+static void spawnChunkWrites(ArrayRef<ChunkT *> chunks, uint8_t *buf,
+                             parallel::TaskGroup &tg) {
+  const size_t taskSizeLimit = 4 << 20;
+  size_t begin = 0;
+  size_t taskSize = 0;
+  for (size_t i = 0, e = chunks.size(); i != e;) {
+    taskSize += chunks[i]->getSize();
+    if (++i == e || taskSize >= taskSizeLimit) {
+      tg.spawn([=] {
+        for (size_t j = begin; j != i; ++j)
+          chunks[j]->writeTo(buf);
+      });
+      begin = i;
+      taskSize = 0;
+    }
+  }
+}
+
+uint8_t *CodeSection::writeHeader(uint8_t *buf) {
   log("writing " + toString(*this) + " offset=" + Twine(offset) +
       " size=" + Twine(getSize()));
   log(" headersize=" + Twine(header.size()));
@@ -78,12 +100,22 @@ void CodeSection::writeTo(uint8_t *buf) {
 
   // Write code section headers
   memcpy(buf, codeSectionHeader.data(), codeSectionHeader.size());
+  return buf;
+}
+
+void CodeSection::writeTo(uint8_t *buf) {
+  buf = writeHeader(buf);
 
   // Write code section bodies
   for (const InputChunk *chunk : functions)
     chunk->writeTo(buf);
 }
 
+void CodeSection::spawnWriteTo(uint8_t *buf, parallel::TaskGroup &tg) {
+  buf = writeHeader(buf);
+  spawnChunkWrites(functions, buf, tg);
+}
+
 uint32_t CodeSection::getNumRelocations() const {
   uint32_t count = 0;
   for (const InputChunk *func : functions)
@@ -256,7 +288,7 @@ void CustomSection::finalizeContents() {
   createHeader(payloadSize + nameData.size());
 }
 
-void CustomSection::writeTo(uint8_t *buf) {
+uint8_t *CustomSection::writeHeader(uint8_t *buf) {
   log("writing " + toString(*this) + " offset=" + Twine(offset) +
       " size=" + Twine(getSize()) + " chunks=" + Twine(inputSections.size()));
 
@@ -267,13 +299,22 @@ void CustomSection::writeTo(uint8_t *buf) {
   memcpy(buf, header.data(), header.size());
   buf += header.size();
   memcpy(buf, nameData.data(), nameData.size());
-  buf += nameData.size();
+  return buf + nameData.size();
+}
+
+void CustomSection::writeTo(uint8_t *buf) {
+  buf = writeHeader(buf);
 
   // Write custom sections payload
   for (const InputChunk *section : inputSections)
     section->writeTo(buf);
 }
 
+void CustomSection::spawnWriteTo(uint8_t *buf, parallel::TaskGroup &tg) {
+  buf = writeHeader(buf);
+  spawnChunkWrites(ArrayRef(inputSections), buf, tg);
+}
+
 uint32_t CustomSection::getNumRelocations() const {
   uint32_t count = 0;
   for (const InputChunk *inputSect : inputSections)
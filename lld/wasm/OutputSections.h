@@ -14,6 +14,7 @@
 #include "lld/Common/ErrorHandler.h"
 #include "lld/Common/LLVM.h"
 #include "llvm/ADT/DenseMap.h"
+#include "llvm/Support/Parallel.h"
 
 namespace lld {
 
@@ -39,6 +40,11 @@ public:
   virtual size_t getSize() const = 0;
   virtual size_t getOffset() { return offset; }
   virtual void writeTo(uint8_t *buf) = 0;
+  // Schedules writeTo on `tg`. Sections made of many input chunks override
+  // this to spread their payload over several tasks.
+  virtual void spawnWriteTo(uint8_t *buf, llvm::parallel::TaskGroup &tg) {
+    tg.spawn([=] { writeTo(buf); });
+  }
   virtual void finalizeContents() = 0;
   virtual uint32_t getNumRelocations() const { return 0; }
   virtual void writeRelocations(raw_ostream &os) const {}
@@ -64,6 +70,7 @@ public:
 
   size_t getSize() const override { return header.size() + bodySize; }
   void writeTo(uint8_t *buf) override;
+  void spawnWriteTo(uint8_t *buf, llvm::parallel::TaskGroup &tg) override;
   uint32_t getNumRelocations() const override;
   void writeRelocations(raw_ostream &os) const override;
   bool isNeeded() const override { return functions.size() > 0; }
@@ -72,6 +79,8 @@ public:
   ArrayRef<InputFunction *> functions;
 
 protected:
+  uint8_t *writeHeader(uint8_t *buf);
+
   std::string codeSectionHeader;
   size_t bodySize = 0;
 };
@@ -120,12 +129,14 @@ public:
     return header.size() + nameData.size() + payloadSize;
   }
   void writeTo(uint8_t *buf) override;
+  void spawnWriteTo(uint8_t *buf, llvm::parallel::TaskGroup &tg) override;
   uint32_t getNumRelocations() const override;
   void writeRelocations(raw_ostream &os) const override;
   void finalizeContents() override;
 
 protected:
   void finalizeInputSections();
+  uint8_t *writeHeader(uint8_t *buf);
   size_t payloadSize = 0;
   std::vector<InputChunk *> inputSections;
   std::string nameData;
@@ -219,10 +219,14 @@ void Writer::writeHeader() {
 
 void Writer::writeSections() {
   uint8_t *buf = buffer->getBufferStart();
-  parallelForEach(outputSections, [buf](OutputSection *s) {
+  // Spawn every section on one task group rather than from a parallelForEach,
+  // so that large sections can split their chunks into tasks of their own; a
+  // parallel loop nested in a worker thread would run serially.
+  parallel::TaskGroup tg;
+  for (OutputSection *s : outputSections) {
     assert(s->isNeeded());
-    s->writeTo(buf);
-  });
+    s->spawnWriteTo(buf, tg);
+  }
 }
 
 // Computes a hash value of Data using a given hash function.
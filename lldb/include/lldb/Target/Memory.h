@@ -62,7 +62,11 @@ private:
   MemoryCache(const MemoryCache &) = delete;
   const MemoryCache &operator=(const MemoryCache &) = delete;
 
-  lldb::DataBufferSP GetL2CacheLine(lldb::addr_t addr, Status &error);
+  /// Get the L2 cache line at \a addr, reading it from the inferior if it
+  /// isn't cached. If \a read_next_line is true and the following line isn't
+  /// cached either, both lines are filled in with a single read.
+  lldb::DataBufferSP GetL2CacheLine(lldb::addr_t addr, Status &error,
+                                    bool read_next_line = false);
 };
 
     
@@ -97,6 +97,8 @@ public:
 
   void SetPreloadSymbols(bool b);
 
+  bool GetParallelModuleLoad() const;
+
   bool GetDisableASLR() const;
 
   void SetDisableASLR(bool b);
@@ -603,6 +605,16 @@ public:
   lldb::ModuleSP GetOrCreateModule(const ModuleSpec &module_spec, bool notify,
                                    Status *error_ptr = nullptr);
 
+  /// Find the binaries satisfying \p module_specs and parse their object
+  /// files, and their symbols if target.preload-symbols is set, in parallel
+  /// on the debugger's thread pool.
+  ///
+  /// The Modules are left in the shared module cache and are not added to the
+  /// Target. A later GetOrCreateModule call for one of \p module_specs finds
+  /// it there, so that a caller can load many Modules in parallel and still
+  /// add them to the Target one by one, in the order it needs.
+  void PrefetchModules(llvm::ArrayRef<ModuleSpec> module_specs);
+
   // Settings accessors
 
   static TargetProperties &GetGlobalProperties();
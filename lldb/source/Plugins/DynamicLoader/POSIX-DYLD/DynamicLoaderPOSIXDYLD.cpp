@@ -437,6 +437,7 @@ void DynamicLoaderPOSIXDYLD::RefreshModules() {
       E = m_rendezvous.end();
       m_initial_modules_added = true;
     }
+    std::vector<const DYLDRendezvous::SOEntry *> entries;
     for (; I != E; ++I) {
       // Don't load a duplicate copy of ld.so if we have already loaded it
       // earlier in LoadInterpreterModule. If we instead loaded then unloaded it
@@ -445,9 +446,10 @@ void DynamicLoaderPOSIXDYLD::RefreshModules() {
       if ((m_interpreter_module.lock() != nullptr) &&
           (I->base_addr == m_interpreter_base))
         continue;
+      entries.push_back(&*I);
+    }
 
-      ModuleSP module_sp =
-          LoadModuleAtAddress(I->file_spec, I->link_addr, I->base_addr, true);
+    for (ModuleSP &module_sp : LoadModulesAtAddresses(entries)) {
       if (!module_sp.get())
         continue;
 
@@ -620,6 +622,29 @@ ModuleSP DynamicLoaderPOSIXDYLD::LoadModuleAtAddress(const FileSpec &file,
   return nullptr;
 }
 
+std::vector<ModuleSP> DynamicLoaderPOSIXDYLD::LoadModulesAtAddresses(
+    llvm::ArrayRef<const DYLDRendezvous::SOEntry *> entries) {
+  Target &target = m_process->GetTarget();
+  // Finding, opening and parsing the object files of the modules, and
+  // preloading their symbols if target.preload-symbols is set, dominates the
+  // time of attaching to a process with many shared libraries. Do that in
+  // parallel, then add the modules to the target in link map order.
+  if (target.GetParallelModuleLoad()) {
+    std::vector<ModuleSpec> module_specs;
+    module_specs.reserve(entries.size());
+    for (const DYLDRendezvous::SOEntry *entry : entries)
+      module_specs.emplace_back(entry->file_spec, target.GetArchitecture());
+    target.PrefetchModules(module_specs);
+  }
+
+  std::vector<ModuleSP> module_sps;
+  module_sps.reserve(entries.size());
+  for (const DYLDRendezvous::SOEntry *entry : entries)
+    module_sps.push_back(LoadModuleAtAddress(
+        entry->file_spec, entry->link_addr, entry->base_addr, true));
+  return module_sps;
+}
+
 void DynamicLoaderPOSIXDYLD::LoadAllCurrentModules() {
   DYLDRendezvous::iterator I;
   DYLDRendezvous::iterator E;
@@ -647,19 +672,23 @@ void DynamicLoaderPOSIXDYLD::LoadAllCurrentModules() {
   m_process->PrefetchModuleSpecs(
       module_names, m_process->GetTarget().GetArchitecture().GetTriple());
 
-  for (I = m_rendezvous.begin(), E = m_rendezvous.end(); I != E; ++I) {
-    ModuleSP module_sp =
-        LoadModuleAtAddress(I->file_spec, I->link_addr, I->base_addr, true);
-    if (module_sp.get()) {
+  std::vector<const DYLDRendezvous::SOEntry *> entries;
+  for (I = m_rendezvous.begin(), E = m_rendezvous.end(); I != E; ++I)
+    entries.push_back(&*I);
+  std::vector<ModuleSP> module_sps = LoadModulesAtAddresses(entries);
+
+  for (size_t i = 0; i < entries.size(); ++i) {
+    const DYLDRendezvous::SOEntry &entry = *entries[i];
+    if (ModuleSP module_sp = module_sps[i]) {
       LLDB_LOG(log, "LoadAllCurrentModules loading module: {0}",
-               I->file_spec.GetFilename());
+               entry.file_spec.GetFilename());
       module_list.Append(module_sp);
     } else {
       Log *log = GetLog(LLDBLog::DynamicLoader);
       LLDB_LOGF(
           log,
           "DynamicLoaderPOSIXDYLD::%s failed loading module %s at 0x%" PRIx64,
-          __FUNCTION__, I->file_spec.GetPath().c_str(), I->base_addr);
+          __FUNCTION__, entry.file_spec.GetPath().c_str(), entry.base_addr);
     }
   }
 
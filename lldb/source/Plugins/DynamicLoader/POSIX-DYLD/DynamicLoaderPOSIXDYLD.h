@@ -11,6 +11,7 @@
 
 #include <map>
 #include <memory>
+#include <vector>
 
 #include "DYLDRendezvous.h"
 #include "Plugins/Process/Utility/AuxVector.h"
@@ -111,6 +112,15 @@ protected:
   /// of loaded modules.
   void RefreshModules();
 
+  /// Loads the modules of \p entries with LoadModuleAtAddress, in order. If
+  /// target.parallel-module-load is set, their object files are first parsed
+  /// in parallel with Target::PrefetchModules.
+  ///
+  /// \returns The modules in the order of \p entries, with a null module for
+  /// each entry that failed to load.
+  std::vector<lldb::ModuleSP> LoadModulesAtAddresses(
+      llvm::ArrayRef<const DYLDRendezvous::SOEntry *> entries);
+
   /// Updates the load address of every allocatable section in \p module.
   ///
   /// \param module The module to traverse.
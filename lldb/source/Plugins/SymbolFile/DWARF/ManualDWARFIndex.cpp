@@ -23,6 +23,8 @@
 #include "lldb/Utility/Timer.h"
 #include "llvm/Support/FormatVariadic.h"
 #include "llvm/Support/ThreadPool.h"
+#include <algorithm>
+#include <limits>
 #include <optional>
 
 using namespace lldb_private;
@@ -30,6 +32,42 @@ using namespace lldb;
 using namespace lldb_private::dwarf;
 using namespace lldb_private::plugin::dwarf;
 
+// Compute the bounds of up to \a max_shards ranges of name pointer values that
+// split \a index of all \a sets into shards of roughly equal size. The first
+// and last bounds cover all names.
+static std::vector<uintptr_t>
+ComputeShardBounds(llvm::ArrayRef<ManualDWARFIndex::IndexSet> sets,
+                   NameToDIE ManualDWARFIndex::IndexSet::*index,
+                   size_t max_shards) {
+  // Sharding only pays off for indexes that take a while to sort.
+  constexpr size_t min_entries_per_shard = 16 * 1024;
+  size_t total = 0;
+  for (const auto &set : sets)
+    total += (set.*index).GetSize();
+  const size_t num_shards =
+      std::clamp<size_t>(total / min_entries_per_shard, 1, max_shards);
+  std::vector<uintptr_t> bounds = {0};
+  if (num_shards > 1) {
+    // Take a few dozen evenly spaced samples per shard from all sets and use
+    // their quantiles as the bounds.
+    const size_t stride = std::max<size_t>(1, total / (num_shards * 64));
+    std::vector<uintptr_t> samples;
+    size_t next = 0;
+    for (const auto &set : sets) {
+      const NameToDIE &names = set.*index;
+      for (; next < names.GetSize(); next += stride)
+        samples.push_back(uintptr_t(names.GetNameAtIndexUnchecked(next)
+                                        .GetCString()));
+      next -= names.GetSize();
+    }
+    llvm::sort(samples);
+    for (size_t i = 1; i < num_shards; ++i)
+      bounds.push_back(samples[i * samples.size() / num_shards]);
+  }
+  bounds.push_back(std::numeric_limits<uintptr_t>::max());
+  return bounds;
+}
+
 void ManualDWARFIndex::Index() {
   if (m_indexed)
     return;
@@ -116,22 +154,51 @@ void ManualDWARFIndex::Index() {
     task_group.async(parser_fn, i);
   task_group.wait();
 
-  auto finalize_fn = [this, &sets, &progress](NameToDIE(IndexSet::*index)) {
-    NameToDIE &result = m_set.*index;
+  // Merging the index sets of all units and sorting the result is the bulk of
+  // finalizing, and a few of the indexes (e.g. types and function basenames)
+  // hold most of the entries. Split each index into shards by name so that the
+  // shards can be merged and sorted in parallel. The shards cover increasing
+  // ranges of the name pointer values that NameToDIE::Finalize() sorts by, so
+  // the finalized shards concatenate into a finalized index.
+  NameToDIE IndexSet::*const indexes[] = {
+      &IndexSet::function_basenames,   &IndexSet::function_fullnames,
+      &IndexSet::function_methods,     &IndexSet::function_selectors,
+      &IndexSet::objc_class_selectors, &IndexSet::globals,
+      &IndexSet::types,                &IndexSet::namespaces};
+  constexpr size_t num_indexes = std::size(indexes);
+  const size_t max_shards =
+      std::max(1u, Debugger::GetThreadPool().getMaxConcurrency());
+  std::vector<uintptr_t> shard_bounds[num_indexes];
+  std::vector<NameToDIE> shards[num_indexes];
+  for (size_t i = 0; i < num_indexes; ++i) {
+    shard_bounds[i] = ComputeShardBounds(sets, indexes[i], max_shards);
+    shards[i].resize(shard_bounds[i].size() - 1);
+  }
+
+  auto finalize_shard_fn = [&](size_t i, size_t shard) {
+    NameToDIE &result = shards[i][shard];
     for (auto &set : sets)
-      result.Append(set.*index);
+      result.AppendRange(set.*indexes[i], shard_bounds[i][shard],
+                         shard_bounds[i][shard + 1]);
     result.Finalize();
+  };
+
+  for (size_t i = 0; i < num_indexes; ++i)
+    for (size_t shard = 0; shard < shards[i].size(); ++shard)
+      task_group.async(finalize_shard_fn, i, shard);
+  task_group.wait();
+
+  // The index sets of the units are no longer needed.
+  sets.clear();
+
+  auto concat_fn = [&](size_t i) {
+    (m_set.*indexes[i]).AppendFinalized(shards[i]);
+    shards[i].clear();
     progress.Increment();
   };
 
-  task_group.async(finalize_fn, &IndexSet::function_basenames);
-  task_group.async(finalize_fn, &IndexSet::function_fullnames);
-  task_group.async(finalize_fn, &IndexSet::function_methods);
-  task_group.async(finalize_fn, &IndexSet::function_selectors);
-  task_group.async(finalize_fn, &IndexSet::objc_class_selectors);
-  task_group.async(finalize_fn, &IndexSet::globals);
-  task_group.async(finalize_fn, &IndexSet::types);
-  task_group.async(finalize_fn, &IndexSet::namespaces);
+  for (size_t i = 0; i < num_indexes; ++i)
+    task_group.async(concat_fn, i);
   task_group.wait();
 
   SaveToCache();
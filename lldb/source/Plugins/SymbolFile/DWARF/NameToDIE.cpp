@@ -92,6 +92,25 @@ void NameToDIE::Append(const NameToDIE &other) {
   }
 }
 
+void NameToDIE::AppendRange(const NameToDIE &other, uintptr_t lower,
+                            uintptr_t upper) {
+  for (const auto &entry : other.m_map) {
+    const uintptr_t name = uintptr_t(entry.cstring.GetCString());
+    if (lower <= name && name < upper)
+      m_map.Append(entry);
+  }
+}
+
+void NameToDIE::AppendFinalized(llvm::ArrayRef<NameToDIE> shards) {
+  size_t size = m_map.GetSize();
+  for (const NameToDIE &shard : shards)
+    size += shard.m_map.GetSize();
+  m_map.Reserve(size);
+  for (const NameToDIE &shard : shards)
+    for (const auto &entry : shard.m_map)
+      m_map.Append(entry);
+}
+
 constexpr llvm::StringLiteral kIdentifierNameToDIE("N2DI");
 
 bool NameToDIE::Decode(const DataExtractor &data, lldb::offset_t *offset_ptr,
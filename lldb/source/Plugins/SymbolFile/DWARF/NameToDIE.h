@@ -15,6 +15,7 @@
 #include "lldb/Core/UniqueCStringMap.h"
 #include "lldb/Core/dwarf.h"
 #include "lldb/lldb-defines.h"
+#include "llvm/ADT/ArrayRef.h"
 
 namespace lldb_private::plugin {
 namespace dwarf {
@@ -32,6 +33,16 @@ public:
 
   void Append(const NameToDIE &other);
 
+  /// Append the entries of \a other whose name pointer values are in the
+  /// half-open range [\a lower, \a upper). Finalize() orders entries by these
+  /// values, so maps built from disjoint ranges can be finalized separately
+  /// and then concatenated with AppendFinalized().
+  void AppendRange(const NameToDIE &other, uintptr_t lower, uintptr_t upper);
+
+  /// Append finalized \a shards that cover increasing name ranges. If this map
+  /// was empty, it is finalized afterwards without needing to be sorted.
+  void AppendFinalized(llvm::ArrayRef<NameToDIE> shards);
+
   void Finalize();
 
   bool Find(ConstString name,
@@ -83,6 +94,12 @@ public:
 
   bool IsEmpty() const { return m_map.IsEmpty(); }
 
+  size_t GetSize() const { return m_map.GetSize(); }
+
+  ConstString GetNameAtIndexUnchecked(size_t idx) const {
+    return m_map.GetCStringAtIndexUnchecked(idx);
+  }
+
   void Clear() { m_map.Clear(); }
 
 protected:
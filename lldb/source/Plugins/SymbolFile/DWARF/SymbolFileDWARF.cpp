@@ -2695,6 +2695,19 @@ uint64_t SymbolFileDWARF::GetDebugInfoSize(bool load_all_debug_info) {
   return debug_info_size;
 }
 
+void SymbolFileDWARF::GetTypesFromIndex(
+    ConstString name, llvm::function_ref<bool(DWARFDIE die)> callback) {
+  if (m_type_names_not_in_index.contains(name))
+    return;
+  bool found = false;
+  m_index->GetTypes(name, [&](DWARFDIE die) {
+    found = true;
+    return callback(die);
+  });
+  if (!found)
+    m_type_names_not_in_index.insert(name);
+}
+
 void SymbolFileDWARF::FindTypes(const TypeQuery &query, TypeResults &results) {
 
   // Make sure we haven't already searched this SymbolFile before.
@@ -2704,7 +2717,7 @@ void SymbolFileDWARF::FindTypes(const TypeQuery &query, TypeResults &results) {
   std::lock_guard<std::recursive_mutex> guard(GetModuleMutex());
 
   bool have_index_match = false;
-  m_index->GetTypes(query.GetTypeBasename(), [&](DWARFDIE die) {
+  GetTypesFromIndex(query.GetTypeBasename(), [&](DWARFDIE die) {
     // Check the language, but only if we have a language filter.
     if (query.HasLanguage()) {
       if (!query.LanguageMatches(GetLanguageFamily(*die.GetCU())))
@@ -2762,7 +2775,7 @@ void SymbolFileDWARF::FindTypes(const TypeQuery &query, TypeResults &results) {
 
       // Copy our match's context and update the basename we are looking for
       // so we can use this only to compare the context correctly.
-      m_index->GetTypes(query_simple.GetTypeBasename(), [&](DWARFDIE die) {
+      GetTypesFromIndex(query_simple.GetTypeBasename(), [&](DWARFDIE die) {
         // Check the language, but only if we have a language filter.
         if (query.HasLanguage()) {
           if (!query.LanguageMatches(GetLanguageFamily(*die.GetCU())))
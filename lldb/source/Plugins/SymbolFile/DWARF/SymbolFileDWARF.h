@@ -17,6 +17,7 @@
 #include <vector>
 
 #include "llvm/ADT/DenseMap.h"
+#include "llvm/ADT/DenseSet.h"
 #include "llvm/ADT/SetVector.h"
 #include "llvm/Support/Threading.h"
 
@@ -485,6 +486,13 @@ protected:
                 dw_offset_t max_die_offset, uint32_t type_mask,
                 TypeSet &type_set);
 
+  /// Call \a callback for the type DIEs named \a name in the index. Names
+  /// that have no index entries are remembered so that repeating lookups of
+  /// them, which the expression parser does for every identifier it can't
+  /// find, doesn't have to search the index again.
+  void GetTypesFromIndex(ConstString name,
+                         llvm::function_ref<bool(DWARFDIE die)> callback);
+
   typedef RangeDataVector<lldb::addr_t, lldb::addr_t, Variable *>
       GlobalVariableMap;
 
@@ -536,6 +544,8 @@ protected:
   DIEToTypePtr m_die_to_type;
   DIEToVariableSP m_die_to_variable_sp;
   CompilerTypeToDIE m_forward_decl_compiler_type_to_die;
+  /// Type names that have no entries in m_index.
+  llvm::DenseSet<ConstString> m_type_names_not_in_index;
   llvm::DenseMap<dw_offset_t, std::unique_ptr<SupportFileList>>
       m_type_unit_support_files;
   std::vector<uint32_t> m_lldb_cu_to_dwarf_unit;
@@ -10,6 +10,7 @@
 #include <set>
 
 #include "lldb/Core/DataFileCache.h"
+#include "lldb/Core/Debugger.h"
 #include "lldb/Core/Module.h"
 #include "lldb/Core/RichManglingContext.h"
 #include "lldb/Core/Section.h"
@@ -27,6 +28,7 @@
 #include "llvm/ADT/ArrayRef.h"
 #include "llvm/ADT/StringRef.h"
 #include "llvm/Support/DJB.h"
+#include "llvm/Support/ThreadPool.h"
 
 using namespace lldb;
 using namespace lldb_private;
@@ -381,14 +383,26 @@ void Symtab::InitNameIndexes() {
       RegisterBacklogEntry(record.first, record.second, class_contexts);
     }
 
-    name_to_index.Sort();
-    name_to_index.SizeToFit();
-    selector_to_index.Sort();
-    selector_to_index.SizeToFit();
-    basename_to_index.Sort();
-    basename_to_index.SizeToFit();
-    method_to_index.Sort();
-    method_to_index.SizeToFit();
+    auto finalize_fn = [](NameToIndexMap &map) {
+      map.Sort();
+      map.SizeToFit();
+    };
+    // Sorting the name indexes of a large symbol table takes a while, and the
+    // indexes are independent of each other.
+    constexpr size_t min_symbols_for_parallel_sort = 64 * 1024;
+    if (num_symbols < min_symbols_for_parallel_sort) {
+      finalize_fn(name_to_index);
+      finalize_fn(selector_to_index);
+      finalize_fn(basename_to_index);
+      finalize_fn(method_to_index);
+    } else {
+      llvm::ThreadPoolTaskGroup task_group(Debugger::GetThreadPool());
+      task_group.async(finalize_fn, std::ref(name_to_index));
+      task_group.async(finalize_fn, std::ref(selector_to_index));
+      task_group.async(finalize_fn, std::ref(basename_to_index));
+      task_group.async(finalize_fn, std::ref(method_to_index));
+      task_group.wait();
+    }
   }
 }
 
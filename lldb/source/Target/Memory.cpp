@@ -14,6 +14,7 @@
 #include "lldb/Utility/RangeMap.h"
 #include "lldb/Utility/State.h"
 
+#include <algorithm>
 #include <cinttypes>
 #include <memory>
 
@@ -124,7 +125,8 @@ bool MemoryCache::RemoveInvalidRange(lldb::addr_t base_addr,
 }
 
 lldb::DataBufferSP MemoryCache::GetL2CacheLine(lldb::addr_t line_base_addr,
-                                               Status &error) {
+                                               Status &error,
+                                               bool read_next_line) {
   // This function assumes that the address given is aligned correctly.
   assert((line_base_addr % m_L2_cache_line_byte_size) == 0);
 
@@ -133,18 +135,45 @@ lldb::DataBufferSP MemoryCache::GetL2CacheLine(lldb::addr_t line_base_addr,
   if (pos != m_L2_cache.end())
     return pos->second;
 
-  auto data_buffer_heap_sp =
-      std::make_shared<DataBufferHeap>(m_L2_cache_line_byte_size, 0);
+  // Every read from the inferior can be a round trip to a remote stub, so
+  // fill in the next line as well if the caller is going to need it.
+  const addr_t next_line_base_addr = line_base_addr + m_L2_cache_line_byte_size;
+  if (read_next_line && m_L2_cache.count(next_line_base_addr))
+    read_next_line = false;
+  const size_t read_size = read_next_line ? m_L2_cache_line_byte_size * 2
+                                          : m_L2_cache_line_byte_size;
+
+  auto data_buffer_heap_sp = std::make_shared<DataBufferHeap>(read_size, 0);
   size_t process_bytes_read = m_process.ReadMemoryFromInferior(
       line_base_addr, data_buffer_heap_sp->GetBytes(),
       data_buffer_heap_sp->GetByteSize(), error);
 
+  // The next line may not be readable, and not every stub returns what it
+  // could read of a range. Give the first line a chance on its own.
+  if (process_bytes_read == 0 && read_next_line) {
+    error.Clear();
+    return GetL2CacheLine(line_base_addr, error);
+  }
+
   // If we failed a read, not much we can do.
   if (process_bytes_read == 0)
     return lldb::DataBufferSP();
 
+  // Split off whatever we got of the next line, and copy the first line to
+  // not keep the space for two lines around.
+  if (read_next_line) {
+    if (process_bytes_read > m_L2_cache_line_byte_size)
+      m_L2_cache[next_line_base_addr] = std::make_shared<DataBufferHeap>(
+          data_buffer_heap_sp->GetBytes() + m_L2_cache_line_byte_size,
+          process_bytes_read - m_L2_cache_line_byte_size);
+    process_bytes_read =
+        std::min<size_t>(process_bytes_read, m_L2_cache_line_byte_size);
+    data_buffer_heap_sp = std::make_shared<DataBufferHeap>(
+        data_buffer_heap_sp->GetBytes(), process_bytes_read);
+  }
+
   // If we didn't get a complete read, we can still cache what we did get.
-  if (process_bytes_read < m_L2_cache_line_byte_size)
+  if (process_bytes_read < data_buffer_heap_sp->GetByteSize())
     data_buffer_heap_sp->SetByteSize(process_bytes_read);
 
   m_L2_cache[line_base_addr] = data_buffer_heap_sp;
@@ -205,7 +234,13 @@ size_t MemoryCache::Read(addr_t addr, void *dst, size_t dst_len,
   // We're going to have all of our loads and reads be cache line aligned.
   addr_t cache_line_offset = addr % m_L2_cache_line_byte_size;
   addr_t cache_line_base_addr = addr - cache_line_offset;
-  DataBufferSP first_cache_line = GetL2CacheLine(cache_line_base_addr, error);
+  const bool straddles_lines =
+      cache_line_offset + dst_len > m_L2_cache_line_byte_size;
+  DataBufferSP first_cache_line = GetL2CacheLine(
+      cache_line_base_addr, error,
+      straddles_lines &&
+          !m_invalid_ranges.FindEntryThatContains(cache_line_base_addr +
+                                                  m_L2_cache_line_byte_size));
   // If we get nothing, then the read to the inferior likely failed. Nothing to
   // do here.
   if (!first_cache_line)
@@ -66,10 +66,12 @@
 
 #include "llvm/ADT/ScopeExit.h"
 #include "llvm/ADT/SetVector.h"
+#include "llvm/Support/ThreadPool.h"
 
 #include <memory>
 #include <mutex>
 #include <optional>
+#include <set>
 #include <sstream>
 
 using namespace lldb;
@@ -2155,6 +2157,37 @@ bool Target::ReadPointerFromMemory(const Address &addr, Status &error,
   return false;
 }
 
+void Target::PrefetchModules(llvm::ArrayRef<ModuleSpec> module_specs) {
+  if (!m_platform_sp)
+    return;
+
+  // Two tasks looking for the same binary would both miss the shared module
+  // cache and create separate Modules for it.
+  std::set<FileSpec> seen_files;
+  std::vector<const ModuleSpec *> unique_specs;
+  for (const ModuleSpec &module_spec : module_specs)
+    if (seen_files.insert(module_spec.GetFileSpec()).second)
+      unique_specs.push_back(&module_spec);
+
+  FileSpecList search_paths = GetExecutableSearchPaths();
+  const bool preload_symbols = GetPreloadSymbols();
+  llvm::ThreadPoolTaskGroup task_group(Debugger::GetThreadPool());
+  for (const ModuleSpec *module_spec : unique_specs) {
+    task_group.async([this, module_spec, &search_paths, preload_symbols]() {
+      ModuleSP module_sp;
+      m_platform_sp->GetSharedModule(*module_spec, m_process_sp.get(),
+                                     module_sp, &search_paths,
+                                     /*old_modules=*/nullptr,
+                                     /*did_create_ptr=*/nullptr);
+      if (!module_sp || !module_sp->GetObjectFile())
+        return;
+      if (preload_symbols)
+        module_sp->PreloadSymbols();
+    });
+  }
+  task_group.wait();
+}
+
 ModuleSP Target::GetOrCreateModule(const ModuleSpec &module_spec, bool notify,
                                    Status *error_ptr) {
   ModuleSP module_sp;
@@ -4288,6 +4321,12 @@ void TargetProperties::SetPreloadSymbols(bool b) {
   SetPropertyAtIndex(idx, b);
 }
 
+bool TargetProperties::GetParallelModuleLoad() const {
+  const uint32_t idx = ePropertyParallelModuleLoad;
+  return GetPropertyAtIndexAs<bool>(
+      idx, g_target_properties[idx].default_uint_value != 0);
+}
+
 bool TargetProperties::GetDisableASLR() const {
   const uint32_t idx = ePropertyDisableASLR;
   return GetPropertyAtIndexAs<bool>(
@@ -16,8 +16,10 @@
 #include "lldb/Utility/DataEncoder.h"
 #include "lldb/Utility/DataExtractor.h"
 #include "llvm/ADT/STLExtras.h"
+#include "llvm/Support/FormatVariadic.h"
 #include "gmock/gmock.h"
 #include "gtest/gtest.h"
+#include <limits>
 
 using namespace lldb;
 using namespace lldb_private;
@@ -109,6 +111,39 @@ TEST(DWARFIndexCachingTest, NameToDIEEncodeDecode) {
   EncodeDecode(map);
 }
 
+TEST(DWARFIndexCachingTest, NameToDIEShardedFinalize) {
+  NameToDIE first, second;
+  for (unsigned i = 0; i < 100; ++i) {
+    ConstString name(llvm::formatv("name{0}", i % 37).str());
+    (i % 2 ? first : second)
+        .Insert(name, DIERef(std::nullopt, DIERef::Section::DebugInfo, i));
+  }
+
+  NameToDIE expected;
+  expected.Append(first);
+  expected.Append(second);
+  expected.Finalize();
+
+  // Finalizing shards that are split by name pointer value and concatenating
+  // them must give the same map as finalizing all entries at once.
+  const uintptr_t middle =
+      uintptr_t(expected.GetNameAtIndexUnchecked(expected.GetSize() / 2)
+                    .GetCString());
+  const uintptr_t bounds[] = {0, middle, std::numeric_limits<uintptr_t>::max()};
+  std::vector<NameToDIE> shards(2);
+  for (size_t shard = 0; shard < shards.size(); ++shard) {
+    shards[shard].AppendRange(first, bounds[shard], bounds[shard + 1]);
+    shards[shard].AppendRange(second, bounds[shard], bounds[shard + 1]);
+    shards[shard].Finalize();
+  }
+  EXPECT_FALSE(shards[0].IsEmpty());
+  EXPECT_FALSE(shards[1].IsEmpty());
+
+  NameToDIE sharded;
+  sharded.AppendFinalized(shards);
+  EXPECT_TRUE(expected == sharded);
+}
+
 static void EncodeDecode(const ManualDWARFIndex::IndexSet &object,
                          ByteOrder byte_order) {
   const uint8_t addr_size = 8;
@@ -50,6 +50,7 @@ public:
   void RefreshStateAfterStop() override {}
   size_t DoReadMemory(lldb::addr_t vm_addr, void *buf, size_t size,
                       Status &error) override {
+    ++m_num_reads;
     if (m_bytes_left == 0)
       return 0;
 
@@ -72,6 +73,7 @@ public:
 
   // Test-specific additions
   size_t m_bytes_left;
+  size_t m_num_reads = 0;
   MemoryCache &GetMemoryCache() { return m_memory_cache; }
   void SetMaxReadSize(size_t size) { m_bytes_left = size; }
 };
@@ -226,3 +228,50 @@ TEST_F(MemoryTest, TesetMemoryCacheRead) {
                                                        // instead of using an
                                                        // old cache
 }
+
+TEST_F(MemoryTest, MemoryCacheReadStraddlingLines) {
+  ArchSpec arch("x86_64-apple-macosx-");
+
+  Platform::SetHostPlatform(PlatformRemoteMacOSX::CreateInstance(true, &arch));
+
+  DebuggerSP debugger_sp = Debugger::CreateInstance();
+  ASSERT_TRUE(debugger_sp);
+
+  TargetSP target_sp = CreateTarget(debugger_sp, arch);
+  ASSERT_TRUE(target_sp);
+
+  ListenerSP listener_sp(Listener::MakeListener("dummy"));
+  ProcessSP process_sp = std::make_shared<DummyProcess>(target_sp, listener_sp);
+  ASSERT_TRUE(process_sp);
+
+  DummyProcess *process = static_cast<DummyProcess *>(process_sp.get());
+  MemoryCache &mem_cache = process->GetMemoryCache();
+  const uint64_t l2_cache_size = process->GetMemoryCacheLineSize();
+  Status error;
+  auto data_sp = std::make_shared<DataBufferHeap>(l2_cache_size, '\0');
+  size_t bytes_read = 0;
+
+  // Straddling two uncached lines fills in both with one read.
+  process->SetMaxReadSize(l2_cache_size * 2);
+  bytes_read = mem_cache.Read(0x1001, data_sp->GetBytes(),
+                              data_sp->GetByteSize(), error);
+  ASSERT_EQ(bytes_read, l2_cache_size);
+  ASSERT_EQ(process->m_bytes_left, 0u);
+  ASSERT_EQ(process->m_num_reads, 1u);
+
+  // Both lines are cached now.
+  data_sp->SetByteSize(l2_cache_size - 1);
+  bytes_read = mem_cache.Read(0x1000 + l2_cache_size + 1, data_sp->GetBytes(),
+                              data_sp->GetByteSize(), error);
+  ASSERT_EQ(bytes_read, l2_cache_size - 1);
+  ASSERT_EQ(process->m_num_reads, 1u);
+
+  // If the first line is cached, only the second line is read.
+  process->SetMaxReadSize(l2_cache_size);
+  data_sp->SetByteSize(l2_cache_size);
+  bytes_read = mem_cache.Read(0x1000 + l2_cache_size + 5, data_sp->GetBytes(),
+                              data_sp->GetByteSize(), error);
+  ASSERT_EQ(bytes_read, l2_cache_size);
+  ASSERT_EQ(process->m_bytes_left, 0u);
+  ASSERT_EQ(process->m_num_reads, 2u);
+}
@@ -0,0 +1,107 @@
+//===-- PrefetchModulesTest.cpp -------------------------------------------===//
+//
+// Part of the LLVM Project, under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+//===----------------------------------------------------------------------===//
+
+#include "Plugins/ObjectFile/ELF/ObjectFileELF.h"
+#include "Plugins/Platform/Linux/PlatformLinux.h"
+#include "Plugins/SymbolFile/Symtab/SymbolFileSymtab.h"
+#include "TestingSupport/SubsystemRAII.h"
+#include "TestingSupport/TestUtilities.h"
+#include "lldb/Core/Debugger.h"
+#include "lldb/Core/Module.h"
+#include "lldb/Core/ModuleList.h"
+#include "lldb/Core/ModuleSpec.h"
+#include "lldb/Host/HostInfo.h"
+#include "lldb/Target/Target.h"
+#include "gtest/gtest.h"
+
+using namespace lldb;
+using namespace lldb_private;
+using namespace lldb_private::platform_linux;
+
+namespace {
+
+constexpr llvm::StringLiteral k_arch("aarch64-none-linux");
+
+class PrefetchModulesTest : public testing::Test {
+  SubsystemRAII<FileSystem, HostInfo, ObjectFileELF, PlatformLinux,
+                SymbolFileSymtab>
+      subsystems;
+
+public:
+  void SetUp() override {
+    std::call_once(TestUtilities::g_debugger_initialize_flag,
+                   []() { Debugger::Initialize(nullptr); });
+
+    ArchSpec host_arch("i386-pc-linux");
+    Platform::SetHostPlatform(
+        PlatformLinux::CreateInstance(true, &host_arch));
+    m_debugger_sp = Debugger::CreateInstance();
+    ASSERT_TRUE(m_debugger_sp);
+
+    ArchSpec arch(k_arch);
+    PlatformSP platform_sp = PlatformLinux::CreateInstance(true, &arch);
+    ASSERT_TRUE(platform_sp);
+    m_debugger_sp->GetTargetList().CreateTarget(
+        *m_debugger_sp, "", arch, eLoadDependentsNo, platform_sp, m_target_sp);
+    ASSERT_TRUE(m_target_sp);
+
+    for (llvm::StringRef name :
+         {"AndroidModule.so", "AndroidModule.unstripped.so"})
+      m_module_specs.emplace_back(FileSpec(GetInputFilePath(name)), arch);
+  }
+
+  void TearDown() override {
+    for (const ModuleSpec &module_spec : m_module_specs) {
+      ModuleList shared_modules;
+      ModuleList::FindSharedModules(module_spec, shared_modules);
+      for (ModuleSP module_sp : shared_modules.Modules())
+        ModuleList::RemoveSharedModule(module_sp);
+    }
+    if (m_debugger_sp)
+      Debugger::Destroy(m_debugger_sp);
+  }
+
+  ModuleSP FindSharedModule(const ModuleSpec &module_spec) {
+    ModuleList shared_modules;
+    ModuleList::FindSharedModules(module_spec, shared_modules);
+    EXPECT_EQ(shared_modules.GetSize(), 1u);
+    return shared_modules.GetModuleAtIndex(0);
+  }
+
+  DebuggerSP m_debugger_sp;
+  TargetSP m_target_sp;
+  std::vector<ModuleSpec> m_module_specs;
+};
+
+} // namespace
+
+TEST_F(PrefetchModulesTest, AddsModulesInCallerOrder) {
+  // A binary that is asked for twice is only loaded once.
+  std::vector<ModuleSpec> module_specs = m_module_specs;
+  module_specs.push_back(m_module_specs[0]);
+  m_target_sp->PrefetchModules(module_specs);
+
+  // The modules are cached, but not added to the target.
+  EXPECT_EQ(m_target_sp->GetImages().GetSize(), 0u);
+  ModuleSP first_sp = FindSharedModule(m_module_specs[0]);
+  ModuleSP second_sp = FindSharedModule(m_module_specs[1]);
+  ASSERT_TRUE(first_sp);
+  ASSERT_TRUE(second_sp);
+  EXPECT_NE(first_sp->GetObjectFile(), nullptr);
+  EXPECT_NE(second_sp->GetObjectFile(), nullptr);
+
+  // Adding the modules to the target finds the cached ones, and the image list
+  // is in the order they are added in.
+  EXPECT_EQ(m_target_sp->GetOrCreateModule(m_module_specs[1], false),
+            second_sp);
+  EXPECT_EQ(m_target_sp->GetOrCreateModule(m_module_specs[0], false),
+            first_sp);
+  ASSERT_EQ(m_target_sp->GetImages().GetSize(), 2u);
+  EXPECT_EQ(m_target_sp->GetImages().GetModuleAtIndex(0), second_sp);
+  EXPECT_EQ(m_target_sp->GetImages().GetModuleAtIndex(1), first_sp);
+}
@@ -0,0 +1,74 @@
+//===- FormatIntegers.cpp - Integer formatting through raw_ostream --------===//
+//
+// Part of the LLVM Project, under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+//===----------------------------------------------------------------------===//
+//
+// Measures decimal, zero-padded decimal and hexadecimal integer output through
+// raw_ostream, the hot path of textual dumpers and the asm printer.
+//
+//===----------------------------------------------------------------------===//
+
+#include "benchmark/benchmark.h"
+#include "llvm/Support/Format.h"
+#include "llvm/Support/raw_ostream.h"
+#include <cstdint>
+#include <random>
+#include <vector>
+
+using namespace llvm;
+
+static std::vector<uint64_t> makeValues(unsigned MaxBits) {
+  std::mt19937_64 Gen(1);
+  std::vector<uint64_t> Values(4096);
+  for (uint64_t &V : Values)
+    V = Gen() >> (64 - 1 - Gen() % MaxBits);
+  return Values;
+}
+
+static void BM_FormatDecimal(benchmark::State &State) {
+  auto Values = makeValues(State.range(0));
+  std::string Str;
+  raw_string_ostream OS(Str);
+  for (auto _ : State) {
+    Str.clear();
+    for (uint64_t V : Values)
+      OS << V << ' ';
+    benchmark::DoNotOptimize(Str.data());
+  }
+  State.SetItemsProcessed(State.iterations() * Values.size());
+}
+
+static void BM_FormatPaddedDecimal(benchmark::State &State) {
+  auto Values = makeValues(32);
+  std::string Str;
+  raw_string_ostream OS(Str);
+  for (auto _ : State) {
+    Str.clear();
+    for (uint64_t V : Values)
+      OS << format_decimal(V, 12) << ' ';
+    benchmark::DoNotOptimize(Str.data());
+  }
+  State.SetItemsProcessed(State.iterations() * Values.size());
+}
+
+static void BM_FormatHex(benchmark::State &State) {
+  auto Values = makeValues(State.range(0));
+  std::string Str;
+  raw_string_ostream OS(Str);
+  for (auto _ : State) {
+    Str.clear();
+    for (uint64_t V : Values)
+      OS << format_hex(V, 18) << ' ';
+    benchmark::DoNotOptimize(Str.data());
+  }
+  State.SetItemsProcessed(State.iterations() * Values.size());
+}
+
+BENCHMARK(BM_FormatDecimal)->Arg(8)->Arg(32)->Arg(64);
+BENCHMARK(BM_FormatPaddedDecimal);
+BENCHMARK(BM_FormatHex)->Arg(8)->Arg(32)->Arg(64);
+
+BENCHMARK_MAIN();
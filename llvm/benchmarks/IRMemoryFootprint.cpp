@@ -0,0 +1,66 @@
+//===- IRMemoryFootprint.cpp - Memory used by in-memory IR ----------------===//
+//
+// Part of the LLVM Project, under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+//===----------------------------------------------------------------------===//
+//
+// Reports the heap memory needed per instruction to build a function, and how
+// much of it is taken by the operand Use lists. This is meant to track the
+// effect of changes to the layout of Value, User, Use and Instruction.
+//
+//===----------------------------------------------------------------------===//
+
+#include "benchmark/benchmark.h"
+#include "llvm/IR/IRBuilder.h"
+#include "llvm/IR/InstIterator.h"
+#include "llvm/IR/LLVMContext.h"
+#include "llvm/IR/Module.h"
+#include "llvm/Support/Process.h"
+
+using namespace llvm;
+
+// Build a function with a straight-line mix of address computations, loads,
+// arithmetic and stores, and return the total number of operands.
+static size_t buildFunction(Module &M, unsigned NumInsts) {
+  LLVMContext &Ctx = M.getContext();
+  Type *I64 = Type::getInt64Ty(Ctx);
+  PointerType *PtrTy = PointerType::getUnqual(Ctx);
+  auto *FTy = FunctionType::get(I64, {PtrTy, I64}, /*isVarArg=*/false);
+  Function *F = Function::Create(FTy, GlobalValue::ExternalLinkage, "f", M);
+  IRBuilder<> B(BasicBlock::Create(Ctx, "entry", F));
+  Value *Base = F->getArg(0);
+  Value *Acc = F->getArg(1);
+  for (unsigned I = 0; I < NumInsts; I += 4) {
+    Value *Addr = B.CreateGEP(I64, Base, B.getInt64(I));
+    Value *Load = B.CreateLoad(I64, Addr);
+    Acc = B.CreateAdd(Acc, Load);
+    B.CreateStore(Acc, Addr);
+  }
+  B.CreateRet(Acc);
+
+  size_t NumOperands = 0;
+  for (const Instruction &Inst : instructions(*F))
+    NumOperands += Inst.getNumOperands();
+  return NumOperands;
+}
+
+static void BM_IRMemoryFootprint(benchmark::State &State) {
+  unsigned NumInsts = State.range(0);
+  size_t Bytes = 0, NumOperands = 0;
+  for (auto _ : State) {
+    LLVMContext Ctx;
+    size_t Before = sys::Process::GetMallocUsage();
+    Module M("footprint", Ctx);
+    NumOperands = buildFunction(M, NumInsts);
+    Bytes = sys::Process::GetMallocUsage() - Before;
+    benchmark::DoNotOptimize(&M);
+  }
+  State.counters["bytes_per_inst"] = double(Bytes) / NumInsts;
+  State.counters["use_bytes_per_inst"] =
+      double(NumOperands * sizeof(Use)) / NumInsts;
+}
+BENCHMARK(BM_IRMemoryFootprint)->Arg(1 << 12)->Arg(1 << 16);
+
+BENCHMARK_MAIN();
@@ -223,6 +223,56 @@ public:
     return {};
   }
 
+  /// Find the entry for \p Key without inserting it. This may run
+  /// concurrently with insertions; it only locks the bucket holding \p Key.
+  ///
+  /// \returns the entry or nullptr if \p Key is not in the table.
+  KeyDataTy *find(const KeyTy &Key) {
+    uint64_t Hash = Info::getHashValue(Key);
+    Bucket &CurBucket = BucketsArray[getBucketIdx(Hash)];
+    uint32_t ExtHashBits = getExtHashBits(Hash);
+
+#if LLVM_ENABLE_THREADS
+    std::lock_guard<std::mutex> Lock(CurBucket.Guard);
+#endif
+
+    HashesPtr BucketHashes = CurBucket.Hashes;
+    DataPtr BucketEntries = CurBucket.Entries;
+    uint32_t CurEntryIdx = getStartIdx(ExtHashBits, CurBucket.Size);
+
+    // Buckets are rehashed before they become full, so probing always
+    // reaches an empty slot.
+    while (true) {
+      uint32_t CurEntryHashBits = BucketHashes[CurEntryIdx];
+
+      if (CurEntryHashBits == 0 && BucketEntries[CurEntryIdx] == nullptr)
+        return nullptr;
+
+      if (CurEntryHashBits == ExtHashBits) {
+        KeyDataTy *EntryData = BucketEntries[CurEntryIdx];
+        if (Info::isEqual(Info::getKey(*EntryData), Key))
+          return EntryData;
+      }
+
+      CurEntryIdx++;
+      CurEntryIdx &= (CurBucket.Size - 1);
+    }
+  }
+
+  /// \returns the number of entries in the table. This is only exact if no
+  /// insertions are running concurrently.
+  uint64_t size() {
+    uint64_t NumEntries = 0;
+    for (uint32_t Idx = 0; Idx < NumberOfBuckets; Idx++) {
+      Bucket &CurBucket = BucketsArray[Idx];
+#if LLVM_ENABLE_THREADS
+      std::lock_guard<std::mutex> Lock(CurBucket.Guard);
+#endif
+      NumEntries += CurBucket.NumberOfEntries;
+    }
+    return NumEntries;
+  }
+
   /// Print information about current state of hash table structures.
   void printStatistic(raw_ostream &OS) {
     OS << "\n--- HashTable statistic:\n";
@@ -55,6 +55,10 @@ protected:
   StringMapImpl(unsigned InitSize, unsigned ItemSize);
   unsigned RehashTable(unsigned BucketNo = 0);
 
+  /// Move all items into a new table of NewSize buckets and return the new
+  /// bucket number of the item in BucketNo.
+  unsigned RehashTableTo(unsigned NewSize, unsigned BucketNo);
+
   /// LookupBucketFor - Look up the bucket that the specified string should end
   /// up in.  If it already exists as a key in the map, the Item pointer for the
   /// specified bucket will be non-null.  Otherwise, it will be null.  In either
@@ -102,6 +106,9 @@ public:
   bool empty() const { return NumItems == 0; }
   unsigned size() const { return NumItems; }
 
+  /// Grow the table so that it can hold NumEntries items without rehashing.
+  void reserve(unsigned NumEntries);
+
   /// Returns the hash value that will be used for the given string.
   /// This allows precomputing the value and passing it explicitly
   /// to some of the functions.
@@ -250,8 +257,11 @@ public:
 
   /// lookup - Return the entry for the specified key, or a default
   /// constructed value if no such entry exists.
-  ValueTy lookup(StringRef Key) const {
-    const_iterator Iter = find(Key);
+  ValueTy lookup(StringRef Key) const { return lookup(Key, hash(Key)); }
+
+  /// Overload that explicitly takes precomputed hash(Key).
+  ValueTy lookup(StringRef Key, uint32_t FullHashValue) const {
+    const_iterator Iter = find(Key, FullHashValue);
     if (Iter != end())
       return Iter->second;
     return ValueTy();
@@ -272,9 +282,19 @@ public:
   /// contains - Return true if the element is in the map, false otherwise.
   bool contains(StringRef Key) const { return find(Key) != end(); }
 
+  /// Overload that explicitly takes precomputed hash(Key).
+  bool contains(StringRef Key, uint32_t FullHashValue) const {
+    return find(Key, FullHashValue) != end();
+  }
+
   /// count - Return 1 if the element is in the map, 0 otherwise.
   size_type count(StringRef Key) const { return contains(Key) ? 1 : 0; }
 
+  /// Overload that explicitly takes precomputed hash(Key).
+  size_type count(StringRef Key, uint32_t FullHashValue) const {
+    return contains(Key, FullHashValue) ? 1 : 0;
+  }
+
   template <typename InputTy>
   size_type count(const StringMapEntry<InputTy> &MapEntry) const {
     return count(MapEntry.getKey());
@@ -335,8 +355,12 @@ public:
 
   /// Inserts elements from range [first, last). If multiple elements in the
   /// range have keys that compare equivalent, it is unspecified which element
-  /// is inserted .
+  /// is inserted . If the range can be measured up front, the table is grown
+  /// once rather than repeatedly while inserting.
   template <typename InputIt> void insert(InputIt First, InputIt Last) {
+    using Category = typename std::iterator_traits<InputIt>::iterator_category;
+    if constexpr (std::is_base_of_v<std::forward_iterator_tag, Category>)
+      reserve(size() + std::distance(First, Last));
     for (InputIt It = First; It != Last; ++It)
       insert(*It);
   }
@@ -1080,6 +1080,24 @@ public:
     return getClobberingMemoryAccess(MA, Loc, BAA);
   }
 
+  /// Append the clobbering access of each of \p MAs to \p Clobbers, in order.
+  /// All queries share \p AA, and walkers that cache their results reuse the
+  /// clobbers found by earlier queries, so passing the accesses in dominance
+  /// order lets later walks stop early.
+  void getClobberingMemoryAccesses(ArrayRef<MemoryAccess *> MAs,
+                                   BatchAAResults &AA,
+                                   SmallVectorImpl<MemoryAccess *> &Clobbers) {
+    Clobbers.reserve(Clobbers.size() + MAs.size());
+    for (MemoryAccess *MA : MAs)
+      Clobbers.push_back(getClobberingMemoryAccess(MA, AA));
+  }
+
+  void getClobberingMemoryAccesses(ArrayRef<MemoryAccess *> MAs,
+                                   SmallVectorImpl<MemoryAccess *> &Clobbers) {
+    BatchAAResults BAA(MSSA->getAA());
+    getClobberingMemoryAccesses(MAs, BAA, Clobbers);
+  }
+
   /// Given a memory access, invalidate anything this walker knows about
   /// that access.
   /// This API is used by walkers that store information to perform basic cache
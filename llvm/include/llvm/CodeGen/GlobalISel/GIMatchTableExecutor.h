@@ -593,6 +593,16 @@ public:
     setupGeneratedPerFunctionState(mf);
   }
 
+  /// Set by -gisel-match-table-profile. When set, executeMatchTable counts how
+  /// often each try-block is entered and rejected, and the counts are printed
+  /// on llvm_shutdown.
+  static bool ProfileMatchTables;
+
+  /// Record that the try-block of executor \p ExecutorName that resumes at
+  /// \p ResumeIdx on failure was entered or, if \p Rejected, rejected.
+  static void profileTryBlock(StringRef ExecutorName, uint64_t ResumeIdx,
+                              bool Rejected);
+
 protected:
   using ComplexRendererFns =
       std::optional<SmallVector<std::function<void(MachineInstrBuilder &)>, 4>>;
@@ -70,6 +70,8 @@ bool GIMatchTableExecutor::executeMatchTable(
     if (OnFailResumeAt.empty())
       return RejectAndGiveUp;
     CurrentIdx = OnFailResumeAt.pop_back_val();
+    if (LLVM_UNLIKELY(ProfileMatchTables))
+      profileTryBlock(TgtExecutor::getName(), CurrentIdx, /*Rejected=*/true);
     DEBUG_WITH_TYPE(TgtExecutor::getName(),
                     dbgs() << CurrentIdx << ": Resume at " << CurrentIdx << " ("
                            << OnFailResumeAt.size() << " try-blocks remain)\n");
@@ -149,6 +151,9 @@ bool GIMatchTableExecutor::executeMatchTable(
       DEBUG_WITH_TYPE(TgtExecutor::getName(),
                       dbgs() << CurrentIdx << ": Begin try-block\n");
       OnFailResumeAt.push_back(readU32());
+      if (LLVM_UNLIKELY(ProfileMatchTables))
+        profileTryBlock(TgtExecutor::getName(), OnFailResumeAt.back(),
+                        /*Rejected=*/false);
       break;
     }
 
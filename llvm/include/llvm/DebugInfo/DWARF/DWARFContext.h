@@ -231,6 +231,12 @@ public:
     return unit_iterator_range(DWOUnits.begin(), DWOUnits.end());
   }
 
+  /// Extract the DIEs of every unit, spreading the work over
+  /// parallel::strategy. Unit DIEs, and with them any errors reported for a
+  /// unit, are extracted serially and in order; only the remaining DIEs are
+  /// parsed in parallel. The context must have been created thread-safe.
+  void extractAllUnitDIEsInParallel();
+
   /// Get the number of compile units in this context.
   unsigned getNumCompileUnits() {
     return State->getNormalUnits().getNumInfoUnits();
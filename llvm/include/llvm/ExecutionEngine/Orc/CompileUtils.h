@@ -13,16 +13,20 @@
 #ifndef LLVM_EXECUTIONENGINE_ORC_COMPILEUTILS_H
 #define LLVM_EXECUTIONENGINE_ORC_COMPILEUTILS_H
 
+#include "llvm/ADT/DenseMap.h"
+#include "llvm/ExecutionEngine/ObjectCache.h"
 #include "llvm/ExecutionEngine/Orc/IRCompileLayer.h"
 #include "llvm/ExecutionEngine/Orc/JITTargetMachineBuilder.h"
 #include "llvm/ExecutionEngine/Orc/Layer.h"
 #include <memory>
+#include <mutex>
+#include <optional>
+#include <string>
 
 namespace llvm {
 
 class MemoryBuffer;
 class Module;
-class ObjectCache;
 class TargetMachine;
 
 namespace orc {
@@ -54,6 +58,7 @@ private:
 
   CompileResult tryToLoadFromObjectCache(const Module &M);
   void notifyObjectCompiled(const Module &M, const MemoryBuffer &ObjBuffer);
+  void notifyObjectCompilationFailed(const Module &M);
 
   TargetMachine &TM;
   ObjectCache *ObjCache = nullptr;
@@ -93,6 +98,41 @@ private:
   ObjectCache *ObjCache = nullptr;
 };
 
+/// A persistent ObjectCache that stores relocatable objects in a directory.
+///
+/// Objects are keyed by a hash of the module's textual IR and a salt that
+/// should describe everything else that affects code generation (see
+/// getCacheSalt). Since SimpleCompiler queries the cache after the
+/// IRTransformLayer has run, the key covers the optimized module. Cache
+/// entries are written atomically, so several processes may share a
+/// directory. Failures to read or write the cache are not reported; they only
+/// cause the module to be recompiled.
+class DirectoryObjectCache : public ObjectCache {
+public:
+  DirectoryObjectCache(std::string CacheDir, std::string Salt)
+      : CacheDir(std::move(CacheDir)), Salt(std::move(Salt)) {}
+
+  /// Returns a salt covering the target triple, CPU, features, relocation and
+  /// code models, and CodeGen optimization level of JTMB.
+  static std::string getCacheSalt(const JITTargetMachineBuilder &JTMB);
+
+  std::unique_ptr<MemoryBuffer> getObject(const Module *M) override;
+  void notifyObjectCompiled(const Module *M, MemoryBufferRef Obj) override;
+  void notifyObjectCompilationFailed(const Module *M) override;
+
+private:
+  std::string getCachePath(const Module &M) const;
+  std::optional<std::string> takePendingPath(const Module *M);
+
+  std::string CacheDir;
+  std::string Salt;
+
+  // Code generation may modify the module, so the path computed in getObject
+  // is remembered for notifyObjectCompiled.
+  std::mutex PendingMutex;
+  DenseMap<const Module *, std::string> PendingPaths;
+};
+
 } // end namespace orc
 
 } // end namespace llvm
@@ -264,6 +264,17 @@ protected:
 
 /// An extended version of LLJIT that supports lazy function-at-a-time
 /// compilation of LLVM IR.
+///
+/// FIXME: There is no tiered compilation. All code goes through a single
+/// IRTransformLayer/IRCompileLayer pipeline, so there is only one optimization
+/// level. Background recompilation of hot functions would need:
+///   - call counters in the lazy reexport stubs (only the first call into a
+///     stub is currently observed, via the LazyCallThroughManager trampoline),
+///   - a second compile pipeline that can re-materialize a function's IR after
+///     CODLayer has emitted it (the ThreadSafeModule is consumed on emission),
+///   - redirection of an already resolved stub through
+///     IndirectStubsManager::updatePointer while other threads may be running
+///     through it.
 class LLLazyJIT : public LLJIT {
   template <typename, typename, typename> friend class LLJITBuilderSetters;
 
@@ -87,6 +87,12 @@ public:
 
   unsigned int getPageSize() override { return PageSize; }
 
+  /// Request huge pages for new reservations (see sys::Memory::MF_HUGE_HINT).
+  /// This is only a hint. When used with MapperJITLinkMemoryManager, pick a
+  /// reservation granularity that is a multiple of the huge page size so that
+  /// code from many small graphs is packed into the same huge pages.
+  void setUseHugePages(bool Enable) { UseHugePages = Enable; }
+
   void reserve(size_t NumBytes, OnReservedFunction OnReserved) override;
 
   void initialize(AllocInfo &AI, OnInitializedFunction OnInitialized) override;
@@ -119,6 +125,7 @@ private:
   AllocationMap Allocations;
 
   size_t PageSize;
+  bool UseHugePages = false;
 };
 
 class SharedMemoryMapper final : public MemoryMapper {
@@ -13,9 +13,12 @@
 #ifndef LLVM_EXECUTIONENGINE_ORC_SPECULATEANALYSES_H
 #define LLVM_EXECUTIONENGINE_ORC_SPECULATEANALYSES_H
 
+#include "llvm/ADT/StringMap.h"
 #include "llvm/Analysis/BranchProbabilityInfo.h"
 #include "llvm/ExecutionEngine/Orc/Core.h"
 #include "llvm/ExecutionEngine/Orc/Speculation.h"
+#include "llvm/Support/MemoryBuffer.h"
+#include <memory>
 
 namespace llvm {
 
@@ -76,6 +79,32 @@ public:
   ResultTy operator()(Function &F);
 };
 
+// Likely callees are taken from a call-sequence profile recorded by a previous
+// run rather than from the IR. Each non-empty line of the profile names a
+// caller followed by the functions it was seen to call, separated by
+// whitespace, e.g. "main parse eval print". Lines starting with '#' are
+// ignored. Functions that do not appear in the profile get no candidates.
+class ProfileQuery : public SpeculateQuery {
+public:
+  // Read the profile stored in the file at Path.
+  static Expected<ProfileQuery> load(StringRef Path);
+
+  // Build a query from an in-memory profile.
+  static ProfileQuery parse(std::unique_ptr<MemoryBuffer> Profile);
+
+  ResultTy operator()(Function &F);
+
+private:
+  // Shared so that copies of the query stored in IRSpeculationLayer's
+  // ResultEval see the same profile; the callee names point into Buffer.
+  struct ProfileData {
+    std::unique_ptr<MemoryBuffer> Buffer;
+    StringMap<SmallVector<StringRef, 4>> Callees;
+  };
+
+  std::shared_ptr<ProfileData> Data;
+};
+
 } // namespace orc
 } // namespace llvm
 
@@ -239,6 +239,11 @@ public:
 
 /// Fragment for data and encoded instructions.
 ///
+/// FIXME: Contents and fixups live in per-fragment SmallVectors that grow by
+/// doubling and are kept until the object file is written, so a large data
+/// fragment carries up to twice its size in slack. Fragments are allocated
+/// with new and freed individually by their section, which rules out a
+/// per-section arena until fragment ownership moves to the MCContext.
 class MCDataFragment : public MCEncodedFragmentWithFixups<32, 4> {
 public:
   MCDataFragment(MCSection *Sec = nullptr)
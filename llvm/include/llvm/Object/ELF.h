@@ -1273,6 +1273,12 @@ template <class ELFT>
 Expected<StringRef>
 ELFFile<ELFT>::getSectionName(const Elf_Shdr &Section,
                               WarningHandler WarnHandler) const {
+  // FIXME: sections() only checks the header fields, so it is cheap, but
+  // every call here looks up and validates .shstrtab again, and a lookup by
+  // name is a linear scan in every client. A lazily built name index would
+  // have to be mutable state in this value type, which lld rebuilds from the
+  // buffer on each getObj() call and reads from several threads. It would
+  // fit better in the long-lived ELFObjectFile.
   auto SectionsOrErr = sections();
   if (!SectionsOrErr)
     return SectionsOrErr.takeError();
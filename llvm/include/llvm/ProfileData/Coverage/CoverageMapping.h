@@ -951,6 +951,17 @@ class CoverageMapping {
   Error loadFunctionRecord(const CoverageMappingRecord &Record,
                            IndexedInstrProfReader &ProfileReader);
 
+  /// Look up the counts and bitmap of \p Record in the profile. Returns false
+  /// if the record is to be skipped because of a hash mismatch.
+  Expected<bool> loadFunctionProfile(const CoverageMappingRecord &Record,
+                                     IndexedInstrProfReader &ProfileReader,
+                                     std::vector<uint64_t> &Counts,
+                                     BitVector &Bitmap);
+
+  /// Add \p Function unless a record with the same name and filenames was
+  /// already added.
+  void addFunctionRecord(FunctionRecord &&Function);
+
   /// Look up the indices for function records which are at least partially
   /// defined in the specified file. This is guaranteed to return a superset of
   /// such records: extra records not in the file may be included if there is
@@ -641,6 +641,14 @@ protected:
   /// index.
   ErrorOr<SampleContextFrames> readContextFromTable(size_t *RetIdx = nullptr);
 
+  /// Decode the CSNameTable entry \p Idx from CSNameTableEntries. A malformed
+  /// entry is left undecoded.
+  std::error_code decodeCSNameTableEntry(size_t Idx);
+
+  /// Read the root and leaf functions of CSNameTable entry \p Idx without
+  /// decoding it.
+  ErrorOr<std::pair<FunctionId, FunctionId>> readCSNameTableEnds(size_t Idx);
+
   /// Read a context indirectly via the CSNameTable if the profile has context,
   /// otherwise same as readStringFromTable, also return its hash value.
   ErrorOr<std::pair<SampleContext, uint64_t>> readSampleContextFromTable();
@@ -655,9 +663,16 @@ protected:
   std::vector<FunctionId> NameTable;
 
   /// CSNameTable is used to save full context vectors. It is the backing buffer
-  /// for SampleContextFrames.
+  /// for SampleContextFrames. Its entries are decoded on first use.
   std::vector<SampleContextFrameVector> CSNameTable;
 
+  /// The start of the encoded form of each CSNameTable entry that has not been
+  /// decoded yet, or null once it has been decoded.
+  std::vector<const uint8_t *> CSNameTableEntries;
+
+  /// The end of the CS name table section.
+  const uint8_t *CSNameTableEnd = nullptr;
+
   /// Table to cache MD5 values of sample contexts corresponding to
   /// readSampleContextFromTable(), used to index into Profiles or
   /// FuncOffsetTable.
@@ -744,13 +759,18 @@ protected:
 
   /// The table mapping from a function context's MD5 to the offset of its
   /// FunctionSample towards file start.
-  /// At most one of FuncOffsetTable and FuncOffsetList is populated.
+  /// At most one of FuncOffsetTable, FuncOffsetList and CSFuncOffsetList is
+  /// populated.
   DenseMap<hash_code, uint64_t> FuncOffsetTable;
 
   /// The list version of FuncOffsetTable. This is used if every entry is
   /// being accessed.
   std::vector<std::pair<SampleContext, uint64_t>> FuncOffsetList;
 
+  /// The version of FuncOffsetList used by CS profiles, which refers to each
+  /// context by its CSNameTable index so that it is only decoded on use.
+  std::vector<std::pair<size_t, uint64_t>> CSFuncOffsetList;
+
   /// The set containing the functions to use when compiling a module.
   DenseSet<StringRef> FuncsToUse;
 
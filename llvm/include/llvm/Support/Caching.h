@@ -8,7 +8,8 @@
 //
 // This file defines the CachedFileStream and the localCache function, which
 // simplifies caching files on the local filesystem in a directory whose
-// contents are managed by a CachePruningPolicy.
+// contents are managed by a CachePruningPolicy. It also defines sharedCache,
+// which puts a store shared between caches behind a local one.
 //
 //===----------------------------------------------------------------------===//
 
@@ -20,6 +21,7 @@
 namespace llvm {
 
 class MemoryBuffer;
+class MemoryBufferRef;
 
 /// This class wraps an output stream for a file. Most clients should just be
 /// able to return an instance of this base class from the stream callback, but
@@ -74,6 +76,24 @@ Expected<FileCache> localCache(
     const Twine &CacheDirectoryPathRef,
     AddBufferFn AddBuffer = [](size_t Task, const Twine &ModuleName,
                                std::unique_ptr<MemoryBuffer> MB) {});
+
+/// Callbacks to a content-addressed store that is shared between several
+/// caches, for example a remote store used by a distributed build. Either
+/// callback may be empty. Both callbacks must be thread safe.
+struct SharedCacheStore {
+  /// Return the file stored under \p Key, or nullptr if there is none.
+  std::function<std::unique_ptr<MemoryBuffer>(StringRef Key)> Fetch;
+  /// Store \p Data under \p Key. Errors are not reported to the client; a
+  /// store that wants to avoid blocking the link may upload asynchronously,
+  /// but must copy \p Data to do so.
+  std::function<void(StringRef Key, MemoryBufferRef Data)> Store;
+};
+
+/// Create a cache that puts \p Shared behind \p Local. Local misses are
+/// looked up in the shared store and, if found, are written to the local cache,
+/// which adds them to the link. Files produced on a miss in both are written to
+/// the local cache and then handed to the shared store.
+FileCache sharedCache(FileCache Local, SharedCacheStore Shared);
 } // namespace llvm
 
 #endif
@@ -72,6 +72,13 @@ public:
   /// deallocates the buffer and the target file is never written.
   virtual ~FileOutputBuffer() = default;
 
+  /// Hints that the current contents of the buffer can be written to the file
+  /// in the background, so that I/O overlaps with whatever the caller does
+  /// before commit(). The buffer remains writable; pages modified after this
+  /// call are written again on commit(). This is a no-op if the buffer is not
+  /// backed by a file mapping or the platform does not support it.
+  virtual void startWriteback() {}
+
   /// This removes the temporary file (unless it already was committed)
   /// but keeps the memory mapping alive.
   virtual void discard() {}
@@ -0,0 +1,76 @@
+//===- MappedMemoryAllocator.h - Page-mapped slab allocator -----*- C++ -*-===//
+//
+// Part of the LLVM Project, under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+//===----------------------------------------------------------------------===//
+/// \file
+///
+/// This file defines MappedMemoryAllocator, which gets memory directly from
+/// the OS page allocator and can ask for it to be backed by huge pages.
+///
+//===----------------------------------------------------------------------===//
+
+#ifndef LLVM_SUPPORT_MAPPEDMEMORYALLOCATOR_H
+#define LLVM_SUPPORT_MAPPEDMEMORYALLOCATOR_H
+
+#include "llvm/Support/AllocatorBase.h"
+#include "llvm/Support/ErrorHandling.h"
+#include "llvm/Support/Memory.h"
+#include "llvm/Support/Process.h"
+#include <cassert>
+
+namespace llvm {
+
+/// An allocator that maps every allocation with sys::Memory, optionally with
+/// sys::Memory::MF_HUGE_HINT. Each allocation costs at least a page, so this
+/// is meant to provide the slabs of a BumpPtrAllocatorImpl with a large slab
+/// size, e.g.
+///
+///   BumpPtrAllocatorImpl<MappedMemoryAllocator, 2 * 1024 * 1024>
+///
+/// which hands out whole huge pages and avoids the page faults of growing a
+/// large arena through malloc.
+class MappedMemoryAllocator : public AllocatorBase<MappedMemoryAllocator> {
+public:
+  explicit MappedMemoryAllocator(bool UseHugePages = true)
+      : UseHugePages(UseHugePages) {}
+
+  void Reset() {}
+
+  LLVM_ATTRIBUTE_RETURNS_NONNULL void *Allocate(size_t Size, size_t Alignment) {
+    assert(Alignment <= sys::Process::getPageSizeEstimate() &&
+           "Alignment larger than a page is not supported");
+    (void)Alignment;
+    unsigned Flags = sys::Memory::MF_READ | sys::Memory::MF_WRITE;
+    if (UseHugePages)
+      Flags |= sys::Memory::MF_HUGE_HINT;
+    std::error_code EC;
+    sys::MemoryBlock MB =
+        sys::Memory::allocateMappedMemory(Size, nullptr, Flags, EC);
+    if (EC)
+      report_bad_alloc_error("Mapping memory failed");
+    return MB.base();
+  }
+
+  // Pull in base class overloads.
+  using AllocatorBase<MappedMemoryAllocator>::Allocate;
+
+  void Deallocate(const void *Ptr, size_t Size, size_t /*Alignment*/) {
+    sys::MemoryBlock MB(const_cast<void *>(Ptr), Size);
+    (void)sys::Memory::releaseMappedMemory(MB);
+  }
+
+  // Pull in base class overloads.
+  using AllocatorBase<MappedMemoryAllocator>::Deallocate;
+
+  void PrintStats() const {}
+
+private:
+  bool UseHugePages;
+};
+
+} // end namespace llvm
+
+#endif // LLVM_SUPPORT_MAPPEDMEMORYALLOCATOR_H
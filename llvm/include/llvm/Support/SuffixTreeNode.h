@@ -124,6 +124,14 @@ public:
   /// A child existing on an unsigned integer implies that from the mapping
   /// represented by the current node, there is a way to reach another
   /// mapping by tacking that character on the end of the current string.
+  ///
+  /// FIXME: A DenseMap allocates at least 64 buckets on its first insertion,
+  /// i.e. 1 KiB per internal node, while most internal nodes have only two or
+  /// three children. A small inline map or a sibling list would use a fraction
+  /// of the memory, but RepeatedSubstringIterator reports start indices in
+  /// child iteration order and the MachineOutliner discards overlapping
+  /// candidates greedily in that order, so changing the container changes
+  /// which candidates are outlined.
   DenseMap<unsigned, SuffixTreeNode *> Children;
 
   SuffixTreeInternalNode(unsigned StartIdx, unsigned EndIdx,
@@ -129,6 +129,13 @@ constexpr bool llvm_is_multithreaded() { return LLVM_ENABLE_THREADS; }
     // threads, or hardware cores.
     bool Limit = false;
 
+    // If set, pin each pool thread to a single CPU from the process affinity
+    // mask, so that threads do not migrate across sockets and memory they
+    // first touch stays local. Threads fill one hardware thread of every
+    // physical core, package by package, before using SMT siblings. Only
+    // implemented on Linux.
+    bool PinThreads = false;
+
     /// Retrieves the max available threads for the current strategy. This
     /// accounts for affinity masks and takes advantage of all CPU sockets.
     unsigned compute_thread_count() const;
@@ -149,6 +156,7 @@ constexpr bool llvm_is_multithreaded() { return LLVM_ENABLE_THREADS; }
   /// strategy, we attempt to equally allocate the threads on all CPU sockets.
   /// "0" or an empty string will return the \p Default strategy.
   /// "all" for using all hardware threads.
+  /// "pinned" for using one thread per physical core, each pinned to its core.
   std::optional<ThreadPoolStrategy>
   get_threadpool_strategy(StringRef Num, ThreadPoolStrategy Default = {});
 
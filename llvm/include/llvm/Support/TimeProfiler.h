@@ -94,6 +94,13 @@ struct TimeTraceProfilerEntry;
 void timeTraceProfilerInitialize(unsigned TimeTraceGranularity,
                                  StringRef ProcName);
 
+/// Keep at most \p MaxEntries completed time sections per thread in profilers
+/// initialized after this call, discarding the oldest sections once the limit
+/// is reached. This bounds the memory used by the profiler so that it can stay
+/// enabled in a long-running process and be written out on demand. 0, the
+/// default, keeps every section.
+void timeTraceProfilerSetMaxEntries(size_t MaxEntries);
+
 /// Cleanup the time trace profiler, if it was initialized.
 void timeTraceProfilerCleanup();
 
@@ -136,6 +143,13 @@ timeTraceProfilerBegin(StringRef Name,
 TimeTraceProfilerEntry *timeTraceAsyncProfilerBegin(StringRef Name,
                                                     StringRef Detail);
 
+/// Attach the integer argument \p Key = \p Value to the open time section
+/// \p E. Arguments are emitted alongside the detail string, which allows
+/// recording values that are only known once the section ends, e.g. memory
+/// allocated within it.
+void timeTraceProfilerAddArgument(TimeTraceProfilerEntry *E, StringRef Key,
+                                  int64_t Value);
+
 /// Manually end the last time section.
 void timeTraceProfilerEnd();
 void timeTraceProfilerEnd(TimeTraceProfilerEntry *E);
@@ -169,6 +183,12 @@ public:
       timeTraceProfilerEnd(Entry);
   }
 
+  /// Attach an integer argument to this section. Does nothing if the profiler
+  /// is disabled.
+  void addArgument(StringRef Key, int64_t Value) {
+    timeTraceProfilerAddArgument(Entry, Key, Value);
+  }
+
 private:
   TimeTraceProfilerEntry *Entry = nullptr;
 };
@@ -17,6 +17,7 @@
 #include "llvm/ADT/IntrusiveRefCntPtr.h"
 #include "llvm/ADT/STLFunctionalExtras.h"
 #include "llvm/ADT/SmallVector.h"
+#include "llvm/ADT/StringMap.h"
 #include "llvm/ADT/StringRef.h"
 #include "llvm/Support/Chrono.h"
 #include "llvm/Support/Errc.h"
@@ -29,7 +30,9 @@
 #include <cassert>
 #include <cstdint>
 #include <ctime>
+#include <future>
 #include <memory>
+#include <mutex>
 #include <optional>
 #include <stack>
 #include <string>
@@ -478,6 +481,34 @@ private:
   virtual void anchor() override;
 };
 
+/// A file system that caches the results of status() calls, including
+/// failures, by absolute path. It is thread safe, and concurrent lookups of a
+/// path that is not yet cached share a single call to the underlying file
+/// system. This is meant for tools that stat the same paths many times (e.g.
+/// header searches) while the file system does not change; call invalidate()
+/// or invalidateAll() when it does. Directory iteration and reads are not
+/// cached.
+class CachingFileSystem
+    : public RTTIExtends<CachingFileSystem, ProxyFileSystem> {
+public:
+  static const char ID;
+  explicit CachingFileSystem(IntrusiveRefCntPtr<FileSystem> FS)
+      : RTTIExtends(std::move(FS)) {}
+
+  llvm::ErrorOr<Status> status(const Twine &Path) override;
+  bool exists(const Twine &Path) override;
+
+  /// Drop the cached status of \p Path.
+  void invalidate(const Twine &Path);
+
+  /// Drop all cached results.
+  void invalidateAll();
+
+private:
+  std::mutex CacheMutex;
+  StringMap<std::shared_future<llvm::ErrorOr<Status>>> StatCache;
+};
+
 namespace detail {
 
 class InMemoryDirectory;
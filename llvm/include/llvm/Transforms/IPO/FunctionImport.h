@@ -140,7 +140,8 @@ public:
 ///
 /// \p isPrevailing is a callback that will be called with a global value's GUID
 /// and summary and should return whether the module corresponding to the
-/// summary contains the linker-prevailing copy of that value.
+/// summary contains the linker-prevailing copy of that value. It may be called
+/// from several threads at once, so it must be thread-safe.
 ///
 /// \p ImportLists will be populated with an entry for every Module we are
 /// importing into. This entry is itself a map that can be passed to
@@ -79,6 +79,11 @@ STATISTIC(SearchLimitReached, "Number of times the limit to "
                               "decompose GEPs is reached");
 STATISTIC(SearchTimes, "Number of times a GEP is decomposed");
 
+/// AliasCacheHits / AliasCacheMisses show how often a query is answered from
+/// the per-query-info alias cache, including assumptions made while recursing.
+STATISTIC(AliasCacheHits, "Number of alias checks answered from the cache");
+STATISTIC(AliasCacheMisses, "Number of alias checks not in the cache");
+
 // The max limit of the search depth in DecomposeGEPExpression() and
 // getUnderlyingObject().
 static const unsigned MaxLookupSearchDepth = 6;
@@ -1666,6 +1671,7 @@ AliasResult BasicAAResult::aliasCheck(const Value *V1, LocationSize V1Size,
   const auto &Pair = AAQI.AliasCache.try_emplace(
       Locs, AAQueryInfo::CacheEntry{AliasResult::NoAlias, 0});
   if (!Pair.second) {
+    ++AliasCacheHits;
     auto &Entry = Pair.first->second;
     if (!Entry.isDefinitive()) {
       // Remember that we used an assumption.
@@ -1677,6 +1683,7 @@ AliasResult BasicAAResult::aliasCheck(const Value *V1, LocationSize V1Size,
     Result.swap(Swapped);
     return Result;
   }
+  ++AliasCacheMisses;
 
   int OrigNumAssumptionUses = AAQI.NumAssumptionUses;
   unsigned OrigNumAssumptionBasedResults = AAQI.AssumptionBasedResults.size();
@@ -142,6 +142,15 @@ STATISTIC(NumExitCountsNotComputed,
           "Number of loop exits without predictable exit counts");
 STATISTIC(NumBruteForceTripCountsComputed,
           "Number of loops with trip counts computed by force");
+STATISTIC(NumSCEVCacheHits, "Number of getSCEV queries with a cached SCEV");
+STATISTIC(NumSCEVCacheMisses, "Number of getSCEV queries creating a SCEV");
+STATISTIC(NumBackedgeTakenCacheHits,
+          "Number of backedge-taken count queries answered from the cache");
+STATISTIC(NumBackedgeTakenCacheMisses,
+          "Number of backedge-taken counts computed");
+STATISTIC(MaxUniqueSCEVs, "Maximum number of unique SCEVs in one function");
+STATISTIC(MaxSCEVAllocatorBytes,
+          "Maximum bytes allocated for SCEVs in one function");
 
 #ifdef EXPENSIVE_CHECKS
 bool llvm::VerifySCEV = true;
@@ -4566,8 +4575,11 @@ void ScalarEvolution::insertValueToMap(Value *V, const SCEV *S) {
 const SCEV *ScalarEvolution::getSCEV(Value *V) {
   assert(isSCEVable(V->getType()) && "Value is not SCEVable!");
 
-  if (const SCEV *S = getExistingSCEV(V))
+  if (const SCEV *S = getExistingSCEV(V)) {
+    ++NumSCEVCacheHits;
     return S;
+  }
+  ++NumSCEVCacheMisses;
   return createSCEVIter(V);
 }
 
@@ -8337,8 +8349,11 @@ ScalarEvolution::getBackedgeTakenInfo(const Loop *L) {
   // backedge-taken count, which could result in infinite recursion.
   std::pair<DenseMap<const Loop *, BackedgeTakenInfo>::iterator, bool> Pair =
       BackedgeTakenCounts.insert({L, BackedgeTakenInfo()});
-  if (!Pair.second)
+  if (!Pair.second) {
+    ++NumBackedgeTakenCacheHits;
     return Pair.first->second;
+  }
+  ++NumBackedgeTakenCacheMisses;
 
   // computeBackedgeTakenCount may allocate memory for its result. Inserting it
   // into the BackedgeTakenCounts map transfers ownership. Otherwise, the result
@@ -13452,6 +13467,9 @@ ScalarEvolution::ScalarEvolution(ScalarEvolution &&Arg)
 }
 
 ScalarEvolution::~ScalarEvolution() {
+  MaxUniqueSCEVs.updateMax(UniqueSCEVs.size());
+  MaxSCEVAllocatorBytes.updateMax(SCEVAllocator.getBytesAllocated());
+
   // Iterate through all the SCEVUnknown instances and call their
   // destructors, so that they release their references to their values.
   for (SCEVUnknown *U = FirstUnknown; U;) {
@@ -6918,14 +6918,19 @@ Error BitcodeReader::materialize(GlobalValue *GV) {
       }
     }
 
-    // Remove incompatible attributes on function calls.
+    // Remove incompatible attributes on function calls. Many positions have no
+    // attributes at all, so skip building the masks for those.
     if (auto *CI = dyn_cast<CallBase>(&I)) {
-      CI->removeRetAttrs(AttributeFuncs::typeIncompatible(
-          CI->getFunctionType()->getReturnType()));
+      AttributeList Attrs = CI->getAttributes();
+      if (Attrs.hasRetAttrs())
+        CI->removeRetAttrs(AttributeFuncs::typeIncompatible(
+            CI->getFunctionType()->getReturnType()));
 
       for (unsigned ArgNo = 0; ArgNo < CI->arg_size(); ++ArgNo)
-        CI->removeParamAttrs(ArgNo, AttributeFuncs::typeIncompatible(
-                                        CI->getArgOperand(ArgNo)->getType()));
+        if (Attrs.hasParamAttrs(ArgNo))
+          CI->removeParamAttrs(ArgNo,
+                               AttributeFuncs::typeIncompatible(
+                                   CI->getArgOperand(ArgNo)->getType()));
     }
   }
 
@@ -7289,8 +7294,16 @@ std::vector<FunctionSummary::EdgeTy>
 ModuleSummaryIndexBitcodeReader::makeCallList(ArrayRef<uint64_t> Record,
                                               bool IsOldProfileFormat,
                                               bool HasProfile, bool HasRelBF) {
+  // Each edge is the callee value id followed by its profile fields, if any.
+  // Reserve for the number of edges rather than the record size, as the edge
+  // lists of the combined index are kept for the whole thin link.
+  unsigned FieldsPerEdge = 1;
+  if (IsOldProfileFormat)
+    FieldsPerEdge += HasProfile ? 2 : 1;
+  else if (HasProfile || HasRelBF)
+    FieldsPerEdge += 1;
   std::vector<FunctionSummary::EdgeTy> Ret;
-  Ret.reserve(Record.size());
+  Ret.reserve(Record.size() / FieldsPerEdge);
   for (unsigned I = 0, E = Record.size(); I != E; ++I) {
     CalleeInfo::HotnessType Hotness = CalleeInfo::HotnessType::Unknown;
     bool HasTailCall = false;
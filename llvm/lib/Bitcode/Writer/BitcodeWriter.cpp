@@ -4851,6 +4851,13 @@ void ModuleBitcodeWriter::write() {
   writeSyncScopeNames();
 
   // Emit function bodies.
+  //
+  // FIXME: Function blocks are encoded one after the other. Block bodies are
+  // word aligned, so separately encoded bodies could in principle be spliced
+  // in, but ValueEnumerator only holds a single incorporated function at a
+  // time (function-local constants, metadata and instruction IDs all live in
+  // it), and writeFunction records the block offsets used by the VST and the
+  // summary as it goes.
   DenseMap<const Function *, uint64_t> FunctionToBitcodeIndex;
   for (const Function &F : M)
     if (!F.isDeclaration())
@@ -16,11 +16,67 @@
 #include "llvm/CodeGen/MachineInstr.h"
 #include "llvm/CodeGen/MachineOperand.h"
 #include "llvm/CodeGen/MachineRegisterInfo.h"
+#include "llvm/Support/CommandLine.h"
+#include "llvm/Support/ManagedStatic.h"
+#include "llvm/Support/raw_ostream.h"
+#include <map>
+#include <mutex>
 
 #define DEBUG_TYPE "gi-match-table-executor"
 
 using namespace llvm;
 
+bool GIMatchTableExecutor::ProfileMatchTables = false;
+
+static cl::opt<bool, true> ProfileMatchTablesOpt(
+    "gisel-match-table-profile", cl::Hidden,
+    cl::location(GIMatchTableExecutor::ProfileMatchTables),
+    cl::desc("Count and print how often each GlobalISel match table try-block "
+             "is entered and rejected"));
+
+namespace {
+/// Try-block counts collected by -gisel-match-table-profile. Try-blocks are
+/// identified by their executor and the table index they resume at on
+/// failure, which is also what -debug-only=<executor> prints.
+struct MatchTableProfile {
+  struct Counts {
+    uint64_t Entered = 0;
+    uint64_t Rejected = 0;
+  };
+
+  std::mutex Mutex;
+  std::map<std::pair<StringRef, uint64_t>, Counts> TryBlocks;
+
+  ~MatchTableProfile() {
+    if (TryBlocks.empty())
+      return;
+    std::vector<std::pair<std::pair<StringRef, uint64_t>, Counts>> Sorted(
+        TryBlocks.begin(), TryBlocks.end());
+    llvm::stable_sort(Sorted, [](const auto &LHS, const auto &RHS) {
+      return LHS.second.Rejected > RHS.second.Rejected;
+    });
+    raw_ostream &OS = errs();
+    OS << "GlobalISel match table profile (executor, resume index, entered, "
+          "rejected):\n";
+    for (const auto &[Key, C] : Sorted)
+      OS << "  " << Key.first << " " << Key.second << " " << C.Entered << " "
+         << C.Rejected << "\n";
+  }
+};
+} // namespace
+
+static ManagedStatic<MatchTableProfile> Profile;
+
+void GIMatchTableExecutor::profileTryBlock(StringRef ExecutorName,
+                                           uint64_t ResumeIdx, bool Rejected) {
+  std::lock_guard<std::mutex> Lock(Profile->Mutex);
+  MatchTableProfile::Counts &C = Profile->TryBlocks[{ExecutorName, ResumeIdx}];
+  if (Rejected)
+    ++C.Rejected;
+  else
+    ++C.Entered;
+}
+
 GIMatchTableExecutor::MatcherState::MatcherState(unsigned MaxRenderers)
     : Renderers(MaxRenderers) {}
 
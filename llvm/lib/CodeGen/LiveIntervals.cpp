@@ -194,6 +194,12 @@ bool LiveIntervals::computeVirtRegInterval(LiveInterval &LI) {
 }
 
 void LiveIntervals::computeVirtRegs() {
+  // FIXME: The intervals are independent once the slot indexes exist, but
+  // they are not computed in parallel because all of them share state: LICalc
+  // is a single LiveIntervalCalc with one set of per-block scratch tables,
+  // VNInfos come from the one VNInfoAllocator, splitSeparateComponents creates
+  // new virtual registers in MRI, and computeDeadValues adds dead and undef
+  // flags to instructions that define other registers too.
   for (unsigned i = 0, e = MRI->getNumVirtRegs(); i != e; ++i) {
     Register Reg = Register::index2VirtReg(i);
     if (MRI->reg_nodbg_empty(Reg))
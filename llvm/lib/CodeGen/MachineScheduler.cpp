@@ -152,6 +152,12 @@ static cl::opt<unsigned> SchedOnlyBlock("misched-only-block", cl::Hidden,
 static cl::opt<unsigned> ReadyListLimit("misched-limit", cl::Hidden,
   cl::desc("Limit ready list to N instructions"), cl::init(256));
 
+static cl::opt<unsigned> MaxRegionInstrs(
+    "misched-max-region-instrs", cl::Hidden,
+    cl::desc("Split scheduling regions with more than N instructions; the "
+             "instruction at each split is left in place (0 means no limit)"),
+    cl::init(0));
+
 static cl::opt<bool> EnableRegPressure("misched-regpressure", cl::Hidden,
   cl::desc("Enable register pressure scheduling."), cl::init(true));
 
@@ -571,13 +577,17 @@ getSchedRegions(MachineBasicBlock *MBB,
     }
 
     // The next region starts above the previous region. Look backward in the
-    // instruction stream until we find the nearest boundary.
+    // instruction stream until we find the nearest boundary. Regions that reach
+    // the size limit end early; the next region then treats the instruction
+    // above this one as its boundary.
     unsigned NumRegionInstrs = 0;
     I = RegionEnd;
     for (;I != MBB->begin(); --I) {
       MachineInstr &MI = *std::prev(I);
       if (isSchedBoundary(&MI, &*MBB, MF, TII))
         break;
+      if (MaxRegionInstrs && NumRegionInstrs == MaxRegionInstrs)
+        break;
       if (!MI.isDebugOrPseudoInstr()) {
         // MBB::size() uses instr_iterator to count. Here we need a bundle to
         // count as a single instruction.
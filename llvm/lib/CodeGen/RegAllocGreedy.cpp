@@ -127,6 +127,13 @@ static cl::opt<unsigned long> GrowRegionComplexityBudget(
              "limit its budget and bail out once we reach the limit."),
     cl::init(10000), cl::Hidden);
 
+static cl::opt<unsigned> RegionSplitBudget(
+    "greedy-region-split-budget", cl::Hidden,
+    cl::desc("Limit the number of region splits tried per function, after "
+             "which global live ranges go straight to block splitting "
+             "(0 means no limit)"),
+    cl::init(0));
+
 static cl::opt<bool> GreedyRegClassPriorityTrumpsGlobalness(
     "greedy-regclass-priority-trumps-globalness",
     cl::desc("Change the greedy register allocator's live range priority "
@@ -1823,7 +1830,22 @@ unsigned RAGreedy::trySplit(const LiveInterval &VirtReg, AllocationOrder &Order,
   // First try to split around a region spanning multiple blocks. RS_Split2
   // ranges already made dubious progress with region splitting, so they go
   // straight to single block splitting.
-  if (ExtraInfo->getStage(VirtReg) < RS_Split2) {
+  // Once the region split budget of the function is used up, fall back to
+  // block splitting, which does not search for a region.
+  if (ExtraInfo->getStage(VirtReg) < RS_Split2 &&
+      !(RegionSplitBudget && NumRegionSplitsTried >= RegionSplitBudget)) {
+    if (++NumRegionSplitsTried == RegionSplitBudget) {
+      ORE->emit([&]() {
+        return MachineOptimizationRemarkMissed(DEBUG_TYPE,
+                                               "RegionSplitBudgetExhausted",
+                                               DiagnosticLocation(),
+                                               &MF->front())
+               << "region split budget of "
+               << ore::NV("Budget", RegionSplitBudget.getValue())
+               << " exhausted, using block splitting for the rest of the "
+                  "function";
+      });
+    }
     MCRegister PhysReg = tryRegionSplit(VirtReg, Order, NewVRegs);
     if (PhysReg || !NewVRegs.empty())
       return PhysReg;
@@ -2767,6 +2789,7 @@ bool RAGreedy::runOnMachineFunction(MachineFunction &mf) {
   IntfCache.init(MF, Matrix->getLiveUnions(), Indexes, LIS, TRI);
   GlobalCand.resize(32);  // This will grow as needed.
   SetOfBrokenHints.clear();
+  NumRegionSplitsTried = 0;
 
   allocatePhysRegs();
   tryHintsRecoloring();
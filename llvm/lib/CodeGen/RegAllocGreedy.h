@@ -280,6 +280,10 @@ private:
 
   bool ReverseLocalAssignment = false;
 
+  /// Number of region splits attempted in the current machine function, for
+  /// -greedy-region-split-budget.
+  unsigned NumRegionSplitsTried = 0;
+
 public:
   RAGreedy(const RegClassFilterFunc F = allocateAllRegClasses);
 
@@ -91,6 +91,8 @@ STATISTIC(OpsNarrowed     , "Number of load/op/store narrowed");
 STATISTIC(LdStFP2Int      , "Number of fp load/store pairs transformed to int");
 STATISTIC(SlicedLoads, "Number of load sliced");
 STATISTIC(NumFPLogicOpsConv, "Number of logic ops converted to fp ops");
+STATISTIC(NumVisitLimitReached,
+          "Number of DAG combines stopped by the visit limit");
 
 DEBUG_COUNTER(DAGCombineCounter, "dagcombine",
               "Controls whether a DAG combine is performed for a node");
@@ -130,6 +132,14 @@ static cl::opt<unsigned> TokenFactorInlineLimit(
     "combiner-tokenfactor-inline-limit", cl::Hidden, cl::init(2048),
     cl::desc("Limit the number of operands to inline for Token Factors"));
 
+// Only the combines that run before the DAG is legalized can stop early: the
+// final combine also legalizes the nodes it visits, so every node it would
+// visit has to be visited before instruction selection.
+static cl::opt<unsigned> CombinerVisitLimit(
+    "combiner-visit-limit", cl::Hidden, cl::init(0),
+    cl::desc("Limit the number of nodes visited by each DAG combine that runs "
+             "before legalization is complete (0 means no limit)"));
+
 static cl::opt<unsigned> StoreMergeDependenceLimit(
     "combiner-store-merge-dependence-limit", cl::Hidden, cl::init(10),
     cl::desc("Limit the number of times for the same StoreNode and RootNode "
@@ -1708,8 +1718,18 @@ void DAGCombiner::Run(CombineLevel AtLevel) {
   // changes of the root.
   HandleSDNode Dummy(DAG.getRoot());
 
+  unsigned NumVisited = 0;
+  bool HasVisitLimit = CombinerVisitLimit && !LegalDAG;
+
   // While we have a valid worklist entry node, try to combine it.
   while (SDNode *N = getNextWorklistEntry()) {
+    if (HasVisitLimit && ++NumVisited > CombinerVisitLimit) {
+      LLVM_DEBUG(dbgs() << "\nStopping DAG combine after visiting "
+                        << CombinerVisitLimit << " nodes\n");
+      ++NumVisitLimitReached;
+      break;
+    }
+
     // If N has no uses, it is dead.  Make sure to revisit all N's operands once
     // N is deleted from the DAG, since they too may now be dead or may have a
     // reduced number of uses, allowing other xforms.
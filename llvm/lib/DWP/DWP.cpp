@@ -20,6 +20,7 @@
 #include "llvm/Object/ELFObjectFile.h"
 #include "llvm/Support/CommandLine.h"
 #include "llvm/Support/MemoryBuffer.h"
+#include "llvm/Support/Parallel.h"
 #include <limits>
 
 using namespace llvm;
@@ -638,8 +639,25 @@ Error write(MCStreamer &Out, ArrayRef<std::string> Inputs,
 
   std::deque<SmallString<32>> UncompressedSections;
 
-  for (const auto &Input : Inputs) {
-    auto ErrOrObj = object::ObjectFile::createObjectFile(Input);
+  // Open all inputs up front and concurrently, so that the file system
+  // latency of many small .dwo files overlaps; they are still processed in
+  // order below so the output does not change.
+  std::vector<std::unique_ptr<MemoryBuffer>> Buffers(Inputs.size());
+  std::vector<std::error_code> BufferErrors(Inputs.size());
+  parallelFor(0, Inputs.size(), [&](size_t I) {
+    auto BufOrErr = MemoryBuffer::getFileOrSTDIN(
+        Inputs[I], /*IsText=*/false, /*RequiresNullTerminator=*/false);
+    if (BufOrErr)
+      Buffers[I] = std::move(*BufOrErr);
+    else
+      BufferErrors[I] = BufOrErr.getError();
+  });
+
+  for (const auto &[Input, Buffer, BufferError] :
+       zip_equal(Inputs, Buffers, BufferErrors)) {
+    if (BufferError)
+      return createFileError(Input, errorCodeToError(BufferError));
+    auto ErrOrObj = object::ObjectFile::createObjectFile(*Buffer);
     if (!ErrOrObj) {
       return handleErrors(ErrOrObj.takeError(),
                           [&](std::unique_ptr<ECError> EC) -> Error {
@@ -647,8 +665,8 @@ Error write(MCStreamer &Out, ArrayRef<std::string> Inputs,
                           });
     }
 
-    auto &Obj = *ErrOrObj->getBinary();
-    Objects.push_back(std::move(*ErrOrObj));
+    auto &Obj = **ErrOrObj;
+    Objects.emplace_back(std::move(*ErrOrObj), std::move(Buffer));
 
     UnitIndexEntry CurEntry = {};
 
@@ -50,6 +50,7 @@
 #include "llvm/Support/LEB128.h"
 #include "llvm/Support/FormatVariadic.h"
 #include "llvm/Support/MemoryBuffer.h"
+#include "llvm/Support/Parallel.h"
 #include "llvm/Support/Path.h"
 #include "llvm/Support/raw_ostream.h"
 #include <algorithm>
@@ -2464,6 +2465,21 @@ DWARFContext::create(const StringMap<std::unique_ptr<MemoryBuffer>> &Sections,
       std::move(DObj), "", RecoverableErrorHandler, WarningHandler, ThreadSafe);
 }
 
+void DWARFContext::extractAllUnitDIEsInParallel() {
+  assert(State->isThreadSafe() &&
+         "parallel extraction requires a thread-safe context");
+  SmallVector<DWARFUnit *, 0> Units;
+  for (const auto &U : normal_units())
+    Units.push_back(U.get());
+  for (const auto &U : dwo_units())
+    Units.push_back(U.get());
+  // Extracting the unit DIE resolves the unit's abbreviations, whose cache is
+  // shared between units, and sets up the per-unit section bases.
+  for (DWARFUnit *U : Units)
+    U->getUnitDIE();
+  parallelForEach(Units, [](DWARFUnit *U) { U->getUnitDIE(false); });
+}
+
 uint8_t DWARFContext::getCUAddrSize() {
   // In theory, different compile units may have different address byte
   // sizes, but for simplicity we just use the address byte size of the
@@ -0,0 +1,103 @@
+//===- GsymContext.cpp ----------------------------------------------------===//
+//
+// Part of the LLVM Project, under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+//===----------------------------------------------------------------------===//
+
+#include "llvm/DebugInfo/GSYM/GsymContext.h"
+#include "llvm/DebugInfo/GSYM/LookupResult.h"
+
+using namespace llvm;
+using namespace llvm::gsym;
+using object::SectionedAddress;
+
+// Fill in \p Info from location \p Index of \p LR, honoring \p Specifier.
+static void fillLineInfo(const LookupResult &LR, size_t Index,
+                         DILineInfoSpecifier Specifier, DILineInfo &Info) {
+  const SourceLocation &Loc = LR.Locations[Index];
+  if (Specifier.FNKind != DINameKind::None)
+    Info.FunctionName = Loc.Name.str();
+  switch (Specifier.FLIKind) {
+  case DILineInfoSpecifier::FileLineInfoKind::None:
+    break;
+  case DILineInfoSpecifier::FileLineInfoKind::BaseNameOnly:
+    Info.FileName = Loc.Base.str();
+    break;
+  default:
+    Info.FileName = LR.getSourceFile(Index);
+    break;
+  }
+  Info.Line = Loc.Line;
+  Info.StartAddress = LR.FuncRange.start();
+}
+
+DILineInfo GsymContext::getLineInfoForAddress(SectionedAddress Address,
+                                              DILineInfoSpecifier Specifier) {
+  DILineInfo Result;
+  Expected<LookupResult> LR = Reader.lookup(Address.Address);
+  if (!LR) {
+    consumeError(LR.takeError());
+    return Result;
+  }
+  if (LR->Locations.empty()) {
+    if (Specifier.FNKind != DINameKind::None)
+      Result.FunctionName = LR->FuncName.str();
+    Result.StartAddress = LR->FuncRange.start();
+    return Result;
+  }
+  // The deepest inlined function comes first, as with DWARF.
+  fillLineInfo(*LR, 0, Specifier, Result);
+  return Result;
+}
+
+DILineInfo GsymContext::getLineInfoForDataAddress(SectionedAddress Address) {
+  // GSYM only describes functions.
+  return {};
+}
+
+DILineInfoTable
+GsymContext::getLineInfoForAddressRange(SectionedAddress Address, uint64_t Size,
+                                        DILineInfoSpecifier Specifier) {
+  // Only used by llvm-rtdyld and JIT event listeners, which have no GSYM.
+  return {};
+}
+
+DIInliningInfo
+GsymContext::getInliningInfoForAddress(SectionedAddress Address,
+                                       DILineInfoSpecifier Specifier) {
+  DIInliningInfo Result;
+  Expected<LookupResult> LR = Reader.lookup(Address.Address);
+  if (!LR) {
+    consumeError(LR.takeError());
+    return Result;
+  }
+  if (LR->Locations.empty()) {
+    DILineInfo Info;
+    if (Specifier.FNKind != DINameKind::None)
+      Info.FunctionName = LR->FuncName.str();
+    Info.StartAddress = LR->FuncRange.start();
+    Result.addFrame(Info);
+    return Result;
+  }
+  for (size_t I = 0, E = LR->Locations.size(); I != E; ++I) {
+    DILineInfo Info;
+    fillLineInfo(*LR, I, Specifier, Info);
+    Result.addFrame(Info);
+  }
+  return Result;
+}
+
+std::vector<DILocal>
+GsymContext::getLocalsForAddress(SectionedAddress Address) {
+  // GSYM does not record variables.
+  return {};
+}
+
+Expected<std::unique_ptr<GsymContext>> GsymContext::create(StringRef Path) {
+  Expected<GsymReader> ReaderOrErr = GsymReader::openFile(Path);
+  if (!ReaderOrErr)
+    return ReaderOrErr.takeError();
+  return std::make_unique<GsymContext>(std::move(*ReaderOrErr));
+}
@@ -11,6 +11,7 @@
 #include "llvm/DebugInfo/GSYM/LineTable.h"
 #include "llvm/DebugInfo/GSYM/OutputAggregator.h"
 #include "llvm/MC/StringTableBuilder.h"
+#include "llvm/Support/Parallel.h"
 #include "llvm/Support/raw_ostream.h"
 
 #include <algorithm>
@@ -169,12 +170,53 @@ llvm::Error GsymCreator::encode(FileWriter &O) const {
   const off_t StrtabSize = O.tell() - StrtabOffset;
   std::vector<uint32_t> AddrInfoOffsets;
 
-  // Write out the address infos for each function info.
-  for (const auto &FuncInfo : Funcs) {
-    if (Expected<uint64_t> OffsetOrErr = FuncInfo.encode(O))
-      AddrInfoOffsets.push_back(OffsetOrErr.get());
-    else
-      return OffsetOrErr.takeError();
+  // Write out the address infos for each function info. FunctionInfo
+  // encodings do not depend on where they are placed, so when writing in
+  // native byte order the functions are encoded in parallel, a batch at a
+  // time to bound the memory used by the encoded copies, and then appended
+  // in order.
+  AddrInfoOffsets.reserve(Funcs.size());
+  if (O.getByteOrder() == llvm::endianness::native) {
+    constexpr size_t BatchSize = 1 << 14;
+    std::vector<SmallString<32>> Encoded;
+    for (size_t Begin = 0, E = Funcs.size(); Begin < E; Begin += BatchSize) {
+      const size_t End = std::min(E, Begin + BatchSize);
+      Encoded.assign(End - Begin, {});
+      parallelFor(Begin, End, [&](size_t I) {
+        const FunctionInfo &FuncInfo = Funcs[I];
+        if (!FuncInfo.EncodingCache.empty())
+          return;
+        raw_svector_ostream OS(Encoded[I - Begin]);
+        FileWriter FW(OS, llvm::endianness::native);
+        // Errors are reported when re-encoding serially below.
+        Expected<uint64_t> OffsetOrErr = FuncInfo.encode(FW);
+        if (!OffsetOrErr) {
+          consumeError(OffsetOrErr.takeError());
+          Encoded[I - Begin].clear();
+        }
+      });
+      for (size_t I = Begin; I < End; ++I) {
+        const SmallString<32> &Bytes = Encoded[I - Begin];
+        if (Bytes.empty()) {
+          if (Expected<uint64_t> OffsetOrErr = Funcs[I].encode(O))
+            AddrInfoOffsets.push_back(OffsetOrErr.get());
+          else
+            return OffsetOrErr.takeError();
+          continue;
+        }
+        O.alignTo(4);
+        AddrInfoOffsets.push_back(O.tell());
+        O.writeData(ArrayRef<uint8_t>(
+            reinterpret_cast<const uint8_t *>(Bytes.data()), Bytes.size()));
+      }
+    }
+  } else {
+    for (const auto &FuncInfo : Funcs) {
+      if (Expected<uint64_t> OffsetOrErr = FuncInfo.encode(O))
+        AddrInfoOffsets.push_back(OffsetOrErr.get());
+      else
+        return OffsetOrErr.takeError();
+    }
   }
   // Fixup the string table offset and size in the header
   O.fixup32((uint32_t)StrtabOffset, offsetof(Header, StrtabOffset));
@@ -13,8 +13,10 @@
 #include "llvm/DebugInfo/Symbolize/Symbolize.h"
 
 #include "llvm/ADT/STLExtras.h"
+#include "llvm/ADT/StringExtras.h"
 #include "llvm/DebugInfo/BTF/BTFContext.h"
 #include "llvm/DebugInfo/DWARF/DWARFContext.h"
+#include "llvm/DebugInfo/GSYM/GsymContext.h"
 #include "llvm/DebugInfo/PDB/PDB.h"
 #include "llvm/DebugInfo/PDB/PDBContext.h"
 #include "llvm/DebugInfo/Symbolize/SymbolizableObjectFile.h"
@@ -599,6 +601,34 @@ LLVMSymbolizer::createModuleInfo(const ObjectFile *Obj,
   return InsertResult.first->second.get();
 }
 
+// Look for a prebuilt GSYM index of Obj in Dirs, named after its build ID
+// (<hex build id>.gsym) or after the binary (<file name>.gsym).
+static std::unique_ptr<DIContext>
+lookUpGsymContext(const ObjectFile &Obj, ArrayRef<std::string> Dirs) {
+  if (Dirs.empty())
+    return nullptr;
+  SmallVector<std::string, 2> Names;
+  if (auto *ELFObj = dyn_cast<ELFObjectFileBase>(&Obj)) {
+    object::BuildIDRef BuildID = getBuildID(ELFObj);
+    if (BuildID.size() >= 2)
+      Names.push_back(toHex(BuildID, /*LowerCase=*/true) + ".gsym");
+  }
+  Names.push_back((sys::path::filename(Obj.getFileName()) + ".gsym").str());
+  for (const std::string &Dir : Dirs) {
+    for (const std::string &Name : Names) {
+      SmallString<128> Path(Dir);
+      sys::path::append(Path, Name);
+      if (!sys::fs::exists(Path))
+        continue;
+      auto ContextOrErr = gsym::GsymContext::create(Path);
+      if (ContextOrErr)
+        return std::move(*ContextOrErr);
+      consumeError(ContextOrErr.takeError());
+    }
+  }
+  return nullptr;
+}
+
 Expected<SymbolizableModule *>
 LLVMSymbolizer::getOrCreateModuleInfo(const std::string &ModuleName) {
   std::string BinaryName = ModuleName;
@@ -656,6 +686,8 @@ LLVMSymbolizer::getOrCreateModuleInfo(const std::string &ModuleName) {
       Context.reset(new PDBContext(*CoffObject, std::move(Session)));
     }
   }
+  if (!Context)
+    Context = lookUpGsymContext(*Objects.first, Opts.GsymFileDirectory);
   if (!Context)
     Context = DWARFContext::create(
         *Objects.second, DWARFContext::ProcessDebugRelocations::Process,
@@ -13,13 +13,22 @@
 #include "JITLinkGeneric.h"
 
 #include "llvm/Support/BinaryStreamReader.h"
+#include "llvm/Support/CommandLine.h"
 #include "llvm/Support/MemoryBuffer.h"
+#include "llvm/Support/Parallel.h"
+
+#include <mutex>
 
 #define DEBUG_TYPE "jitlink"
 
 namespace llvm {
 namespace jitlink {
 
+static cl::opt<unsigned> ParallelFixupThreshold(
+    "jitlink-parallel-fixup-threshold", cl::Hidden, cl::init(0),
+    cl::desc("Apply fixups to the blocks of graphs with at least this many "
+             "blocks in parallel (0 = never)"));
+
 JITLinkerBase::~JITLinkerBase() = default;
 
 void JITLinkerBase::linkPhase1(std::unique_ptr<JITLinkerBase> Self) {
@@ -277,6 +286,36 @@ void JITLinkerBase::abandonAllocAndBailOut(std::unique_ptr<JITLinkerBase> Self,
   });
 }
 
+Error applyBlockFixups(ArrayRef<Block *> Blocks,
+                       function_ref<Error(Block &)> Fixup) {
+  if (ParallelFixupThreshold == 0 || Blocks.size() < ParallelFixupThreshold ||
+      DebugFlag) {
+    for (auto *B : Blocks)
+      if (auto Err = Fixup(*B))
+        return Err;
+    return Error::success();
+  }
+
+  // Keep the error from the earliest failing block so that the result does
+  // not depend on scheduling.
+  std::mutex ErrMutex;
+  size_t FirstErrIdx = Blocks.size();
+  Error FirstErr = Error::success();
+  parallelFor(0, Blocks.size(), [&](size_t I) {
+    Error Err = Fixup(*Blocks[I]);
+    if (!Err)
+      return;
+    std::lock_guard<std::mutex> Lock(ErrMutex);
+    if (I < FirstErrIdx) {
+      consumeError(std::move(FirstErr));
+      FirstErr = std::move(Err);
+      FirstErrIdx = I;
+    } else
+      consumeError(std::move(Err));
+  });
+  return FirstErr;
+}
+
 void prune(LinkGraph &G) {
   std::vector<Symbol *> Worklist;
   DenseSet<Block *> VisitedBlocks;
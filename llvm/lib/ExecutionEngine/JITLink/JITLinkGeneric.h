@@ -103,6 +103,13 @@ private:
   std::unique_ptr<InFlightAlloc> Alloc;
 };
 
+/// Calls Fixup on each of Blocks. If the graph has at least
+/// -jitlink-parallel-fixup-threshold blocks the calls are made concurrently,
+/// which requires that Fixup only writes to the content of the block it is
+/// given. Returns the error from the first failing block in Blocks order.
+Error applyBlockFixups(ArrayRef<Block *> Blocks,
+                       function_ref<Error(Block &)> Fixup);
+
 template <typename LinkerImpl> class JITLinker : public JITLinkerBase {
 public:
   using JITLinkerBase::JITLinkerBase;
@@ -132,14 +139,11 @@ private:
   Error fixUpBlocks(LinkGraph &G) const override {
     LLVM_DEBUG(dbgs() << "Fixing up blocks:\n");
 
+    SmallVector<Block *, 0> Blocks;
     for (auto &Sec : G.sections()) {
       bool NoAllocSection = Sec.getMemLifetime() == orc::MemLifetime::NoAlloc;
 
       for (auto *B : Sec.blocks()) {
-        LLVM_DEBUG(dbgs() << "  " << *B << ":\n");
-
-        // Copy Block data and apply fixups.
-        LLVM_DEBUG(dbgs() << "    Applying fixups.\n");
         assert((!B->isZeroFill() || all_of(B->edges(),
                                            [](const Edge &E) {
                                              return E.getKind() ==
@@ -149,32 +153,42 @@ private:
 
         // If this is a no-alloc section then copy the block content into
         // memory allocated on the Graph's allocator (if it hasn't been
-        // already).
+        // already). The allocator is not thread safe, so this is done before
+        // any fixups are applied.
         if (NoAllocSection)
           (void)B->getMutableContent(G);
 
-        for (auto &E : B->edges()) {
+        Blocks.push_back(B);
+      }
+    }
 
-          // Skip non-relocation edges.
-          if (!E.isRelocation())
-            continue;
+    return applyBlockFixups(Blocks, [&](Block &B) -> Error {
+      LLVM_DEBUG(dbgs() << "  " << B << ":\n");
+      LLVM_DEBUG(dbgs() << "    Applying fixups.\n");
 
-          // If B is a block in a Standard or Finalize section then make sure
-          // that no edges point to symbols in NoAlloc sections.
-          assert((NoAllocSection || !E.getTarget().isDefined() ||
-                  E.getTarget().getBlock().getSection().getMemLifetime() !=
-                      orc::MemLifetime::NoAlloc) &&
-                 "Block in allocated section has edge pointing to no-alloc "
-                 "section");
+      [[maybe_unused]] bool NoAllocSection =
+          B.getSection().getMemLifetime() == orc::MemLifetime::NoAlloc;
 
-          // Dispatch to LinkerImpl for fixup.
-          if (auto Err = impl().applyFixup(G, *B, E))
-            return Err;
-        }
-      }
-    }
+      for (auto &E : B.edges()) {
+
+        // Skip non-relocation edges.
+        if (!E.isRelocation())
+          continue;
 
-    return Error::success();
+        // If B is a block in a Standard or Finalize section then make sure
+        // that no edges point to symbols in NoAlloc sections.
+        assert((NoAllocSection || !E.getTarget().isDefined() ||
+                E.getTarget().getBlock().getSection().getMemLifetime() !=
+                    orc::MemLifetime::NoAlloc) &&
+               "Block in allocated section has edge pointing to no-alloc "
+               "section");
+
+        // Dispatch to LinkerImpl for fixup.
+        if (auto Err = impl().applyFixup(G, B, E))
+          return Err;
+      }
+      return Error::success();
+    });
   }
 };
 
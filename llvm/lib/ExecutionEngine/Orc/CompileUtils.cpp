@@ -9,6 +9,7 @@
 #include "llvm/ExecutionEngine/Orc/CompileUtils.h"
 
 #include "llvm/ADT/SmallVector.h"
+#include "llvm/ADT/StringExtras.h"
 #include "llvm/ExecutionEngine/ObjectCache.h"
 #include "llvm/IR/LegacyPassManager.h"
 #include "llvm/IR/Module.h"
@@ -16,8 +17,11 @@
 #include "llvm/Object/ObjectFile.h"
 #include "llvm/Support/Error.h"
 #include "llvm/Support/ErrorHandling.h"
+#include "llvm/Support/FileSystem.h"
 #include "llvm/Support/MemoryBuffer.h"
+#include "llvm/Support/Path.h"
 #include "llvm/Support/SmallVectorMemoryBuffer.h"
+#include "llvm/Support/raw_sha1_ostream.h"
 #include "llvm/Target/TargetMachine.h"
 
 #include <algorithm>
@@ -47,9 +51,11 @@ Expected<SimpleCompiler::CompileResult> SimpleCompiler::operator()(Module &M) {
 
     legacy::PassManager PM;
     MCContext *Ctx;
-    if (TM.addPassesToEmitMC(PM, Ctx, ObjStream))
+    if (TM.addPassesToEmitMC(PM, Ctx, ObjStream)) {
+      notifyObjectCompilationFailed(M);
       return make_error<StringError>("Target does not support MC emission",
                                      inconvertibleErrorCode());
+    }
     PM.run(M);
   }
 
@@ -59,8 +65,10 @@ Expected<SimpleCompiler::CompileResult> SimpleCompiler::operator()(Module &M) {
 
   auto Obj = object::ObjectFile::createObjectFile(ObjBuffer->getMemBufferRef());
 
-  if (!Obj)
+  if (!Obj) {
+    notifyObjectCompilationFailed(M);
     return Obj.takeError();
+  }
 
   notifyObjectCompiled(M, *ObjBuffer);
   return std::move(ObjBuffer);
@@ -80,6 +88,11 @@ void SimpleCompiler::notifyObjectCompiled(const Module &M,
     ObjCache->notifyObjectCompiled(&M, ObjBuffer.getMemBufferRef());
 }
 
+void SimpleCompiler::notifyObjectCompilationFailed(const Module &M) {
+  if (ObjCache)
+    ObjCache->notifyObjectCompilationFailed(&M);
+}
+
 ConcurrentIRCompiler::ConcurrentIRCompiler(JITTargetMachineBuilder JTMB,
                                            ObjectCache *ObjCache)
     : IRCompiler(irManglingOptionsFromTargetOptions(JTMB.getOptions())),
@@ -92,5 +105,73 @@ ConcurrentIRCompiler::operator()(Module &M) {
   return C(M);
 }
 
+std::string
+DirectoryObjectCache::getCacheSalt(const JITTargetMachineBuilder &JTMB) {
+  std::string Salt;
+  raw_string_ostream OS(Salt);
+  OS << JTMB.getTargetTriple().str() << ';' << JTMB.getCPU() << ';'
+     << JTMB.getFeatures().getString() << ';'
+     << static_cast<int>(JTMB.getCodeGenOptLevel()) << ';';
+  if (JTMB.getRelocationModel())
+    OS << static_cast<int>(*JTMB.getRelocationModel());
+  OS << ';';
+  if (JTMB.getCodeModel())
+    OS << static_cast<int>(*JTMB.getCodeModel());
+  return Salt;
+}
+
+std::string DirectoryObjectCache::getCachePath(const Module &M) const {
+  raw_sha1_ostream Hasher;
+  Hasher << Salt << '\0';
+  M.print(Hasher, nullptr);
+
+  SmallString<128> Path(CacheDir);
+  std::string Hash = toHex(Hasher.sha1(), /*LowerCase=*/true);
+  sys::path::append(Path, "llvmjit-" + Hash + ".o");
+  return std::string(Path);
+}
+
+std::unique_ptr<MemoryBuffer>
+DirectoryObjectCache::getObject(const Module *M) {
+  std::string Path = getCachePath(*M);
+  auto Buf = MemoryBuffer::getFile(Path, /*IsText=*/false,
+                                   /*RequiresNullTerminator=*/false);
+  if (Buf)
+    return std::move(*Buf);
+
+  std::lock_guard<std::mutex> Lock(PendingMutex);
+  PendingPaths[M] = std::move(Path);
+  return nullptr;
+}
+
+std::optional<std::string>
+DirectoryObjectCache::takePendingPath(const Module *M) {
+  std::lock_guard<std::mutex> Lock(PendingMutex);
+  auto I = PendingPaths.find(M);
+  if (I == PendingPaths.end())
+    return std::nullopt;
+  std::string Path = std::move(I->second);
+  PendingPaths.erase(I);
+  return Path;
+}
+
+void DirectoryObjectCache::notifyObjectCompiled(const Module *M,
+                                                MemoryBufferRef Obj) {
+  std::optional<std::string> Path = takePendingPath(M);
+  if (!Path)
+    return;
+
+  if (sys::fs::create_directories(CacheDir))
+    return;
+  consumeError(writeToOutput(*Path, [&](raw_ostream &OS) {
+    OS << Obj.getBuffer();
+    return Error::success();
+  }));
+}
+
+void DirectoryObjectCache::notifyObjectCompilationFailed(const Module *M) {
+  takePendingPath(M);
+}
+
 } // end namespace orc
 } // end namespace llvm
@@ -40,8 +40,10 @@ InProcessMemoryMapper::Create() {
 void InProcessMemoryMapper::reserve(size_t NumBytes,
                                     OnReservedFunction OnReserved) {
   std::error_code EC;
-  auto MB = sys::Memory::allocateMappedMemory(
-      NumBytes, nullptr, sys::Memory::MF_READ | sys::Memory::MF_WRITE, EC);
+  unsigned Flags = sys::Memory::MF_READ | sys::Memory::MF_WRITE;
+  if (UseHugePages)
+    Flags |= sys::Memory::MF_HUGE_HINT;
+  auto MB = sys::Memory::allocateMappedMemory(NumBytes, nullptr, Flags, EC);
 
   if (EC)
     return OnReserved(errorCodeToError(EC));
@@ -11,6 +11,7 @@
 #include "llvm/ADT/DenseMap.h"
 #include "llvm/ADT/STLExtras.h"
 #include "llvm/ADT/SmallVector.h"
+#include "llvm/ADT/StringExtras.h"
 #include "llvm/Analysis/BlockFrequencyInfo.h"
 #include "llvm/Analysis/BranchProbabilityInfo.h"
 #include "llvm/Analysis/CFG.h"
@@ -301,5 +302,49 @@ SpeculateQuery::ResultTy SequenceBBQuery::operator()(Function &F) {
   return CallerAndCalles;
 }
 
+// ProfileQuery Implementation
+Expected<ProfileQuery> ProfileQuery::load(StringRef Path) {
+  auto Buf = MemoryBuffer::getFile(Path, /*IsText=*/true);
+  if (!Buf)
+    return createFileError(Path, errorCodeToError(Buf.getError()));
+  return parse(std::move(*Buf));
+}
+
+ProfileQuery ProfileQuery::parse(std::unique_ptr<MemoryBuffer> Profile) {
+  ProfileQuery Q;
+  Q.Data = std::make_shared<ProfileData>();
+  Q.Data->Buffer = std::move(Profile);
+
+  SmallVector<StringRef, 8> Lines, Names;
+  Q.Data->Buffer->getBuffer().split(Lines, '\n', -1, /*KeepEmpty=*/false);
+  for (StringRef Line : Lines) {
+    Line = Line.trim();
+    if (Line.empty() || Line.starts_with("#"))
+      continue;
+    Names.clear();
+    SplitString(Line, Names);
+    auto &Callees = Q.Data->Callees[Names.front()];
+    Callees.append(std::next(Names.begin()), Names.end());
+  }
+  return Q;
+}
+
+SpeculateQuery::ResultTy ProfileQuery::operator()(Function &F) {
+  auto It = Data->Callees.find(F.getName());
+  if (It == Data->Callees.end() || It->second.empty())
+    return std::nullopt;
+
+  DenseSet<StringRef> Calles;
+  for (StringRef Callee : It->second)
+    if (Callee != F.getName())
+      Calles.insert(Callee);
+  if (Calles.empty())
+    return std::nullopt;
+
+  DenseMap<StringRef, DenseSet<StringRef>> CallerAndCalles;
+  CallerAndCalles.insert({F.getName(), std::move(Calles)});
+  return CallerAndCalles;
+}
+
 } // namespace orc
 } // namespace llvm
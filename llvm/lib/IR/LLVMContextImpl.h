@@ -1491,6 +1491,14 @@ public:
 
   DenseMap<const Value *, ValueName *> ValueNames;
 
+  // FIXME: None of the uniquing tables below are synchronized, which is why a
+  // context may only be used by one thread at a time. Sharding them behind
+  // locks would not be enough to share a context between threads: the
+  // uniqued objects are mutated after creation (constant and metadata use
+  // lists, ValueHandle lists and the ValueNames map are updated on every
+  // edit), and constants and metadata nodes are erased and re-uniqued
+  // in place (e.g. ConstantUniqueMap::replaceOperandsInPlace,
+  // MDNode::handleChangedOperand).
   DenseMap<unsigned, std::unique_ptr<ConstantInt>> IntZeroConstants;
   DenseMap<unsigned, std::unique_ptr<ConstantInt>> IntOneConstants;
   DenseMap<APInt, std::unique_ptr<ConstantInt>> IntConstants;
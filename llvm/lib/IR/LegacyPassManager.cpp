@@ -1483,6 +1483,12 @@ bool FPPassManager::runOnFunction(Function &F) {
 bool FPPassManager::runOnModule(Module &M) {
   bool Changed = false;
 
+  // FIXME: For codegen pipelines, functions could only be run concurrently if
+  // the passes were independent of each other across functions, which they are
+  // not: the AsmPrinter streams each function into the one MCStreamer and
+  // MCContext of the module (symbols, sections, constant pools and debug line
+  // tables are all shared), and ISel and the passes before it still create
+  // constants and declarations in the shared LLVMContext and Module.
   for (Function &F : M)
     Changed |= runOnFunction(F);
 
@@ -110,6 +110,12 @@ PreservedAnalyses ModuleToFunctionPassAdaptor::run(Module &M,
   PassInstrumentation PI = AM.getResult<PassInstrumentationAnalysis>(M);
 
   PreservedAnalyses PA = PreservedAnalyses::all();
+  // FIXME: Functions could be run concurrently only once function passes can
+  // be trusted not to touch module state. Today they freely create constants,
+  // types and metadata in the shared LLVMContext, add uses to globals, and
+  // insert declarations into the module, none of which is synchronized. The
+  // FunctionAnalysisManager is also shared, and analyses such as
+  // OuterAnalysisManagerProxy results are keyed on the module.
   for (Function &F : M) {
     if (F.isDeclaration())
       continue;
@@ -7076,6 +7076,14 @@ bool llvm::verifyModule(const Module &M, raw_ostream *OS,
   // Don't use a raw_null_ostream.  Printing IR is expensive.
   Verifier V(OS, /*ShouldTreatBrokenDebugInfoAsError=*/!BrokenDebugInfo, M);
 
+  // FIXME: Function bodies are verified serially even though they are mostly
+  // independent. Verifying them concurrently with one Verifier per thread
+  // would first require merging the state that crosses function boundaries
+  // (FrameEscapeInfo, CUVisited and the DISubprogram-to-Function attachment
+  // map, whose conflicts are diagnosed while visiting the second function) and
+  // making sure nothing reached from the visitors mutates the LLVMContext.
+  // Today that is not the case: StructType::isSized caches its result in the
+  // type, and IR printing for diagnostics builds slot tables.
   bool Broken = false;
   for (const Function &F : M)
     Broken |= !V.verify(F);
@@ -518,6 +518,14 @@ Error lto::backend(const Config &C, AddStreamFn AddStream,
   std::unique_ptr<TargetMachine> TM = createTargetMachine(C, *TOrErr, Mod);
 
   LLVM_DEBUG(dbgs() << "Running regular LTO\n");
+  // FIXME: Only codegen is parallelized. Running the function simplification
+  // part of the pipeline on SplitModule partitions, as splitCodeGen does for
+  // codegen, would need buildLTODefaultPipeline to be split at the point where
+  // the module-level IPO passes end, which it is not: inlining and the
+  // function passes are interleaved in a single CGSCC walk. The partitions
+  // would also have to be joined again before the late IPO passes (GlobalDCE,
+  // LowerTypeTests, CFI), which means a bitcode round trip per partition in
+  // each direction, since partitions live in separate LLVMContexts.
   if (!C.CodeGenOnly) {
     if (!opt(C, TM.get(), 0, Mod, /*IsThinLTO=*/false,
              /*ExportSummary=*/&CombinedIndex, /*ImportSummary=*/nullptr,
@@ -841,6 +841,14 @@ void MCAssembler::layout(MCAsmLayout &Layout) {
   }
 
   // Layout until everything fits.
+  //
+  // FIXME: With RelaxAll (-mc-relax-all, used for -O0 and by some JITs) every
+  // instruction is emitted pre-relaxed into data fragments, so the first
+  // iteration already converges, but it still visits every fragment. Writing
+  // straight into a contiguous section buffer would additionally need the
+  // remaining variable-size fragments (alignment, .org, LEB128, DWARF line and
+  // CFA advances) to be resolved without a layout, as well as symbol offsets
+  // that are currently fragment-relative.
   while (layoutOnce(Layout)) {
     if (getContext().hadError())
       return;
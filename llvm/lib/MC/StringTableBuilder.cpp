@@ -14,6 +14,7 @@
 #include "llvm/BinaryFormat/COFF.h"
 #include "llvm/Support/Endian.h"
 #include "llvm/Support/MathExtras.h"
+#include "llvm/Support/Parallel.h"
 #include "llvm/Support/raw_ostream.h"
 #include <cassert>
 #include <cstddef>
@@ -91,9 +92,15 @@ static int charTailAt(StringPair *P, size_t Pos) {
   return (unsigned char)S[S.size() - Pos - 1];
 }
 
+// Partitions with at least this many strings are sorted on their own task.
+static constexpr size_t MinParallelSortSize = 1 << 15;
+
 // Three-way radix quicksort. This is much faster than std::sort with strcmp
-// because it does not compare characters that we already know the same.
-static void multikeySort(MutableArrayRef<StringPair *> Vec, int Pos) {
+// because it does not compare characters that we already know the same. If
+// TG is set, large partitions are sorted concurrently on it; partitions are
+// disjoint, so the result is the same as a serial sort.
+static void multikeySort(MutableArrayRef<StringPair *> Vec, int Pos,
+                         parallel::TaskGroup *TG) {
 tailcall:
   if (Vec.size() <= 1)
     return;
@@ -114,8 +121,14 @@ tailcall:
       K++;
   }
 
-  multikeySort(Vec.slice(0, I), Pos);
-  multikeySort(Vec.slice(J), Pos);
+  auto SortPartition = [=](MutableArrayRef<StringPair *> Part) {
+    if (TG && Part.size() >= MinParallelSortSize)
+      TG->spawn([=] { multikeySort(Part, Pos, TG); });
+    else
+      multikeySort(Part, Pos, TG);
+  };
+  SortPartition(Vec.slice(0, I));
+  SortPartition(Vec.slice(J));
 
   // multikeySort(Vec.slice(I, J - I), Pos + 1), but with
   // tail call optimization.
@@ -144,7 +157,12 @@ void StringTableBuilder::finalizeStringTable(bool Optimize) {
     for (StringPair &P : StringIndexMap)
       Strings.push_back(&P);
 
-    multikeySort(Strings, 0);
+    if (Strings.size() >= MinParallelSortSize) {
+      parallel::TaskGroup TG;
+      multikeySort(Strings, 0, &TG);
+    } else {
+      multikeySort(Strings, 0, /*TG=*/nullptr);
+    }
     initSize();
 
     StringRef Previous;
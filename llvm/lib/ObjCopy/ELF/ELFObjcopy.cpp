@@ -31,6 +31,7 @@
 #include "llvm/Support/ErrorOr.h"
 #include "llvm/Support/FileSystem.h"
 #include "llvm/Support/Memory.h"
+#include "llvm/Support/Parallel.h"
 #include "llvm/Support/Path.h"
 #include "llvm/Support/raw_ostream.h"
 #include <algorithm>
@@ -39,6 +40,7 @@
 #include <functional>
 #include <iterator>
 #include <memory>
+#include <optional>
 #include <string>
 #include <system_error>
 #include <utility>
@@ -220,6 +222,7 @@ Error Object::compressOrDecompressSections(const CommonConfig &Config) {
   // because it would mutate the sections array.
   SmallVector<std::pair<SectionBase *, std::function<SectionBase *()>>, 0>
       ToReplace;
+  SmallVector<std::pair<SectionBase *, DebugCompressionType>, 0> ToCompress;
   for (SectionBase &Sec : sections()) {
     std::optional<DebugCompressionType> CType;
     for (auto &[Matcher, T] : Config.compressSections)
@@ -247,16 +250,26 @@ Error Object::compressOrDecompressSections(const CommonConfig &Config) {
         ToReplace.emplace_back(
             &Sec, [=] { return &addSection<DecompressedSection>(*CS); });
     } else if (*CType != DebugCompressionType::None) {
-      ToReplace.emplace_back(&Sec, [=, S = &Sec] {
-        return &addSection<CompressedSection>(
-            CompressedSection(*S, *CType, Is64Bits));
-      });
+      ToCompress.emplace_back(&Sec, *CType);
     }
   }
 
+  // Compressing the debug sections of a large binary dominates the run time.
+  // The sections are compressed independently of each other, so do that in
+  // parallel and add the compressed sections afterwards.
+  SmallVector<std::optional<CompressedSection>, 0> Compressed(
+      ToCompress.size());
+  parallelFor(0, ToCompress.size(), [&](size_t I) {
+    Compressed[I].emplace(*ToCompress[I].first, ToCompress[I].second,
+                          Is64Bits);
+  });
+
   DenseMap<SectionBase *, SectionBase *> FromTo;
   for (auto [S, Func] : ToReplace)
     FromTo[S] = Func();
+  for (auto [I, Entry] : enumerate(ToCompress))
+    FromTo[Entry.first] =
+        &addSection<CompressedSection>(std::move(*Compressed[I]));
   return replaceSections(FromTo);
 }
 
@@ -12,6 +12,7 @@
 
 #include "llvm/Object/ArchiveWriter.h"
 #include "llvm/ADT/ArrayRef.h"
+#include "llvm/ADT/STLExtras.h"
 #include "llvm/ADT/StringMap.h"
 #include "llvm/ADT/StringRef.h"
 #include "llvm/BinaryFormat/Magic.h"
@@ -31,12 +32,14 @@
 #include "llvm/Support/ErrorHandling.h"
 #include "llvm/Support/Format.h"
 #include "llvm/Support/MathExtras.h"
+#include "llvm/Support/Parallel.h"
 #include "llvm/Support/Path.h"
 #include "llvm/Support/SmallVectorMemoryBuffer.h"
 #include "llvm/Support/raw_ostream.h"
 
 #include <cerrno>
 #include <map>
+#include <optional>
 
 #if !defined(_MSC_VER) && !defined(__MINGW32__)
 #include <unistd.h>
@@ -818,12 +821,32 @@ computeMemberData(raw_ostream &StringTable, raw_ostream &SymNames,
   std::vector<std::unique_ptr<SymbolicFile>> SymFiles;
 
   if (NeedSymbols != SymtabWritingMode::NoSymtab || isAIXBigArchive(Kind)) {
-    for (const NewArchiveMember &M : NewMembers) {
-      Expected<std::unique_ptr<SymbolicFile>> SymFileOrErr =
-          getSymbolicFile(M.Buf->getMemBufferRef(), Context);
+    // Reading the members dominates the time to write an archive of many
+    // objects. Members other than bitcode files are independent of each
+    // other and are read in parallel. Bitcode files share the LLVMContext and
+    // are read below, in member order.
+    std::vector<std::optional<Expected<std::unique_ptr<SymbolicFile>>>>
+        SymFilesOrErr(NewMembers.size());
+    parallelFor(0, NewMembers.size(), [&](size_t I) {
+      MemoryBufferRef Buf = NewMembers[I].Buf->getMemBufferRef();
+      if (identify_magic(Buf.getBuffer()) != file_magic::bitcode)
+        SymFilesOrErr[I].emplace(getSymbolicFile(Buf, Context));
+    });
+
+    for (auto [I, M] : enumerate(NewMembers)) {
+      std::optional<Expected<std::unique_ptr<SymbolicFile>>> &SymFileOrErr =
+          SymFilesOrErr[I];
       if (!SymFileOrErr)
-        return createFileError(M.MemberName, SymFileOrErr.takeError());
-      SymFiles.push_back(std::move(*SymFileOrErr));
+        SymFileOrErr.emplace(
+            getSymbolicFile(M.Buf->getMemBufferRef(), Context));
+      if (!*SymFileOrErr) {
+        // Only the first error is reported, drop the others.
+        for (auto &Rest : drop_begin(SymFilesOrErr, I + 1))
+          if (Rest)
+            consumeError(Rest->takeError());
+        return createFileError(M.MemberName, SymFileOrErr->takeError());
+      }
+      SymFiles.push_back(std::move(**SymFileOrErr));
     }
   }
 
@@ -27,6 +27,7 @@
 #include "llvm/Support/Error.h"
 #include "llvm/Support/ErrorHandling.h"
 #include "llvm/Support/MemoryBuffer.h"
+#include "llvm/Support/Parallel.h"
 #include "llvm/Support/VirtualFileSystem.h"
 #include "llvm/Support/raw_ostream.h"
 #include <algorithm>
@@ -787,49 +788,58 @@ public:
 
 } // namespace
 
-Error CoverageMapping::loadFunctionRecord(
-    const CoverageMappingRecord &Record,
-    IndexedInstrProfReader &ProfileReader) {
-  StringRef OrigFuncName = Record.FunctionName;
-  if (OrigFuncName.empty())
+Expected<bool> CoverageMapping::loadFunctionProfile(
+    const CoverageMappingRecord &Record, IndexedInstrProfReader &ProfileReader,
+    std::vector<uint64_t> &Counts, BitVector &Bitmap) {
+  if (Record.FunctionName.empty())
     return make_error<CoverageMapError>(coveragemap_error::malformed,
                                         "record function name is empty");
 
-  if (Record.Filenames.empty())
-    OrigFuncName = getFuncNameWithoutPrefix(OrigFuncName);
-  else
-    OrigFuncName = getFuncNameWithoutPrefix(OrigFuncName, Record.Filenames[0]);
-
   CounterMappingContext Ctx(Record.Expressions);
 
-  std::vector<uint64_t> Counts;
   if (Error E = ProfileReader.getFunctionCounts(Record.FunctionName,
                                                 Record.FunctionHash, Counts)) {
     instrprof_error IPE = std::get<0>(InstrProfError::take(std::move(E)));
     if (IPE == instrprof_error::hash_mismatch) {
       FuncHashMismatches.emplace_back(std::string(Record.FunctionName),
                                       Record.FunctionHash);
-      return Error::success();
+      return false;
     }
     if (IPE != instrprof_error::unknown_function)
       return make_error<InstrProfError>(IPE);
     Counts.assign(getMaxCounterID(Ctx, Record) + 1, 0);
   }
-  Ctx.setCounts(Counts);
 
-  BitVector Bitmap;
   if (Error E = ProfileReader.getFunctionBitmap(Record.FunctionName,
                                                 Record.FunctionHash, Bitmap)) {
     instrprof_error IPE = std::get<0>(InstrProfError::take(std::move(E)));
     if (IPE == instrprof_error::hash_mismatch) {
       FuncHashMismatches.emplace_back(std::string(Record.FunctionName),
                                       Record.FunctionHash);
-      return Error::success();
+      return false;
     }
     if (IPE != instrprof_error::unknown_function)
       return make_error<InstrProfError>(IPE);
     Bitmap = BitVector(getMaxBitmapSize(Ctx, Record));
   }
+  return true;
+}
+
+/// Build the function record for \p Record from its profile data. This does
+/// not touch any shared state, so records can be built concurrently. Returns
+/// std::nullopt if the record should be ignored.
+static std::optional<FunctionRecord>
+buildFunctionRecord(const CoverageMappingRecord &Record,
+                    ArrayRef<uint64_t> Counts, BitVector Bitmap,
+                    bool HasSingleByteCoverage) {
+  StringRef OrigFuncName = Record.FunctionName;
+  if (Record.Filenames.empty())
+    OrigFuncName = getFuncNameWithoutPrefix(OrigFuncName);
+  else
+    OrigFuncName = getFuncNameWithoutPrefix(OrigFuncName, Record.Filenames[0]);
+
+  CounterMappingContext Ctx(Record.Expressions);
+  Ctx.setCounts(Counts);
   Ctx.setBitmap(std::move(Bitmap));
 
   assert(!Record.MappingRegions.empty() && "Function has no regions");
@@ -841,7 +851,7 @@ Error CoverageMapping::loadFunctionRecord(
   // when they have non-zero counts in the profile).
   if (Record.MappingRegions.size() == 1 &&
       Record.MappingRegions[0].Count.isZero() && Counts[0] > 0)
-    return Error::success();
+    return std::nullopt;
 
   MCDCDecisionRecorder MCDCDecisions;
   FunctionRecord Function(OrigFuncName, Record.Filenames);
@@ -855,15 +865,15 @@ Error CoverageMapping::loadFunctionRecord(
     Expected<int64_t> ExecutionCount = Ctx.evaluate(Region.Count);
     if (auto E = ExecutionCount.takeError()) {
       consumeError(std::move(E));
-      return Error::success();
+      return std::nullopt;
     }
     Expected<int64_t> AltExecutionCount = Ctx.evaluate(Region.FalseCount);
     if (auto E = AltExecutionCount.takeError()) {
       consumeError(std::move(E));
-      return Error::success();
+      return std::nullopt;
     }
     Function.pushRegion(Region, *ExecutionCount, *AltExecutionCount,
-                        ProfileReader.hasSingleByteCoverage());
+                        HasSingleByteCoverage);
 
     // Record ExpansionRegion.
     if (Region.Kind == CounterMappingRegion::ExpansionRegion) {
@@ -889,18 +899,21 @@ Error CoverageMapping::loadFunctionRecord(
         Ctx.evaluateMCDCRegion(*MCDCDecision, MCDCBranches);
     if (auto E = Record.takeError()) {
       consumeError(std::move(E));
-      return Error::success();
+      return std::nullopt;
     }
 
     // Save the MC/DC Record so that it can be visualized later.
     Function.pushMCDCRecord(std::move(*Record));
   }
+  return Function;
+}
 
+void CoverageMapping::addFunctionRecord(FunctionRecord &&Function) {
   // Don't create records for (filenames, function) pairs we've already seen.
-  auto FilenamesHash = hash_combine_range(Record.Filenames.begin(),
-                                          Record.Filenames.end());
-  if (!RecordProvenance[FilenamesHash].insert(hash_value(OrigFuncName)).second)
-    return Error::success();
+  auto FilenamesHash = hash_combine_range(Function.Filenames.begin(),
+                                          Function.Filenames.end());
+  if (!RecordProvenance[FilenamesHash].insert(hash_value(Function.Name)).second)
+    return;
 
   Functions.push_back(std::move(Function));
 
@@ -908,7 +921,7 @@ Error CoverageMapping::loadFunctionRecord(
   // which correspond to each filename. This can be used to substantially speed
   // up queries for coverage info in a file.
   unsigned RecordIndex = Functions.size() - 1;
-  for (StringRef Filename : Record.Filenames) {
+  for (StringRef Filename : Functions.back().Filenames) {
     auto &RecordIndices = FilenameHash2RecordIndices[hash_value(Filename)];
     // Note that there may be duplicates in the filename set for a function
     // record, because of e.g. macro expansions in the function in which both
@@ -916,23 +929,108 @@ Error CoverageMapping::loadFunctionRecord(
     if (RecordIndices.empty() || RecordIndices.back() != RecordIndex)
       RecordIndices.push_back(RecordIndex);
   }
+}
 
+Error CoverageMapping::loadFunctionRecord(
+    const CoverageMappingRecord &Record,
+    IndexedInstrProfReader &ProfileReader) {
+  std::vector<uint64_t> Counts;
+  BitVector Bitmap;
+  Expected<bool> Found =
+      loadFunctionProfile(Record, ProfileReader, Counts, Bitmap);
+  if (!Found)
+    return Found.takeError();
+  if (!*Found)
+    return Error::success();
+
+  if (std::optional<FunctionRecord> Function =
+          buildFunctionRecord(Record, Counts, std::move(Bitmap),
+                              ProfileReader.hasSingleByteCoverage()))
+    addFunctionRecord(std::move(*Function));
   return Error::success();
 }
 
+namespace {
+/// A coverage mapping record whose profile data has been looked up, with its
+/// own copy of the arrays that the coverage reader reuses for the next record.
+struct PendingFunctionRecord {
+  std::string FunctionName;
+  uint64_t FunctionHash;
+  std::vector<StringRef> Filenames;
+  std::vector<CounterExpression> Expressions;
+  std::vector<CounterMappingRegion> MappingRegions;
+  std::vector<uint64_t> Counts;
+  BitVector Bitmap;
+  std::optional<FunctionRecord> Function;
+
+  explicit PendingFunctionRecord(const CoverageMappingRecord &Record)
+      : FunctionName(Record.FunctionName), FunctionHash(Record.FunctionHash),
+        Filenames(Record.Filenames.begin(), Record.Filenames.end()),
+        Expressions(Record.Expressions.begin(), Record.Expressions.end()),
+        MappingRegions(Record.MappingRegions.begin(),
+                       Record.MappingRegions.end()) {}
+
+  CoverageMappingRecord getRecord() const {
+    return {FunctionName, FunctionHash, Filenames, Expressions,
+            MappingRegions};
+  }
+};
+} // namespace
+
 // This function is for memory optimization by shortening the lifetimes
 // of CoverageMappingReader instances.
 Error CoverageMapping::loadFromReaders(
     ArrayRef<std::unique_ptr<CoverageMappingReader>> CoverageReaders,
     IndexedInstrProfReader &ProfileReader, CoverageMapping &Coverage) {
+  if (parallel::strategy.ThreadsRequested == 1) {
+    for (const auto &CoverageReader : CoverageReaders) {
+      for (auto RecordOrErr : *CoverageReader) {
+        if (Error E = RecordOrErr.takeError())
+          return E;
+        const auto &Record = *RecordOrErr;
+        if (Error E = Coverage.loadFunctionRecord(Record, ProfileReader))
+          return E;
+      }
+    }
+    return Error::success();
+  }
+
+  // Decoding the records and looking up their profile data go through reader
+  // state and stay serial. Evaluating the regions of each record is
+  // independent and is done in parallel a batch at a time. The records are
+  // then added in their original order, so the result matches a serial load.
+  constexpr size_t BatchSize = 4096;
+  std::vector<PendingFunctionRecord> Batch;
+  const bool HasSingleByteCoverage = ProfileReader.hasSingleByteCoverage();
+  auto FlushBatch = [&]() {
+    parallelFor(0, Batch.size(), [&](size_t I) {
+      PendingFunctionRecord &Pending = Batch[I];
+      Pending.Function =
+          buildFunctionRecord(Pending.getRecord(), Pending.Counts,
+                              std::move(Pending.Bitmap), HasSingleByteCoverage);
+    });
+    for (PendingFunctionRecord &Pending : Batch)
+      if (Pending.Function)
+        Coverage.addFunctionRecord(std::move(*Pending.Function));
+    Batch.clear();
+  };
+
   for (const auto &CoverageReader : CoverageReaders) {
     for (auto RecordOrErr : *CoverageReader) {
       if (Error E = RecordOrErr.takeError())
         return E;
-      const auto &Record = *RecordOrErr;
-      if (Error E = Coverage.loadFunctionRecord(Record, ProfileReader))
-        return E;
+      PendingFunctionRecord &Pending = Batch.emplace_back(*RecordOrErr);
+      Expected<bool> Found = Coverage.loadFunctionProfile(
+          Pending.getRecord(), ProfileReader, Pending.Counts, Pending.Bitmap);
+      if (!Found)
+        return Found.takeError();
+      if (!*Found)
+        Batch.pop_back();
+      else if (Batch.size() == BatchSize)
+        FlushBatch();
     }
+    // The reader owns the filenames the pending records refer to.
+    FlushBatch();
   }
   return Error::success();
 }
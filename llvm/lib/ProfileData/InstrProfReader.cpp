@@ -69,9 +69,13 @@ static InstrProfKind getProfileKindFromVersion(uint64_t Version) {
 }
 
 static Expected<std::unique_ptr<MemoryBuffer>>
-setupMemoryBuffer(const Twine &Filename, vfs::FileSystem &FS) {
-  auto BufferOrErr = Filename.str() == "-" ? MemoryBuffer::getSTDIN()
-                                           : FS.getBufferForFile(Filename);
+setupMemoryBuffer(const Twine &Filename, vfs::FileSystem &FS,
+                  bool RequiresNullTerminator = true) {
+  auto BufferOrErr =
+      Filename.str() == "-"
+          ? MemoryBuffer::getSTDIN()
+          : FS.getBufferForFile(Filename, /*FileSize=*/-1,
+                                RequiresNullTerminator);
   if (std::error_code EC = BufferOrErr.getError())
     return errorCodeToError(EC);
   return std::move(BufferOrErr.get());
@@ -196,8 +200,12 @@ InstrProfReader::create(std::unique_ptr<MemoryBuffer> Buffer,
 Expected<std::unique_ptr<IndexedInstrProfReader>>
 IndexedInstrProfReader::create(const Twine &Path, vfs::FileSystem &FS,
                                const Twine &RemappingPath) {
-  // Set up the buffer to read.
-  auto BufferOrError = setupMemoryBuffer(Path, FS);
+  // Set up the buffer to read. The indexed format is binary and needs no null
+  // terminator, which lets large profiles always be mapped rather than read:
+  // lookups then only fault in the pages of the hash table buckets and records
+  // they touch, and concurrent compiles share the pages through the page cache.
+  auto BufferOrError =
+      setupMemoryBuffer(Path, FS, /*RequiresNullTerminator=*/false);
   if (Error E = BufferOrError.takeError())
     return std::move(E);
 
@@ -1519,15 +1527,21 @@ IndexedMemProfReader::getMemProfRecord(const uint64_t FuncNameHash) const {
         "memprof record not found for function hash " + Twine(FuncNameHash));
 
   // Setup a callback to convert from frame ids to frame using the on-disk
-  // FrameData hash table.
+  // FrameData hash table. The call stacks of a function share most of their
+  // frames, so remember the frames already looked up for this record rather
+  // than probing and decoding the on-disk table again for each call stack.
   std::optional<memprof::FrameId> LastUnmappedFrameId;
+  DenseMap<memprof::FrameId, memprof::Frame> FrameCache;
   auto IdToFrameCallback = [&](const memprof::FrameId Id) {
+    auto CacheIter = FrameCache.find(Id);
+    if (CacheIter != FrameCache.end())
+      return CacheIter->second;
     auto FrIter = MemProfFrameTable->find(Id);
     if (FrIter == MemProfFrameTable->end()) {
       LastUnmappedFrameId = Id;
       return memprof::Frame(0, 0, 0, false);
     }
-    return *FrIter;
+    return FrameCache.try_emplace(Id, *FrIter).first->second;
   };
 
   // Setup a callback to convert call stack ids to call stacks using the on-disk
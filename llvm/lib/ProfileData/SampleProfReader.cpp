@@ -22,6 +22,7 @@
 #include "llvm/ProfileData/SampleProfReader.h"
 #include "llvm/ADT/DenseMap.h"
 #include "llvm/ADT/STLExtras.h"
+#include "llvm/ADT/ScopeExit.h"
 #include "llvm/ADT/StringRef.h"
 #include "llvm/IR/Module.h"
 #include "llvm/IR/ProfileSummary.h"
@@ -42,6 +43,7 @@
 #include <cstdint>
 #include <limits>
 #include <memory>
+#include <optional>
 #include <system_error>
 #include <vector>
 
@@ -534,11 +536,94 @@ SampleProfileReaderBinary::readContextFromTable(size_t *RetIdx) {
     return EC;
   if (*ContextIdx >= CSNameTable.size())
     return sampleprof_error::truncated_name_table;
+  if (CSNameTableEntries[*ContextIdx])
+    if (std::error_code EC = decodeCSNameTableEntry(*ContextIdx))
+      return EC;
   if (RetIdx)
     *RetIdx = *ContextIdx;
   return CSNameTable[*ContextIdx];
 }
 
+std::error_code SampleProfileReaderBinary::decodeCSNameTableEntry(size_t Idx) {
+  // Decode the entry in place in the CS name table section, then resume
+  // reading from the current position.
+  const uint8_t *SavedData = Data;
+  const uint8_t *SavedEnd = End;
+  auto Restore = make_scope_exit([&]() {
+    Data = SavedData;
+    End = SavedEnd;
+  });
+  Data = CSNameTableEntries[Idx];
+  End = CSNameTableEnd;
+
+  auto ContextSize = readNumber<uint32_t>();
+  if (std::error_code EC = ContextSize.getError())
+    return EC;
+  // Decode into a local vector so that a malformed entry leaves the table
+  // untouched.
+  SampleContextFrameVector Context;
+  Context.reserve(*ContextSize);
+  for (uint32_t J = 0; J < *ContextSize; ++J) {
+    auto FName(readStringFromTable());
+    if (std::error_code EC = FName.getError())
+      return EC;
+    auto LineOffset = readNumber<uint64_t>();
+    if (std::error_code EC = LineOffset.getError())
+      return EC;
+
+    if (!isOffsetLegal(*LineOffset))
+      return sampleprof_error::malformed;
+
+    auto Discriminator = readNumber<uint64_t>();
+    if (std::error_code EC = Discriminator.getError())
+      return EC;
+
+    Context.emplace_back(FName.get(),
+                         LineLocation(LineOffset.get(), Discriminator.get()));
+  }
+  CSNameTable[Idx] = std::move(Context);
+  CSNameTableEntries[Idx] = nullptr;
+  return sampleprof_error::success;
+}
+
+ErrorOr<std::pair<FunctionId, FunctionId>>
+SampleProfileReaderBinary::readCSNameTableEnds(size_t Idx) {
+  if (!CSNameTableEntries[Idx]) {
+    const SampleContextFrameVector &Context = CSNameTable[Idx];
+    if (Context.empty())
+      return sampleprof_error::malformed;
+    return std::make_pair(Context.front().Func, Context.back().Func);
+  }
+
+  const uint8_t *SavedData = Data;
+  const uint8_t *SavedEnd = End;
+  auto Restore = make_scope_exit([&]() {
+    Data = SavedData;
+    End = SavedEnd;
+  });
+  Data = CSNameTableEntries[Idx];
+  End = CSNameTableEnd;
+
+  auto ContextSize = readNumber<uint32_t>();
+  if (std::error_code EC = ContextSize.getError())
+    return EC;
+  if (*ContextSize == 0)
+    return sampleprof_error::malformed;
+  auto Root(readStringFromTable());
+  if (std::error_code EC = Root.getError())
+    return EC;
+  if (*ContextSize == 1)
+    return std::make_pair(*Root, *Root);
+  // Skip the rest of the frames up to the name index of the leaf frame.
+  for (uint64_t J = 0, E = uint64_t(*ContextSize - 1) * 3 - 1; J < E; ++J)
+    if (std::error_code EC = readNumber<uint64_t>().getError())
+      return EC;
+  auto Leaf(readStringFromTable());
+  if (std::error_code EC = Leaf.getError())
+    return EC;
+  return std::make_pair(*Root, *Leaf);
+}
+
 ErrorOr<std::pair<SampleContext, uint64_t>>
 SampleProfileReaderBinary::readSampleContextFromTable() {
   SampleContext Context;
@@ -805,11 +890,30 @@ std::error_code SampleProfileReaderExtBinaryBase::readFuncOffsetTable() {
   // with the previous section has to be done reading before next one is read.
   FuncOffsetTable.clear();
   FuncOffsetList.clear();
+  CSFuncOffsetList.clear();
 
   auto Size = readNumber<uint64_t>();
   if (std::error_code EC = Size.getError())
     return EC;
 
+  // Only record the context indices of a CS profile. readFuncProfiles decodes
+  // a context when it may belong to a function in the module.
+  if (ProfileIsCS) {
+    CSFuncOffsetList.reserve(*Size);
+    for (uint64_t I = 0; I < *Size; ++I) {
+      auto ContextIdx = readNumber<size_t>();
+      if (std::error_code EC = ContextIdx.getError())
+        return EC;
+      if (*ContextIdx >= CSNameTable.size())
+        return sampleprof_error::truncated_name_table;
+      auto Offset = readNumber<uint64_t>();
+      if (std::error_code EC = Offset.getError())
+        return EC;
+      CSFuncOffsetList.emplace_back(*ContextIdx, *Offset);
+    }
+    return sampleprof_error::success;
+  }
+
   bool UseFuncOffsetList = useFuncOffsetList();
   if (UseFuncOffsetList)
     FuncOffsetList.reserve(*Size);
@@ -864,7 +968,6 @@ std::error_code SampleProfileReaderExtBinaryBase::readFuncProfiles() {
     }
 
     if (ProfileIsCS) {
-      assert(useFuncOffsetList());
       DenseSet<uint64_t> FuncGuidsToUse;
       if (useMD5()) {
         for (auto Name : FuncsToUse)
@@ -878,29 +981,44 @@ std::error_code SampleProfileReaderExtBinaryBase::readFuncProfiles() {
       // as if they were walked in preorder of a context trie. While
       // traversing the trie, a link to the highest common ancestor node is
       // kept so that all of its decendants will be loaded.
-      const SampleContext *CommonContext = nullptr;
-      for (const auto &NameOffset : FuncOffsetList) {
-        const auto &FContext = NameOffset.first;
-        FunctionId FName = FContext.getFunction();
+      // Only the root and leaf frames of a context are read to rule it out:
+      // a context that is not in the module and does not start at the root
+      // of the common ancestor cannot be loaded, so it is never decoded.
+      std::optional<SampleContext> CommonContext;
+      FunctionId CommonRoot;
+      for (const auto &[ContextIdx, Offset] : CSFuncOffsetList) {
+        auto Ends = readCSNameTableEnds(ContextIdx);
+        if (std::error_code EC = Ends.getError())
+          return EC;
+        auto [Root, FName] = *Ends;
         StringRef FNameString;
         if (!useMD5())
           FNameString = FName.stringRef();
+        bool InModule =
+            (useMD5() && FuncGuidsToUse.count(FName.getHashCode())) ||
+            (!useMD5() && (FuncsToUse.count(FNameString) ||
+                           (Remapper && Remapper->exist(FNameString))));
+        if (!InModule && (!CommonContext || Root != CommonRoot))
+          continue;
+
+        if (CSNameTableEntries[ContextIdx])
+          if (std::error_code EC = decodeCSNameTableEntry(ContextIdx))
+            return EC;
+        SampleContext FContext(CSNameTable[ContextIdx]);
 
         // For function in the current module, keep its farthest ancestor
         // context. This can be used to load itself and its child and
         // sibling contexts.
-        if ((useMD5() && FuncGuidsToUse.count(FName.getHashCode())) ||
-            (!useMD5() && (FuncsToUse.count(FNameString) ||
-                           (Remapper && Remapper->exist(FNameString))))) {
-          if (!CommonContext || !CommonContext->IsPrefixOf(FContext))
-            CommonContext = &FContext;
+        if (InModule &&
+            (!CommonContext || !CommonContext->IsPrefixOf(FContext))) {
+          CommonContext = FContext;
+          CommonRoot = Root;
         }
 
-        if (CommonContext == &FContext ||
-            (CommonContext && CommonContext->IsPrefixOf(FContext))) {
+        if (CommonContext && CommonContext->IsPrefixOf(FContext)) {
           // Load profile for the current context which originated from
           // the common ancestor.
-          const uint8_t *FuncProfileAddr = Start + NameOffset.second;
+          const uint8_t *FuncProfileAddr = Start + Offset;
           if (std::error_code EC = readFuncProfile(FuncProfileAddr))
             return EC;
         }
@@ -1143,14 +1261,20 @@ SampleProfileReaderExtBinaryBase::readNameTableSec(bool IsMD5,
 // Read in the CS name table section, which basically contains a list of context
 // vectors. Each element of a context vector, aka a frame, refers to the
 // underlying raw function names that are stored in the name table, as well as
-// a callsite identifier that only makes sense for non-leaf frames.
+// a callsite identifier that only makes sense for non-leaf frames. Only the
+// start of each context vector is recorded here; a vector is decoded when it
+// is first referenced, so on-demand loading only pays for the contexts of the
+// functions it loads.
 std::error_code SampleProfileReaderExtBinaryBase::readCSNameTableSec() {
   auto Size = readNumber<size_t>();
   if (std::error_code EC = Size.getError())
     return EC;
 
   CSNameTable.clear();
-  CSNameTable.reserve(*Size);
+  CSNameTable.resize(*Size);
+  CSNameTableEntries.clear();
+  CSNameTableEntries.reserve(*Size);
+  CSNameTableEnd = End;
   if (ProfileIsCS) {
     // Delay MD5 computation of CS context until they are needed. Use 0 to
     // indicate MD5 value is to be calculated as no known string has a MD5
@@ -1160,28 +1284,14 @@ std::error_code SampleProfileReaderExtBinaryBase::readCSNameTableSec() {
     MD5SampleContextStart = MD5SampleContextTable.data();
   }
   for (size_t I = 0; I < *Size; ++I) {
-    CSNameTable.emplace_back(SampleContextFrameVector());
+    CSNameTableEntries.push_back(Data);
     auto ContextSize = readNumber<uint32_t>();
     if (std::error_code EC = ContextSize.getError())
       return EC;
-    for (uint32_t J = 0; J < *ContextSize; ++J) {
-      auto FName(readStringFromTable());
-      if (std::error_code EC = FName.getError())
+    // Skip the name index, line offset and discriminator of each frame.
+    for (uint64_t J = 0, E = uint64_t(*ContextSize) * 3; J < E; ++J)
+      if (std::error_code EC = readNumber<uint64_t>().getError())
         return EC;
-      auto LineOffset = readNumber<uint64_t>();
-      if (std::error_code EC = LineOffset.getError())
-        return EC;
-
-      if (!isOffsetLegal(*LineOffset))
-        return std::error_code();
-
-      auto Discriminator = readNumber<uint64_t>();
-      if (std::error_code EC = Discriminator.getError())
-        return EC;
-
-      CSNameTable.back().emplace_back(
-          FName.get(), LineLocation(LineOffset.get(), Discriminator.get()));
-    }
   }
 
   return sampleprof_error::success;
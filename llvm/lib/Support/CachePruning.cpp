@@ -22,7 +22,7 @@
 
 #define DEBUG_TYPE "cache-pruning"
 
-#include <set>
+#include <algorithm>
 #include <system_error>
 
 using namespace llvm;
@@ -33,8 +33,8 @@ struct FileInfo {
   uint64_t Size;
   std::string Path;
 
-  /// Used to determine which files to prune first. Also used to determine
-  /// set membership, so must take into account all fields.
+  /// Used to determine which files to prune first. Takes into account all
+  /// fields so that the order is deterministic.
   bool operator<(const FileInfo &Other) const {
     return std::tie(Time, Other.Size, Path) <
            std::tie(Other.Time, Size, Other.Path);
@@ -202,8 +202,7 @@ bool llvm::pruneCache(StringRef Path, CachePruningPolicy Policy,
   }
 
   // Keep track of files to delete to get below the size limit.
-  // Order by time of last use so that recently used files are preserved.
-  std::set<FileInfo> FileInfos;
+  std::vector<FileInfo> FileInfos;
   uint64_t TotalSize = 0;
 
   // Walk the entire directory cache, looking for unused files.
@@ -242,22 +241,28 @@ bool llvm::pruneCache(StringRef Path, CachePruningPolicy Policy,
 
     // Leave it here for now, but add it to the list of size-based pruning.
     TotalSize += StatusOrErr->getSize();
-    FileInfos.insert({FileAccessTime, StatusOrErr->getSize(), File->path()});
+    FileInfos.push_back({FileAccessTime, StatusOrErr->getSize(), File->path()});
   }
 
-  auto FileInfo = FileInfos.begin();
+  // Order by time of last use so that recently used files are preserved. A
+  // heap only orders the files that actually get removed, which in a large
+  // cache is a small fraction of the ones a full sort would order.
+  auto IsNewer = [](const FileInfo &A, const FileInfo &B) { return B < A; };
+  std::make_heap(FileInfos.begin(), FileInfos.end(), IsNewer);
   size_t NumFiles = FileInfos.size();
 
   auto RemoveCacheFile = [&]() {
+    std::pop_heap(FileInfos.begin(), FileInfos.end(), IsNewer);
+    const FileInfo &Oldest = FileInfos.back();
     // Remove the file.
-    sys::fs::remove(FileInfo->Path);
+    sys::fs::remove(Oldest.Path);
     // Update size
-    TotalSize -= FileInfo->Size;
+    TotalSize -= Oldest.Size;
     NumFiles--;
-    LLVM_DEBUG(dbgs() << " - Remove " << FileInfo->Path << " (size "
-                      << FileInfo->Size << "), new occupancy is " << TotalSize
+    LLVM_DEBUG(dbgs() << " - Remove " << Oldest.Path << " (size "
+                      << Oldest.Size << "), new occupancy is " << TotalSize
                       << "%\n");
-    ++FileInfo;
+    FileInfos.pop_back();
   };
 
   // files.size() is greater the number of inputs  by one. However, a timestamp
@@ -312,7 +317,7 @@ bool llvm::pruneCache(StringRef Path, CachePruningPolicy Policy,
           << " bytes); consider adjusting --thinlto-cache-policy\n";
 
     // Remove the oldest accessed files first, till we get below the threshold.
-    while (TotalSize > TotalSizeTarget && FileInfo != FileInfos.end())
+    while (TotalSize > TotalSizeTarget && !FileInfos.empty())
       RemoveCacheFile();
   }
   return true;
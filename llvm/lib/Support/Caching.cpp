@@ -9,6 +9,8 @@
 // This file implements the localCache function, which simplifies creating,
 // adding to, and querying a local file system cache. localCache takes care of
 // periodically pruning older files from the cache using a CachePruningPolicy.
+// It also implements sharedCache, which layers a local cache over a store
+// shared between several caches.
 //
 //===----------------------------------------------------------------------===//
 
@@ -17,6 +19,7 @@
 #include "llvm/Support/FileSystem.h"
 #include "llvm/Support/MemoryBuffer.h"
 #include "llvm/Support/Path.h"
+#include "llvm/Support/raw_ostream.h"
 
 #if !defined(_MSC_VER) && !defined(__MINGW32__)
 #include <unistd.h>
@@ -168,3 +171,66 @@ Expected<FileCache> llvm::localCache(const Twine &CacheNameRef,
     };
   };
 }
+
+FileCache llvm::sharedCache(FileCache Local, SharedCacheStore Shared) {
+  return [=](unsigned Task, StringRef Key,
+             const Twine &ModuleName) -> Expected<AddStreamFn> {
+    // Errors and local hits need no help from the shared store.
+    Expected<AddStreamFn> LocalAddStream = Local(Task, Key, ModuleName);
+    if (!LocalAddStream || !*LocalAddStream)
+      return LocalAddStream;
+    AddStreamFn AddStream = std::move(*LocalAddStream);
+
+    // On a shared hit, copy the file into the local cache. Destroying the
+    // local stream commits the file and adds it to the link.
+    if (Shared.Fetch) {
+      if (std::unique_ptr<MemoryBuffer> MB = Shared.Fetch(Key)) {
+        Expected<std::unique_ptr<CachedFileStream>> StreamOrErr =
+            AddStream(Task, ModuleName);
+        if (!StreamOrErr)
+          return StreamOrErr.takeError();
+        *(*StreamOrErr)->OS << MB->getBuffer();
+        return AddStreamFn();
+      }
+    }
+
+    if (!Shared.Store)
+      return AddStream;
+
+    // This file stream buffers the produced file in memory, since the local
+    // stream cannot be read back, and hands it to both caches when done.
+    struct StoreStream : CachedFileStream {
+      std::unique_ptr<SmallVector<char, 0>> Buffer;
+      std::unique_ptr<CachedFileStream> LocalStream;
+      SharedCacheStore Shared;
+      std::string Key;
+
+      StoreStream(std::unique_ptr<SmallVector<char, 0>> Buffer,
+                  std::unique_ptr<CachedFileStream> LocalStream,
+                  SharedCacheStore Shared, std::string Key)
+          : CachedFileStream(std::make_unique<raw_svector_ostream>(*Buffer),
+                             LocalStream->ObjectPathName),
+            Buffer(std::move(Buffer)), LocalStream(std::move(LocalStream)),
+            Shared(std::move(Shared)), Key(std::move(Key)) {}
+
+      ~StoreStream() {
+        OS.reset();
+        StringRef Data(Buffer->data(), Buffer->size());
+        LocalStream->OS->write(Data.data(), Data.size());
+        LocalStream.reset();
+        Shared.Store(Key, MemoryBufferRef(Data, ObjectPathName));
+      }
+    };
+
+    return [=, Key = Key.str()](unsigned Task, const Twine &ModuleName)
+               -> Expected<std::unique_ptr<CachedFileStream>> {
+      Expected<std::unique_ptr<CachedFileStream>> StreamOrErr =
+          AddStream(Task, ModuleName);
+      if (!StreamOrErr)
+        return StreamOrErr.takeError();
+      auto Buffer = std::make_unique<SmallVector<char, 0>>();
+      return std::make_unique<StoreStream>(
+          std::move(Buffer), std::move(*StreamOrErr), Shared, Key);
+    };
+  };
+}
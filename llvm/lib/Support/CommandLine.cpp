@@ -413,6 +413,11 @@ extrahelp::extrahelp(StringRef Help) : morehelp(Help) {
 }
 
 void Option::addArgument() {
+  // FIXME: Every static option is inserted into its subcommands' OptionsMap
+  // at load time, even in tools that never parse a command line. Deferring
+  // this to the first parse would have to cover every reader of OptionsMap,
+  // including getRegisteredOptions() and the duplicate-name check, which
+  // would then fire at parse time instead.
   GlobalParser->addOption(this);
   FullyInitialized = true;
 }
@@ -17,6 +17,7 @@
 #include "llvm/Support/Compiler.h"
 #include "llvm/Support/Error.h"
 #include "llvm/Support/ErrorHandling.h"
+#include "llvm/Support/Parallel.h"
 #if LLVM_ENABLE_ZLIB
 #include <zlib.h>
 #endif
@@ -201,8 +202,61 @@ void zstd::compress(ArrayRef<uint8_t> Input,
     CompressedBuffer.truncate(CompressedSize);
 }
 
+namespace {
+struct ZstdFrame {
+  ArrayRef<uint8_t> Data;
+  size_t Offset;
+  size_t Size;
+};
+} // namespace
+
+// Input made of several zstd frames (e.g. from pzstd, or zstd with
+// --rsyncable) can be decompressed frame by frame in parallel if every frame
+// records its content size. Returns false if Input does not qualify, in which
+// case it is decompressed as a single stream.
+static bool splitZstdFrames(ArrayRef<uint8_t> Input, size_t UncompressedSize,
+                            SmallVectorImpl<ZstdFrame> &Frames) {
+  size_t Offset = 0;
+  while (!Input.empty()) {
+    size_t CompressedSize =
+        ZSTD_findFrameCompressedSize(Input.data(), Input.size());
+    if (ZSTD_isError(CompressedSize))
+      return false;
+    unsigned long long Size =
+        ZSTD_getFrameContentSize(Input.data(), Input.size());
+    if (Size == ZSTD_CONTENTSIZE_UNKNOWN || Size == ZSTD_CONTENTSIZE_ERROR ||
+        Size > UncompressedSize - Offset)
+      return false;
+    Frames.push_back({Input.take_front(CompressedSize), Offset, size_t(Size)});
+    Offset += Size;
+    Input = Input.drop_front(CompressedSize);
+  }
+  return Frames.size() > 1;
+}
+
 Error zstd::decompress(ArrayRef<uint8_t> Input, uint8_t *Output,
                        size_t &UncompressedSize) {
+  SmallVector<ZstdFrame, 0> Frames;
+  if (splitZstdFrames(Input, UncompressedSize, Frames)) {
+    SmallVector<size_t, 0> Results(Frames.size());
+    parallelFor(0, Frames.size(), [&](size_t I) {
+      const ZstdFrame &F = Frames[I];
+      Results[I] = ::ZSTD_decompress(Output + F.Offset, F.Size, F.Data.data(),
+                                     F.Data.size());
+    });
+    // Report the first failing frame so that the error does not depend on
+    // scheduling.
+    UncompressedSize = 0;
+    for (size_t Res : Results) {
+      if (ZSTD_isError(Res))
+        return make_error<StringError>(ZSTD_getErrorName(Res),
+                                       inconvertibleErrorCode());
+      UncompressedSize += Res;
+    }
+    __msan_unpoison(Output, UncompressedSize);
+    return Error::success();
+  }
+
   const size_t Res = ::ZSTD_decompress(
       Output, UncompressedSize, (const uint8_t *)Input.data(), Input.size());
   UncompressedSize = Res;
@@ -24,13 +24,29 @@ using namespace llvm;
 
 template<typename T, std::size_t N>
 static int format_to_buffer(T Value, char (&Buffer)[N]) {
+  // Emit two digits per division, which halves the number of (slow) divides.
+  static constexpr char DigitPairs[] =
+      "0001020304050607080910111213141516171819"
+      "2021222324252627282930313233343536373839"
+      "4041424344454647484950515253545556575859"
+      "6061626364656667686970717273747576777879"
+      "8081828384858687888990919293949596979899";
   char *EndPtr = std::end(Buffer);
   char *CurPtr = EndPtr;
 
-  do {
-    *--CurPtr = '0' + char(Value % 10);
-    Value /= 10;
-  } while (Value);
+  while (Value >= 100) {
+    unsigned Pair = unsigned(Value % 100) * 2;
+    Value /= 100;
+    *--CurPtr = DigitPairs[Pair + 1];
+    *--CurPtr = DigitPairs[Pair];
+  }
+  if (Value >= 10) {
+    unsigned Pair = unsigned(Value) * 2;
+    *--CurPtr = DigitPairs[Pair + 1];
+    *--CurPtr = DigitPairs[Pair];
+  } else {
+    *--CurPtr = '0' + char(Value);
+  }
   return EndPtr - CurPtr;
 }
 
@@ -64,8 +80,12 @@ static void write_unsigned_impl(raw_ostream &S, T N, size_t MinDigits,
     S << '-';
 
   if (Len < MinDigits && Style != IntegerStyle::Number) {
-    for (size_t I = Len; I < MinDigits; ++I)
-      S << '0';
+    static constexpr char Zeros[] = "00000000000000000000000000000000";
+    for (size_t Pad = MinDigits - Len; Pad;) {
+      size_t Chunk = std::min(Pad, sizeof(Zeros) - 1);
+      S.write(Zeros, Chunk);
+      Pad -= Chunk;
+    }
   }
 
   if (Style == IntegerStyle::Number) {
@@ -148,7 +168,7 @@ void llvm::write_hex(raw_ostream &S, uint64_t N, HexPrintStyle Style,
       std::max(static_cast<unsigned>(W), std::max(1u, Nibbles) + PrefixChars);
 
   char NumberBuffer[kMaxWidth];
-  ::memset(NumberBuffer, '0', std::size(NumberBuffer));
+  ::memset(NumberBuffer, '0', NumChars);
   if (Prefix)
     NumberBuffer[1] = 'x';
   char *EndPtr = NumberBuffer + NumChars;
@@ -192,6 +192,12 @@ size_t getThreadCount() {
 // lock if all threads in the default executor are blocked. To prevent the dead
 // lock, only allow the root TaskGroup to run tasks parallelly. In the scenario
 // of nested parallel_for_each(), only the outermost one runs parallelly.
+//
+// FIXME: This leaves nested loops (e.g. lld's per-section work inside a
+// per-file parallelFor) serial on the worker that runs them. Running them in
+// parallel needs an executor whose workers can help with other tasks while
+// they wait in Latch::sync(), such as one with per-worker work-stealing
+// deques; the single shared queue in ThreadPoolExecutor cannot do that.
 TaskGroup::TaskGroup()
 #if LLVM_ENABLE_THREADS
     : Parallel((parallel::strategy.ThreadsRequested != 1) &&
@@ -227,7 +233,10 @@ void TaskGroup::spawn(std::function<void()> F, bool Sequential) {
 void llvm::parallelFor(size_t Begin, size_t End,
                        llvm::function_ref<void(size_t)> Fn) {
 #if LLVM_ENABLE_THREADS
-  if (parallel::strategy.ThreadsRequested != 1) {
+  // A nested TaskGroup runs its tasks inline (see TaskGroup::TaskGroup), so
+  // splitting the range would only add overhead.
+  if (parallel::strategy.ThreadsRequested != 1 &&
+      parallel::threadIndex == UINT_MAX) {
     auto NumItems = End - Begin;
     // Limit the number of tasks to MaxTasksPerGroup to limit job scheduling
     // overhead on large inputs.
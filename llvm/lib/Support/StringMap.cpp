@@ -229,6 +229,21 @@ unsigned StringMapImpl::RehashTable(unsigned BucketNo) {
     return BucketNo;
   }
 
+  return RehashTableTo(NewSize, BucketNo);
+}
+
+void StringMapImpl::reserve(unsigned NumEntries) {
+  unsigned NewSize = getMinBucketToReserveForEntries(NumEntries);
+  if (NewSize <= NumBuckets)
+    return;
+  if (!TheTable) {
+    init(NewSize);
+    return;
+  }
+  RehashTableTo(NewSize, 0);
+}
+
+unsigned StringMapImpl::RehashTableTo(unsigned NewSize, unsigned BucketNo) {
   unsigned NewBucketNo = BucketNo;
   auto **NewTableArray = createTable(NewSize);
   unsigned *NewHashArray = getHashTable(NewTableArray, NewSize);
@@ -99,6 +99,11 @@ std::optional<ThreadPoolStrategy>
 llvm::get_threadpool_strategy(StringRef Num, ThreadPoolStrategy Default) {
   if (Num == "all")
     return llvm::hardware_concurrency();
+  if (Num == "pinned") {
+    ThreadPoolStrategy S = llvm::heavyweight_hardware_concurrency();
+    S.PinThreads = true;
+    return S;
+  }
   if (Num.empty())
     return Default;
   unsigned V;
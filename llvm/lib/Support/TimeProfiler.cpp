@@ -13,12 +13,14 @@
 #include "llvm/Support/TimeProfiler.h"
 #include "llvm/ADT/STLExtras.h"
 #include "llvm/ADT/STLFunctionalExtras.h"
+#include "llvm/ADT/SmallVector.h"
 #include "llvm/ADT/StringMap.h"
 #include "llvm/Support/JSON.h"
 #include "llvm/Support/Path.h"
 #include "llvm/Support/Process.h"
 #include "llvm/Support/Threading.h"
 #include <algorithm>
+#include <atomic>
 #include <cassert>
 #include <chrono>
 #include <memory>
@@ -48,6 +50,9 @@ TimeTraceProfilerInstances &getTimeTraceProfilerInstances() {
   return Instances;
 }
 
+// Per-thread limit on the number of completed entries, 0 for no limit.
+std::atomic<size_t> MaxEntriesPerThread{0};
+
 } // anonymous namespace
 
 // Per Thread instance
@@ -70,11 +75,12 @@ using NameAndCountAndDurationType =
 
 /// Represents an open or completed time section entry to be captured.
 struct llvm::TimeTraceProfilerEntry {
-  const TimePointType Start;
+  TimePointType Start;
   TimePointType End;
-  const std::string Name;
-  const std::string Detail;
-  const bool AsyncEvent = false;
+  std::string Name;
+  std::string Detail;
+  SmallVector<std::pair<std::string, int64_t>, 0> Args;
+  bool AsyncEvent = false;
   TimeTraceProfilerEntry(TimePointType &&S, TimePointType &&E, std::string &&N,
                          std::string &&Dt, bool Ae)
       : Start(std::move(S)), End(std::move(E)), Name(std::move(N)),
@@ -100,7 +106,8 @@ struct llvm::TimeTraceProfiler {
   TimeTraceProfiler(unsigned TimeTraceGranularity = 0, StringRef ProcName = "")
       : BeginningOfTime(system_clock::now()), StartTime(ClockType::now()),
         ProcName(ProcName), Pid(sys::Process::getProcessId()),
-        Tid(llvm::get_threadid()), TimeTraceGranularity(TimeTraceGranularity) {
+        Tid(llvm::get_threadid()), TimeTraceGranularity(TimeTraceGranularity),
+        MaxEntries(MaxEntriesPerThread.load(std::memory_order_relaxed)) {
     llvm::get_thread_name(ThreadName);
   }
 
@@ -127,7 +134,7 @@ struct llvm::TimeTraceProfiler {
 
     // Only include sections longer or equal to TimeTraceGranularity msec.
     if (duration_cast<microseconds>(Duration).count() >= TimeTraceGranularity)
-      Entries.emplace_back(E);
+      addEntry(E);
 
     // Track total time taken by each "name", but only the topmost levels of
     // them; e.g. if there's a template instantiation that instantiates other
@@ -149,6 +156,17 @@ struct llvm::TimeTraceProfiler {
                    });
   }
 
+  // Record a completed entry. Once MaxEntries entries are held, Entries is
+  // used as a ring buffer and the oldest entry is overwritten.
+  void addEntry(const TimeTraceProfilerEntry &E) {
+    if (!MaxEntries || Entries.size() < MaxEntries) {
+      Entries.emplace_back(E);
+      return;
+    }
+    Entries[NextOverwrite] = E;
+    NextOverwrite = (NextOverwrite + 1) % MaxEntries;
+  }
+
   // Write events from this TimeTraceProfilerInstance and
   // ThreadTimeTraceProfilerInstances.
   void write(raw_pwrite_stream &OS) {
@@ -184,8 +202,13 @@ struct llvm::TimeTraceProfiler {
           J.attribute("dur", DurUs);
         }
         J.attribute("name", E.Name);
-        if (!E.Detail.empty()) {
-          J.attributeObject("args", [&] { J.attribute("detail", E.Detail); });
+        if (!E.Detail.empty() || !E.Args.empty()) {
+          J.attributeObject("args", [&] {
+            if (!E.Detail.empty())
+              J.attribute("detail", E.Detail);
+            for (const auto &[Key, Value] : E.Args)
+              J.attribute(Key, Value);
+          });
         }
       });
 
@@ -307,6 +330,11 @@ struct llvm::TimeTraceProfiler {
 
   // Minimum time granularity (in microseconds)
   const unsigned TimeTraceGranularity;
+
+  // Maximum number of entries kept, 0 for no limit, and the slot the next
+  // entry replaces once that limit is reached.
+  const size_t MaxEntries;
+  size_t NextOverwrite = 0;
 };
 
 void llvm::timeTraceProfilerInitialize(unsigned TimeTraceGranularity,
@@ -317,6 +345,10 @@ void llvm::timeTraceProfilerInitialize(unsigned TimeTraceGranularity,
       TimeTraceGranularity, llvm::sys::path::filename(ProcName));
 }
 
+void llvm::timeTraceProfilerSetMaxEntries(size_t MaxEntries) {
+  MaxEntriesPerThread.store(MaxEntries, std::memory_order_relaxed);
+}
+
 // Removes all TimeTraceProfilerInstances.
 // Called from main thread.
 void llvm::timeTraceProfilerCleanup() {
@@ -389,6 +421,12 @@ TimeTraceProfilerEntry *llvm::timeTraceAsyncProfilerBegin(StringRef Name,
   return nullptr;
 }
 
+void llvm::timeTraceProfilerAddArgument(TimeTraceProfilerEntry *E,
+                                        StringRef Key, int64_t Value) {
+  if (E != nullptr)
+    E->Args.emplace_back(Key.str(), Value);
+}
+
 void llvm::timeTraceProfilerEnd() {
   if (TimeTraceProfilerInstance != nullptr)
     TimeTraceProfilerInstance->end();
@@ -36,6 +36,12 @@
 #include <libproc.h>
 #endif
 
+#if defined(__linux__) && __has_include(<linux/perf_event.h>)
+#include <linux/perf_event.h>
+#include <sys/syscall.h>
+#define LLVM_TIMER_USE_PERF_EVENT 1
+#endif
+
 using namespace llvm;
 
 // This ugly hack is brought to you courtesy of constructor/destructor ordering
@@ -65,6 +71,16 @@ struct CreateTrackSpace {
   }
 };
 static ManagedStatic<cl::opt<bool>, CreateTrackSpace> TrackSpace;
+struct CreateTrackInstructions {
+  static void *call() {
+    return new cl::opt<bool>(
+        "track-instructions",
+        cl::desc("Enable -time-passes tracking of retired instructions with "
+                 "hardware performance counters, where not done by default"),
+        cl::Hidden);
+  }
+};
+static ManagedStatic<cl::opt<bool>, CreateTrackInstructions> TrackInstructions;
 struct CreateInfoOutputFilename {
   static void *call() {
     return new cl::opt<std::string, true>(
@@ -89,6 +105,7 @@ ManagedStatic<cl::opt<bool>, CreateSortTimers> SortTimers;
 
 void llvm::initTimerOptions() {
   *TrackSpace;
+  *TrackInstructions;
   *InfoOutputFilename;
   *SortTimers;
 }
@@ -154,6 +171,52 @@ static inline size_t getMemUsage() {
   return sys::Process::GetMallocUsage();
 }
 
+#ifdef LLVM_TIMER_USE_PERF_EVENT
+namespace {
+/// A counter of the user-space instructions retired by the thread that opened
+/// it. It is closed when that thread exits.
+class ThreadInstructionCounter {
+  int FD;
+
+public:
+  ThreadInstructionCounter() {
+    perf_event_attr Attr = {};
+    Attr.type = PERF_TYPE_HARDWARE;
+    Attr.size = sizeof(Attr);
+    Attr.config = PERF_COUNT_HW_INSTRUCTIONS;
+    Attr.exclude_kernel = 1;
+    Attr.exclude_hv = 1;
+    FD = static_cast<int>(syscall(SYS_perf_event_open, &Attr, /*pid=*/0,
+                                  /*cpu=*/-1, /*group_fd=*/-1,
+                                  PERF_FLAG_FD_CLOEXEC));
+  }
+  ThreadInstructionCounter(const ThreadInstructionCounter &) = delete;
+  ThreadInstructionCounter &
+  operator=(const ThreadInstructionCounter &) = delete;
+  ~ThreadInstructionCounter() {
+    if (FD >= 0)
+      ::close(FD);
+  }
+
+  /// Returns the count, or 0 if the counter is not available, e.g. because of
+  /// perf_event_paranoid.
+  uint64_t read() const {
+    uint64_t Count;
+    if (FD < 0 || ::read(FD, &Count, sizeof(Count)) != sizeof(Count))
+      return 0;
+    return Count;
+  }
+};
+} // namespace
+
+// Returns the user-space instructions retired by the calling thread, or 0 if
+// the counter is not available.
+static uint64_t getCurThreadInstructionsRetired() {
+  static thread_local ThreadInstructionCounter Counter;
+  return Counter.read();
+}
+#endif
+
 static uint64_t getCurInstructionsExecuted() {
 #if defined(HAVE_UNISTD_H) && defined(HAVE_PROC_PID_RUSAGE) &&                 \
     defined(RUSAGE_INFO_V4)
@@ -161,6 +224,9 @@ static uint64_t getCurInstructionsExecuted() {
   if (proc_pid_rusage(getpid(), RUSAGE_INFO_V4, (rusage_info_t *)&ru) == 0) {
     return ru.ri_instructions;
   }
+#elif defined(LLVM_TIMER_USE_PERF_EVENT)
+  if (*TrackInstructions)
+    return getCurThreadInstructionsRetired();
 #endif
   return 0;
 }
@@ -601,6 +601,55 @@ directory_iterator OverlayFileSystem::dir_begin(const Twine &Dir,
 
 void ProxyFileSystem::anchor() {}
 
+//===-----------------------------------------------------------------------===/
+// CachingFileSystem implementation
+//===-----------------------------------------------------------------------===/
+
+ErrorOr<Status> CachingFileSystem::status(const Twine &Path) {
+  SmallString<256> Key;
+  Path.toVector(Key);
+  if (makeAbsolute(Key))
+    return ProxyFileSystem::status(Path);
+
+  std::promise<ErrorOr<Status>> Promise;
+  std::shared_future<ErrorOr<Status>> Result;
+  bool Inserted;
+  {
+    std::lock_guard<std::mutex> Lock(CacheMutex);
+    auto [It, New] = StatCache.try_emplace(Key);
+    Inserted = New;
+    if (Inserted)
+      It->second = Promise.get_future().share();
+    Result = It->second;
+  }
+  if (Inserted)
+    Promise.set_value(getUnderlyingFS().status(Key));
+
+  const ErrorOr<Status> &S = Result.get();
+  if (!S)
+    return S.getError();
+  return Status::copyWithNewName(*S, Path);
+}
+
+bool CachingFileSystem::exists(const Twine &Path) {
+  auto S = status(Path);
+  return S && S->exists();
+}
+
+void CachingFileSystem::invalidate(const Twine &Path) {
+  SmallString<256> Key;
+  Path.toVector(Key);
+  if (makeAbsolute(Key))
+    return;
+  std::lock_guard<std::mutex> Lock(CacheMutex);
+  StatCache.erase(Key);
+}
+
+void CachingFileSystem::invalidateAll() {
+  std::lock_guard<std::mutex> Lock(CacheMutex);
+  StatCache.clear();
+}
+
 namespace llvm {
 namespace vfs {
 
@@ -2936,5 +2985,6 @@ recursive_directory_iterator::increment(std::error_code &EC) {
 const char FileSystem::ID = 0;
 const char OverlayFileSystem::ID = 0;
 const char ProxyFileSystem::ID = 0;
+const char CachingFileSystem::ID = 0;
 const char InMemoryFileSystem::ID = 0;
 const char RedirectingFileSystem::ID = 0;
@@ -44,6 +44,19 @@
 
 #include <stdlib.h>
 
+// The inner loop of long hashes is vectorized with the baseline vector ISA of
+// the host. This matches upstream's SSE2 and NEON code paths; wider ISAs would
+// need runtime dispatch.
+#if defined(__SSE2__) || defined(_M_X64) ||                                    \
+    (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define LLVM_XXH_USE_SSE2 1
+#include <emmintrin.h>
+#elif defined(__ARM_NEON) && defined(__BYTE_ORDER__) &&                        \
+    __BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__
+#define LLVM_XXH_USE_NEON 1
+#include <arm_neon.h>
+#endif
+
 using namespace llvm;
 using namespace support;
 
@@ -320,7 +333,7 @@ static uint64_t XXH3_len_129to240_64b(const uint8_t *input, size_t len,
   return XXH3_avalanche(acc);
 }
 
-LLVM_ATTRIBUTE_ALWAYS_INLINE
+LLVM_ATTRIBUTE_ALWAYS_INLINE LLVM_ATTRIBUTE_UNUSED
 static void XXH3_accumulate_512_scalar(uint64_t *acc, const uint8_t *input,
                                        const uint8_t *secret) {
   for (size_t i = 0; i < XXH_ACC_NB; ++i) {
@@ -331,12 +344,52 @@ static void XXH3_accumulate_512_scalar(uint64_t *acc, const uint8_t *input,
   }
 }
 
+// Same as XXH3_accumulate_512_scalar. acc must be 16-byte aligned.
+LLVM_ATTRIBUTE_ALWAYS_INLINE
+static void XXH3_accumulate_512(uint64_t *acc, const uint8_t *input,
+                                const uint8_t *secret) {
+#if defined(LLVM_XXH_USE_SSE2)
+  __m128i *const xacc = reinterpret_cast<__m128i *>(acc);
+  const __m128i *const xinput = reinterpret_cast<const __m128i *>(input);
+  const __m128i *const xsecret = reinterpret_cast<const __m128i *>(secret);
+  for (size_t i = 0; i < XXH_STRIPE_LEN / sizeof(__m128i); ++i) {
+    __m128i const data_vec = _mm_loadu_si128(xinput + i);
+    __m128i const key_vec = _mm_loadu_si128(xsecret + i);
+    __m128i const data_key = _mm_xor_si128(data_vec, key_vec);
+    // Multiply the low and high 32 bits of each 64-bit lane of data_key.
+    __m128i const data_key_lo =
+        _mm_shuffle_epi32(data_key, _MM_SHUFFLE(0, 3, 0, 1));
+    __m128i const product = _mm_mul_epu32(data_key, data_key_lo);
+    // acc[i ^ 1] += data_val, i.e. swap the two 64-bit lanes of data_vec.
+    __m128i const data_swap =
+        _mm_shuffle_epi32(data_vec, _MM_SHUFFLE(1, 0, 3, 2));
+    __m128i const sum = _mm_add_epi64(xacc[i], data_swap);
+    xacc[i] = _mm_add_epi64(product, sum);
+  }
+#elif defined(LLVM_XXH_USE_NEON)
+  for (size_t i = 0; i < XXH_ACC_NB / 2; ++i) {
+    uint64x2_t const acc_vec = vld1q_u64(acc + 2 * i);
+    uint64x2_t const data_vec =
+        vreinterpretq_u64_u8(vld1q_u8(input + 16 * i));
+    uint64x2_t const key_vec =
+        vreinterpretq_u64_u8(vld1q_u8(secret + 16 * i));
+    uint64x2_t const data_key = veorq_u64(data_vec, key_vec);
+    uint64x2_t const data_swap = vextq_u64(data_vec, data_vec, 1);
+    uint64x2_t const sum = vaddq_u64(acc_vec, data_swap);
+    vst1q_u64(acc + 2 * i, vmlal_u32(sum, vmovn_u64(data_key),
+                                     vshrn_n_u64(data_key, 32)));
+  }
+#else
+  XXH3_accumulate_512_scalar(acc, input, secret);
+#endif
+}
+
 LLVM_ATTRIBUTE_ALWAYS_INLINE
-static void XXH3_accumulate_scalar(uint64_t *acc, const uint8_t *input,
-                                   const uint8_t *secret, size_t nbStripes) {
+static void XXH3_accumulate(uint64_t *acc, const uint8_t *input,
+                            const uint8_t *secret, size_t nbStripes) {
   for (size_t n = 0; n < nbStripes; ++n)
-    XXH3_accumulate_512_scalar(acc, input + n * XXH_STRIPE_LEN,
-                               secret + n * XXH_SECRET_CONSUME_RATE);
+    XXH3_accumulate_512(acc, input + n * XXH_STRIPE_LEN,
+                        secret + n * XXH_SECRET_CONSUME_RATE);
 }
 
 static void XXH3_scrambleAcc(uint64_t *acc, const uint8_t *secret) {
@@ -372,21 +425,20 @@ static uint64_t XXH3_hashLong_64b(const uint8_t *input, size_t len,
       PRIME64_4, PRIME32_2, PRIME64_5, PRIME32_1,
   };
   for (size_t n = 0; n < nb_blocks; ++n) {
-    XXH3_accumulate_scalar(acc, input + n * block_len, secret,
-                           nbStripesPerBlock);
+    XXH3_accumulate(acc, input + n * block_len, secret, nbStripesPerBlock);
     XXH3_scrambleAcc(acc, secret + secretSize - XXH_STRIPE_LEN);
   }
 
   /* last partial block */
   const size_t nbStripes = (len - 1 - (block_len * nb_blocks)) / XXH_STRIPE_LEN;
   assert(nbStripes <= secretSize / XXH_SECRET_CONSUME_RATE);
-  XXH3_accumulate_scalar(acc, input + nb_blocks * block_len, secret, nbStripes);
+  XXH3_accumulate(acc, input + nb_blocks * block_len, secret, nbStripes);
 
   /* last stripe */
   constexpr size_t XXH_SECRET_LASTACC_START = 7;
-  XXH3_accumulate_512_scalar(acc, input + len - XXH_STRIPE_LEN,
-                             secret + secretSize - XXH_STRIPE_LEN -
-                                 XXH_SECRET_LASTACC_START);
+  XXH3_accumulate_512(acc, input + len - XXH_STRIPE_LEN,
+                      secret + secretSize - XXH_STRIPE_LEN -
+                          XXH_SECRET_LASTACC_START);
 
   /* converge into final hash */
   constexpr size_t XXH_SECRET_MERGEACCS_START = 11;
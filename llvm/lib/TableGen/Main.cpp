@@ -127,6 +127,13 @@ int llvm::TableGenMain(const char *argv0,
   Records.stopTimer();
 
   // Write output to memory.
+  //
+  // FIXME: An invocation runs a single backend, and a build runs the
+  // invocations for one target's .td files in parallel, each parsing the same
+  // records again. Running several backends in one process over a shared
+  // RecordKeeper would avoid that. They could not simply run concurrently,
+  // though: even lookups go through the RecordKeeper's unsynchronized Init
+  // pools and getAllDerivedDefinitions cache.
   Records.startBackendTimer("Backend overall");
   std::string OutString;
   raw_string_ostream Out(OutString);
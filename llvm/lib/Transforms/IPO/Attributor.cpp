@@ -95,6 +95,15 @@ static cl::opt<unsigned>
                           cl::desc("Maximal number of fixpoint iterations."),
                           cl::init(32));
 
+// Unlike a time limit, an update budget keeps the result deterministic. The
+// budget is only checked between iterations, as stopping in the middle of one
+// would leave dependent attributes that were never revisited.
+static cl::opt<unsigned> MaxFixpointUpdates(
+    "attributor-max-updates", cl::Hidden,
+    cl::desc("Maximal number of abstract attribute updates before the fixpoint "
+             "iteration is stopped early (0 means no limit)."),
+    cl::init(0));
+
 static cl::opt<unsigned>
     MaxSpecializationPerCB("attributor-max-specializations-per-call-base",
                            cl::Hidden,
@@ -2129,6 +2138,11 @@ void Attributor::runTillFixpoint() {
   unsigned MaxIterations =
       Configuration.MaxFixpointIterations.value_or(SetFixpointIterations);
 
+  unsigned NumUpdates = 0;
+  auto IsUpdateBudgetExhausted = [&]() {
+    return MaxFixpointUpdates && NumUpdates >= MaxFixpointUpdates;
+  };
+
   SmallVector<AbstractAttribute *, 32> ChangedAAs;
   SetVector<AbstractAttribute *> Worklist, InvalidAAs;
   Worklist.insert(DG.SyntheticRoot.begin(), DG.SyntheticRoot.end());
@@ -2190,9 +2204,11 @@ void Attributor::runTillFixpoint() {
     // changed.
     for (AbstractAttribute *AA : Worklist) {
       const auto &AAState = AA->getState();
-      if (!AAState.isAtFixpoint())
+      if (!AAState.isAtFixpoint()) {
+        ++NumUpdates;
         if (updateAA(*AA) == ChangeStatus::CHANGED)
           ChangedAAs.push_back(AA);
+      }
 
       // Use the InvalidAAs vector to propagate invalid states fast transitively
       // without requiring updates.
@@ -2213,7 +2229,8 @@ void Attributor::runTillFixpoint() {
                     QueryAAsAwaitingUpdate.end());
     QueryAAsAwaitingUpdate.clear();
 
-  } while (!Worklist.empty() && (IterationCounter++ < MaxIterations));
+  } while (!Worklist.empty() && !IsUpdateBudgetExhausted() &&
+           (IterationCounter++ < MaxIterations));
 
   if (IterationCounter > MaxIterations && !Functions.empty()) {
     auto Remark = [&](OptimizationRemarkMissed ORM) {
@@ -2222,6 +2239,14 @@ void Attributor::runTillFixpoint() {
     };
     Function *F = Functions.front();
     emitRemark<OptimizationRemarkMissed>(F, "FixedPoint", Remark);
+  } else if (!Worklist.empty() && IsUpdateBudgetExhausted() &&
+             !Functions.empty()) {
+    auto Remark = [&](OptimizationRemarkMissed ORM) {
+      return ORM << "Attributor did not reach a fixpoint within "
+                 << ore::NV("Updates", NumUpdates) << " updates.";
+    };
+    Function *F = Functions.front();
+    emitRemark<OptimizationRemarkMissed>(F, "FixedPoint", Remark);
   }
 
   LLVM_DEBUG(dbgs() << "\n[Attributor] Fixpoint iteration done after: "
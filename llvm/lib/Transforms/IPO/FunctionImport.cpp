@@ -38,6 +38,8 @@
 #include "llvm/Support/ErrorHandling.h"
 #include "llvm/Support/FileSystem.h"
 #include "llvm/Support/JSON.h"
+#include "llvm/Support/MathExtras.h"
+#include "llvm/Support/Parallel.h"
 #include "llvm/Support/SourceMgr.h"
 #include "llvm/Support/raw_ostream.h"
 #include "llvm/Transforms/IPO/Internalize.h"
@@ -996,15 +998,52 @@ void llvm::ComputeCrossModuleImport(
         isPrevailing,
     DenseMap<StringRef, FunctionImporter::ImportMapTy> &ImportLists,
     DenseMap<StringRef, FunctionImporter::ExportSetTy> &ExportLists) {
-  auto MIS = ModuleImportsManager::create(isPrevailing, Index, &ExportLists);
+  // Create all import lists up front, so that they can be filled in in
+  // parallel without the map growing underneath.
+  std::vector<std::pair<const std::pair<StringRef, GVSummaryMapTy> *,
+                        FunctionImporter::ImportMapTy *>>
+      Modules;
+  Modules.reserve(ModuleToDefinedGVSummaries.size());
+  for (const auto &DefinedGVSummaries : ModuleToDefinedGVSummaries)
+    ImportLists[DefinedGVSummaries.first];
+  for (const auto &DefinedGVSummaries : ModuleToDefinedGVSummaries)
+    Modules.push_back(
+        {&DefinedGVSummaries, &ImportLists[DefinedGVSummaries.first]});
+
+  // Import computation only reads the index, so modules are split into one
+  // chunk per thread, each of which collects exports in its own map. The maps
+  // are merged below; sets do not depend on insertion order, so the result is
+  // the same as a serial computation. The workload imports manager reads its
+  // definitions when created, and -import-cutoff counts imports across all
+  // modules in order, so both are only used serially.
+  bool RunInParallel = WorkloadDefinitions.empty() && ImportCutoff < 0;
+#ifndef NDEBUG
+  // Keep the debug output of each module in one piece.
+  RunInParallel &= !DebugFlag;
+#endif
+  size_t NumChunks = 1;
+  if (RunInParallel)
+    NumChunks = std::min<size_t>(parallel::strategy.compute_thread_count(),
+                                 Modules.size());
+  size_t ChunkSize = NumChunks ? divideCeil(Modules.size(), NumChunks) : 0;
+  std::vector<DenseMap<StringRef, FunctionImporter::ExportSetTy>> ChunkExports(
+      NumChunks);
   // For each module that has function defined, compute the import/export lists.
-  for (const auto &DefinedGVSummaries : ModuleToDefinedGVSummaries) {
-    auto &ImportList = ImportLists[DefinedGVSummaries.first];
-    LLVM_DEBUG(dbgs() << "Computing import for Module '"
-                      << DefinedGVSummaries.first << "'\n");
-    MIS->computeImportForModule(DefinedGVSummaries.second,
-                                DefinedGVSummaries.first, ImportList);
-  }
+  parallelFor(0, NumChunks, [&](size_t Chunk) {
+    auto MIS =
+        ModuleImportsManager::create(isPrevailing, Index, &ChunkExports[Chunk]);
+    size_t End = std::min(Modules.size(), (Chunk + 1) * ChunkSize);
+    for (size_t I = Chunk * ChunkSize; I < End; ++I) {
+      const auto &DefinedGVSummaries = *Modules[I].first;
+      LLVM_DEBUG(dbgs() << "Computing import for Module '"
+                        << DefinedGVSummaries.first << "'\n");
+      MIS->computeImportForModule(DefinedGVSummaries.second,
+                                  DefinedGVSummaries.first, *Modules[I].second);
+    }
+  });
+  for (auto &Exports : ChunkExports)
+    for (auto &[ModName, ExportSet] : Exports)
+      ExportLists[ModName].insert(ExportSet.begin(), ExportSet.end());
 
   // When computing imports we only added the variables and functions being
   // imported to the export list. We also need to mark any references and calls
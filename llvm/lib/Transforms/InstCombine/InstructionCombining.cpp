@@ -5115,6 +5115,13 @@ public:
 /// them to the worklist (this significantly speeds up instcombine on code where
 /// many instructions are dead or constant).  Additionally, if we find a branch
 /// whose condition is a known constant, we only visit the reachable successors.
+///
+/// FIXME: Every invocation seeds the worklist with the whole function, even
+/// when nothing changed since the previous InstCombine run on it. Seeding only
+/// from modified instructions would need a change record that every pass
+/// between two runs maintains, and IR has no such epoch or dirty set. It would
+/// also lose folds that become possible through changes to analyses (e.g.
+/// new assumptions or dominance) rather than to the instructions themselves.
 bool InstCombinerImpl::prepareWorklist(
     Function &F, ReversePostOrderTraversal<BasicBlock *> &RPOT) {
   bool MadeIRChange = false;
@@ -200,6 +200,12 @@ static cl::opt<unsigned> TinyTripCountVectorThreshold(
              "value are vectorized only if no scalar iteration overheads "
              "are incurred."));
 
+static cl::opt<unsigned> MaxVFCandidates(
+    "vectorizer-max-vf-candidates", cl::init(0), cl::Hidden,
+    cl::desc("Limit the number of fixed and of scalable vector VFs whose cost "
+             "is evaluated to the given number of widest legal VFs (0 means no "
+             "limit), to bound compile time on loops with a wide maximum VF."));
+
 static cl::opt<unsigned> VectorizeMemoryCheckThreshold(
     "vectorize-memory-check-threshold", cl::init(128), cl::Hidden,
     cl::desc("The maximum allowed number of runtime memory checks"));
@@ -7353,14 +7359,26 @@ LoopVectorizationPlanner::plan(ElementCount UserVF, unsigned UserIC) {
                               "InvalidCost", ORE, OrigLoop);
   }
 
-  // Populate the set of Vectorization Factor Candidates.
+  // Populate the set of Vectorization Factor Candidates. The scalar VF is
+  // always a candidate; if the number of vector candidates is limited, only
+  // the widest ones are kept.
   ElementCountSet VFCandidates;
-  for (auto VF = ElementCount::getFixed(1);
-       ElementCount::isKnownLE(VF, MaxFactors.FixedVF); VF *= 2)
-    VFCandidates.insert(VF);
-  for (auto VF = ElementCount::getScalable(1);
-       ElementCount::isKnownLE(VF, MaxFactors.ScalableVF); VF *= 2)
-    VFCandidates.insert(VF);
+  VFCandidates.insert(ElementCount::getFixed(1));
+  // Returns the narrowest vector VF that was added.
+  auto AddVectorVFCandidates = [&](ElementCount MinVF, ElementCount MaxVF) {
+    SmallVector<ElementCount> VFs;
+    for (ElementCount VF = MinVF; ElementCount::isKnownLE(VF, MaxVF); VF *= 2)
+      VFs.push_back(VF);
+    ArrayRef<ElementCount> Selected(VFs);
+    if (MaxVFCandidates && Selected.size() > MaxVFCandidates)
+      Selected = Selected.take_back(MaxVFCandidates);
+    VFCandidates.insert(Selected.begin(), Selected.end());
+    return Selected.empty() ? MinVF : Selected.front();
+  };
+  ElementCount MinFixedVF =
+      AddVectorVFCandidates(ElementCount::getFixed(2), MaxFactors.FixedVF);
+  ElementCount MinScalableVF = AddVectorVFCandidates(
+      ElementCount::getScalable(1), MaxFactors.ScalableVF);
 
   CM.collectInLoopReductions();
   for (const auto &VF : VFCandidates) {
@@ -7373,8 +7391,16 @@ LoopVectorizationPlanner::plan(ElementCount UserVF, unsigned UserIC) {
       CM.collectInstsToScalarize(VF);
   }
 
-  buildVPlansWithVPRecipes(ElementCount::getFixed(1), MaxFactors.FixedVF);
-  buildVPlansWithVPRecipes(ElementCount::getScalable(1), MaxFactors.ScalableVF);
+  // Plans can only be built for the VFs whose uniforms and scalars were
+  // collected above.
+  if (MinFixedVF == ElementCount::getFixed(2)) {
+    buildVPlansWithVPRecipes(ElementCount::getFixed(1), MaxFactors.FixedVF);
+  } else {
+    buildVPlansWithVPRecipes(ElementCount::getFixed(1),
+                             ElementCount::getFixed(1));
+    buildVPlansWithVPRecipes(MinFixedVF, MaxFactors.FixedVF);
+  }
+  buildVPlansWithVPRecipes(MinScalableVF, MaxFactors.ScalableVF);
 
   LLVM_DEBUG(printPlans(dbgs()));
   if (!MaxFactors.hasVector())
@@ -34,6 +34,16 @@ enum class DsymutilDWARFLinkerType : uint8_t {
   Parallel /// Implementation of DWARFLinker heavily using parallel execution.
 };
 
+/// The DWARFLinker used when --linker is not given, selected at configure
+/// time with DSYMUTIL_DEFAULT_LINKER.
+#ifdef DSYMUTIL_DEFAULT_LINKER_PARALLEL
+constexpr DsymutilDWARFLinkerType DefaultDWARFLinkerType =
+    DsymutilDWARFLinkerType::Parallel;
+#else
+constexpr DsymutilDWARFLinkerType DefaultDWARFLinkerType =
+    DsymutilDWARFLinkerType::Classic;
+#endif
+
 struct LinkOptions {
   /// Verbosity
   bool Verbose = false;
@@ -61,7 +71,7 @@ struct LinkOptions {
   bool KeepFunctionForStatic = false;
 
   /// Type of DWARFLinker to use.
-  DsymutilDWARFLinkerType DWARFLinkerType = DsymutilDWARFLinkerType::Classic;
+  DsymutilDWARFLinkerType DWARFLinkerType = DefaultDWARFLinkerType;
 
   /// Use a 64-bit header when emitting universal binaries.
   bool Fat64 = false;
@@ -242,7 +242,7 @@ getDWARFLinkerType(opt::InputArgList &Args) {
                                    inconvertibleErrorCode());
   }
 
-  return DsymutilDWARFLinkerType::Classic;
+  return DefaultDWARFLinkerType;
 }
 
 static Expected<ReproducerMode> getReproducerMode(opt::InputArgList &Args) {
@@ -701,6 +701,12 @@ int dsymutil_main(int argc, char **argv, const llvm::ToolContext &) {
       return EXIT_FAILURE;
     }
 
+    // FIXME: Every invocation relinks all compile units, even when only one
+    // object file in the debug map changed since the existing dSYM was
+    // produced. An incremental mode could reuse the units of unchanged objects
+    // (keyed by object path, timestamp and UUID) from the previous output, but
+    // it needs the linker to splice pre-linked units in, with their string,
+    // line table and accelerator table contributions.
     // Shared a single binary holder for all the link steps.
     BinaryHolder BinHolder(Options.LinkOpts.VFS);
 
@@ -29,6 +29,7 @@
 #include "llvm/Support/FileSystem.h"
 #include "llvm/Support/LLVMDriver.h"
 #include "llvm/Support/MemoryBuffer.h"
+#include "llvm/Support/Parallel.h"
 #include "llvm/Support/TargetSelect.h"
 #include "llvm/Support/ToolOutputFile.h"
 #include <optional>
@@ -159,6 +160,15 @@ int llvm_dwp_main(int argc, char **argv, const llvm::ToolContext &) {
     }
   }
 
+  if (Arg *A = Args.getLastArg(OPT_threads)) {
+    unsigned Threads;
+    if (!to_integer(A->getValue(), Threads) || Threads == 0) {
+      llvm::errs() << "invalid value for -j: " << A->getValue() << '\n';
+      exit(1);
+    }
+    parallel::strategy = hardware_concurrency(Threads);
+  }
+
   for (const llvm::opt::Arg *A : Args.filtered(OPT_execFileNames))
     ExecFilenames.emplace_back(A->getValue());
 
@@ -47,6 +47,10 @@
 #include <algorithm>
 #include <string>
 
+#ifdef __linux__
+#include <sched.h>
+#endif
+
 namespace llvm {
 namespace exegesis {
 
@@ -256,6 +260,12 @@ static cl::opt<BenchmarkRunner::ExecutionModeE> ExecutionMode(
                           "allows for the use of memory annotations")),
     cl::init(BenchmarkRunner::ExecutionModeE::InProcess));
 
+static cl::opt<int> BenchmarkProcessCPU(
+    "benchmark-process-cpu",
+    cl::desc("The CPU number that the benchmarking process should execute on, "
+             "only supported in the subprocess execution mode"),
+    cl::cat(BenchmarkOptions), cl::init(-1));
+
 static cl::opt<unsigned> BenchmarkRepeatCount(
     "benchmark-repeat-count",
     cl::desc("The number of times to repeat measurements on the benchmark k "
@@ -418,8 +428,11 @@ static void runBenchmarkConfigurations(
         std::optional<StringRef> DumpFile;
         if (DumpObjectToDisk.getNumOccurrences())
           DumpFile = DumpObjectToDisk;
+        std::optional<int> BenchmarkCPU;
+        if (BenchmarkProcessCPU != -1)
+          BenchmarkCPU = BenchmarkProcessCPU;
         auto [Err, BenchmarkResult] =
-            Runner.runConfiguration(std::move(RC), DumpFile);
+            Runner.runConfiguration(std::move(RC), DumpFile, BenchmarkCPU);
         if (Err) {
           // Errors from executing the snippets are fine.
           // All other errors are a framework issue and should fail.
@@ -487,6 +500,19 @@ void benchmarkMain() {
     ExitWithError("Dummy perf counters are not supported in the subprocess "
                   "execution mode.");
 
+  if (ExecutionMode != BenchmarkRunner::ExecutionModeE::SubProcess &&
+      BenchmarkProcessCPU != -1)
+    ExitWithError("Pinning the benchmarking process to a CPU is only "
+                  "supported in the subprocess execution mode.");
+
+  if (BenchmarkProcessCPU < -1)
+    ExitWithError("--benchmark-process-cpu must be a CPU number or -1");
+#ifdef __linux__
+  if (BenchmarkProcessCPU >= CPU_SETSIZE)
+    ExitWithError(Twine("--benchmark-process-cpu must be less than ")
+                      .concat(Twine(CPU_SETSIZE)));
+#endif
+
   const std::unique_ptr<BenchmarkRunner> Runner =
       ExitOnErr(State.getExegesisTarget().createBenchmarkRunner(
           BenchmarkMode, State, BenchmarkPhaseSelector, ExecutionMode,
@@ -55,6 +55,7 @@
 #include "llvm/Support/FileSystem.h"
 #include "llvm/Support/InitLLVM.h"
 #include "llvm/Support/MemoryBuffer.h"
+#include "llvm/Support/Parallel.h"
 #include "llvm/Support/SourceMgr.h"
 #include "llvm/Support/TargetSelect.h"
 #include "llvm/Support/ToolOutputFile.h"
@@ -101,6 +102,15 @@ static cl::opt<bool> PrintJson("json",
                                cl::desc("Print the output in json format"),
                                cl::cat(ToolOptions), cl::init(false));
 
+static cl::opt<unsigned>
+    NumThreads("num-threads",
+               cl::desc("Number of threads used to simulate code regions "
+                        "(0 = all hardware threads)"),
+               cl::cat(ToolOptions), cl::init(1));
+
+static cl::alias NumThreadsA("j", cl::desc("Alias for --num-threads"),
+                             cl::aliasopt(NumThreads), cl::cat(ToolOptions));
+
 static cl::opt<int>
     OutputAsmVariant("output-asm-variant",
                      cl::desc("Syntax variant to use for output printing"),
@@ -302,16 +312,21 @@ static void processViewOptions(bool IsOutOfOrder) {
     processOptionImpl(PrintRetireStats, Default);
 }
 
-// Returns true on success.
-static bool runPipeline(mca::Pipeline &P) {
-  // Handle pipeline errors here.
-  Expected<unsigned> Cycles = P.run();
-  if (!Cycles) {
-    WithColor::error() << toString(Cycles.takeError());
-    return false;
-  }
-  return true;
-}
+namespace {
+/// Everything needed to simulate one code region and report on it. Regions
+/// are set up one after the other, but their pipelines are independent and
+/// can be run concurrently.
+struct RegionAnalysis {
+  std::unique_ptr<mca::InstrBuilder> IB;
+  DenseMap<const MCInst *, SmallVector<mca::Instrument *>> InstToInstruments;
+  SmallVector<std::unique_ptr<mca::Instruction>> LoweredSequence;
+  std::unique_ptr<mca::CodeEmitter> CE;
+  std::unique_ptr<mca::CircularSourceMgr> S;
+  std::unique_ptr<mca::CustomBehaviour> CB;
+  std::unique_ptr<mca::Pipeline> P;
+  std::unique_ptr<mca::PipelinePrinter> Printer;
+};
+} // end anonymous namespace
 
 int main(int argc, char **argv) {
   InitLLVM X(argc, argv);
@@ -334,6 +349,8 @@ int main(int argc, char **argv) {
   cl::ParseCommandLineOptions(argc, argv,
                               "llvm machine code performance analyzer.\n");
 
+  parallel::strategy = hardware_concurrency(NumThreads);
+
   // Get the target from the triple. If a triple is not specified, then select
   // the default triple for the host. If the triple doesn't correspond to any
   // registered target, then exit with an error message.
@@ -536,9 +553,6 @@ int main(int argc, char **argv) {
     IPP = std::make_unique<mca::InstrPostProcess>(*STI, *MCII);
   }
 
-  // Create an instruction builder.
-  mca::InstrBuilder IB(*STI, *MCII, *MRI, MCIA.get(), *IM);
-
   // Create a context to control ownership of the pipeline hardware.
   mca::Context MCA(*MRI, *STI);
 
@@ -558,22 +572,63 @@ int main(int argc, char **argv) {
   assert(MAB && "Unable to create asm backend!");
 
   json::Object JSONOutput;
+
+  // Regions that are set up but not simulated yet. With more than one thread
+  // their pipelines are run in parallel, a batch at a time, and the reports
+  // are then printed in region order.
+  std::vector<std::unique_ptr<RegionAnalysis>> Pending;
+  const size_t BatchSize =
+      NumThreads == 1 ? 1 : 4 * parallel::strategy.compute_thread_count();
+
+  // Returns true on success.
+  auto RunPending = [&]() {
+    std::vector<std::string> Errors(Pending.size());
+    parallelFor(0, Pending.size(), [&](size_t I) {
+      // Handle pipeline errors here.
+      Expected<unsigned> Cycles = Pending[I]->P->run();
+      if (!Cycles)
+        Errors[I] = toString(Cycles.takeError());
+    });
+
+    bool Success = true;
+    for (auto [RA, Error] : zip(Pending, Errors)) {
+      if (!Error.empty()) {
+        WithColor::error() << Error;
+        Success = false;
+        break;
+      }
+
+      if (PrintJson) {
+        RA->Printer->printReport(JSONOutput);
+      } else {
+        RA->Printer->printReport(TOF->os());
+      }
+    }
+    Pending.clear();
+    return Success;
+  };
+
   for (const std::unique_ptr<mca::AnalysisRegion> &Region : Regions) {
     // Skip empty code regions.
     if (Region->empty())
       continue;
 
-    IB.clear();
+    // Every region gets a fresh InstrBuilder, so that the descriptors of
+    // regions that are still pending stay alive.
+    auto RA = std::make_unique<RegionAnalysis>();
+    RA->IB = std::make_unique<mca::InstrBuilder>(*STI, *MCII, *MRI, MCIA.get(),
+                                                 *IM);
+    mca::InstrBuilder &IB = *RA->IB;
 
     // Lower the MCInst sequence into an mca::Instruction sequence.
     ArrayRef<MCInst> Insts = Region->getInstructions();
-    mca::CodeEmitter CE(*STI, *MAB, *MCE, Insts);
+    RA->CE = std::make_unique<mca::CodeEmitter>(*STI, *MAB, *MCE, Insts);
+    mca::CodeEmitter &CE = *RA->CE;
 
     IPP->resetState();
 
-    DenseMap<const MCInst *, SmallVector<mca::Instrument *>>
-        InstToInstruments;
-    SmallVector<std::unique_ptr<mca::Instruction>> LoweredSequence;
+    auto &InstToInstruments = RA->InstToInstruments;
+    auto &LoweredSequence = RA->LoweredSequence;
     for (const MCInst &MCI : Insts) {
       SMLoc Loc = MCI.getLoc();
       const SmallVector<mca::Instrument *> Instruments =
@@ -583,6 +638,11 @@ int main(int argc, char **argv) {
       Expected<std::unique_ptr<mca::Instruction>> Inst =
           IB.createInstruction(MCI, Instruments);
       if (!Inst) {
+        // Report the regions before this one first.
+        if (!RunPending()) {
+          consumeError(Inst.takeError());
+          return 1;
+        }
         if (auto NewE = handleErrors(
                 Inst.takeError(),
                 [&IP, &STI](const mca::InstructionError<MCInst> &IE) {
@@ -605,8 +665,9 @@ int main(int argc, char **argv) {
       LoweredSequence.emplace_back(std::move(Inst.get()));
     }
 
-    mca::CircularSourceMgr S(LoweredSequence,
-                             PrintInstructionTables ? 1 : Iterations);
+    RA->S = std::make_unique<mca::CircularSourceMgr>(
+        LoweredSequence, PrintInstructionTables ? 1 : Iterations);
+    mca::CircularSourceMgr &S = *RA->S;
 
     if (PrintInstructionTables) {
       //  Create a pipeline, stages, and a printer.
@@ -614,7 +675,9 @@ int main(int argc, char **argv) {
       P->appendStage(std::make_unique<mca::EntryStage>(S));
       P->appendStage(std::make_unique<mca::InstructionTables>(SM));
 
-      mca::PipelinePrinter Printer(*P, *Region, RegionIdx, *STI, PO);
+      RA->Printer = std::make_unique<mca::PipelinePrinter>(*P, *Region,
+                                                           RegionIdx, *STI, PO);
+      mca::PipelinePrinter &Printer = *RA->Printer;
       if (PrintJson) {
         Printer.addView(
             std::make_unique<mca::InstructionView>(*STI, *IP, Insts));
@@ -629,15 +692,11 @@ int main(int argc, char **argv) {
       Printer.addView(
           std::make_unique<mca::ResourcePressureView>(*STI, *IP, Insts));
 
-      if (!runPipeline(*P))
+      RA->P = std::move(P);
+      Pending.push_back(std::move(RA));
+      if (Pending.size() >= BatchSize && !RunPending())
         return 1;
 
-      if (PrintJson) {
-        Printer.printReport(JSONOutput);
-      } else {
-        Printer.printReport(TOF->os());
-      }
-
       ++RegionIdx;
       continue;
     }
@@ -660,7 +719,9 @@ int main(int argc, char **argv) {
     // Create a basic pipeline simulating an out-of-order backend.
     auto P = MCA.createDefaultPipeline(PO, S, *CB);
 
-    mca::PipelinePrinter Printer(*P, *Region, RegionIdx, *STI, PO);
+    RA->Printer = std::make_unique<mca::PipelinePrinter>(*P, *Region, RegionIdx,
+                                                         *STI, PO);
+    mca::PipelinePrinter &Printer = *RA->Printer;
 
     // Targets can define their own custom Views that exist within their
     // /lib/Target/ directory so that the View can utilize their CustomBehaviour
@@ -747,18 +808,18 @@ int main(int argc, char **argv) {
         Printer.addView(std::move(CBView));
     }
 
-    if (!runPipeline(*P))
+    RA->CB = std::move(CB);
+    RA->P = std::move(P);
+    Pending.push_back(std::move(RA));
+    if (Pending.size() >= BatchSize && !RunPending())
       return 1;
 
-    if (PrintJson) {
-      Printer.printReport(JSONOutput);
-    } else {
-      Printer.printReport(TOF->os());
-    }
-
     ++RegionIdx;
   }
 
+  if (!RunPending())
+    return 1;
+
   if (PrintJson)
     TOF->os() << formatv("{0:2}", json::Value(std::move(JSONOutput))) << "\n";
 
@@ -2350,8 +2350,11 @@ static void dumpSymbolicFile(SymbolicFile *O, std::vector<NMSymbol> &SymbolList,
 
 static std::vector<NMSymbol> dumpSymbolNamesFromFile(StringRef Filename) {
   std::vector<NMSymbol> SymbolList;
+  // The readers don't need a null terminator, and not asking for one lets
+  // inputs whose size is a multiple of the page size be mapped too.
   ErrorOr<std::unique_ptr<MemoryBuffer>> BufferOrErr =
-      MemoryBuffer::getFileOrSTDIN(Filename);
+      MemoryBuffer::getFileOrSTDIN(Filename, /*IsText=*/false,
+                                   /*RequiresNullTerminator=*/false);
   if (error(BufferOrErr.getError(), Filename))
     return SymbolList;
 
@@ -1882,12 +1882,20 @@ disassembleObject(ObjectFile &Obj, const ObjectFile &DbgObj,
     uint64_t Size;
     uint64_t Index;
     bool PrintedSection = false;
-    std::vector<RelocationRef> Rels = RelocMap[Section];
+    std::vector<RelocationRef> &Rels = RelocMap[Section];
     std::vector<RelocationRef>::const_iterator RelCur = Rels.begin();
     std::vector<RelocationRef>::const_iterator RelEnd = Rels.end();
 
     // Loop over each chunk of code between two points where at least
     // one symbol is defined.
+    //
+    // FIXME: The chunks could be disassembled in parallel into separate
+    // buffers that are printed in address order. That needs a disassembler,
+    // instruction printer and symbolizer per thread, since the MC objects in
+    // DisassemblerTarget are not thread-safe. It also needs per-chunk copies
+    // of the state that is carried from one chunk to the next: RelCur,
+    // the SourcePrinter's last printed line, the LiveVariablePrinter and the
+    // mapping symbol state.
     for (size_t SI = 0, SE = Symbols.size(); SI != SE;) {
       // Advance SI past all the symbols starting at the same address,
       // and make an ArrayRef of them.
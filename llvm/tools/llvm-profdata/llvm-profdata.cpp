@@ -11,6 +11,7 @@
 //===----------------------------------------------------------------------===//
 
 #include "llvm/ADT/SmallSet.h"
+#include "llvm/ADT/SmallString.h"
 #include "llvm/ADT/SmallVector.h"
 #include "llvm/ADT/StringRef.h"
 #include "llvm/IR/LLVMContext.h"
@@ -28,6 +29,7 @@
 #include "llvm/Support/Discriminator.h"
 #include "llvm/Support/Errc.h"
 #include "llvm/Support/FileSystem.h"
+#include "llvm/Support/FileUtilities.h"
 #include "llvm/Support/Format.h"
 #include "llvm/Support/FormattedStream.h"
 #include "llvm/Support/LLVMDriver.h"
@@ -35,6 +37,7 @@
 #include "llvm/Support/MemoryBuffer.h"
 #include "llvm/Support/Path.h"
 #include "llvm/Support/Regex.h"
+#include "llvm/Support/Signals.h"
 #include "llvm/Support/ThreadPool.h"
 #include "llvm/Support/Threading.h"
 #include "llvm/Support/VirtualFileSystem.h"
@@ -269,6 +272,13 @@ cl::opt<unsigned> NumThreads(
     cl::desc("Number of merge threads to use (default: autodetect)"));
 cl::alias NumThreadsA("j", cl::desc("Alias for --num-threads"),
                       cl::aliasopt(NumThreads));
+cl::opt<unsigned> NumPartitions(
+    "num-partitions", cl::init(0), cl::sub(MergeSubcommand),
+    cl::desc("Split instrumentation records into this many partitions by "
+             "function name, merge each partition separately and spill it to "
+             "disk before combining them. This bounds the memory used while "
+             "reading the inputs, at the cost of reading every input once per "
+             "partition (default: 0, disabled)"));
 
 cl::opt<std::string> ProfileSymbolListFile(
     "prof-sym-list", cl::init(""), cl::sub(MergeSubcommand),
@@ -636,10 +646,21 @@ static void overlapInput(const std::string &BaseFilename,
   }
 }
 
-/// Load an input into a writer context.
+/// Return true if the function \p FuncName belongs in partition \p Partition
+/// out of \p NumPartitions.
+static bool isInPartition(StringRef FuncName, unsigned Partition,
+                          unsigned NumPartitions) {
+  return NumPartitions <= 1 || MD5Hash(FuncName) % NumPartitions == Partition;
+}
+
+/// Load an input into a writer context. If \p NumPartitions is greater than
+/// one, only the records of functions in \p Partition are loaded, and the
+/// data that is not per-function (MemProf, temporal traces, binary ids and
+/// vtable names) is only loaded into partition 0.
 static void loadInput(const WeightedFile &Input, SymbolRemapper *Remapper,
                       const InstrProfCorrelator *Correlator,
-                      const StringRef ProfiledBinary, WriterContext *WC) {
+                      const StringRef ProfiledBinary, WriterContext *WC,
+                      unsigned Partition = 0, unsigned NumPartitions = 1) {
   std::unique_lock<std::mutex> CtxGuard{WC->Lock};
 
   // Copy the filename, because llvm::ThreadPool copied the input "const
@@ -649,6 +670,8 @@ static void loadInput(const WeightedFile &Input, SymbolRemapper *Remapper,
 
   using ::llvm::memprof::RawMemProfReader;
   if (RawMemProfReader::hasFormat(Input.Filename)) {
+    if (Partition != 0)
+      return;
     auto ReaderOrErr = RawMemProfReader::create(Input.Filename, ProfiledBinary);
     if (!ReaderOrErr) {
       exitWithError(ReaderOrErr.takeError(), Input.Filename);
@@ -743,6 +766,8 @@ static void loadInput(const WeightedFile &Input, SymbolRemapper *Remapper,
     if (Remapper)
       I.Name = (*Remapper)(I.Name);
     const StringRef FuncName = I.Name;
+    if (!isInPartition(FuncName, Partition, NumPartitions))
+      continue;
     bool Reported = false;
     WC->Writer.addRecord(std::move(I), Input.Weight, [&](Error E) {
       if (Reported) {
@@ -759,6 +784,15 @@ static void loadInput(const WeightedFile &Input, SymbolRemapper *Remapper,
     });
   }
 
+  if (Partition != 0) {
+    // Errors are only reported by partition 0, which reads the same inputs.
+    if (ReaderWarning)
+      consumeError(std::move(ReaderWarning->first));
+    if (Reader->hasError())
+      consumeError(Reader->getError());
+    return;
+  }
+
   const InstrProfSymtab &symtab = Reader->getSymtab();
   const auto &VTableNames = symtab.getVTableNames();
 
@@ -887,6 +921,67 @@ static void writeInstrProfile(StringRef OutputFilename,
   }
 }
 
+/// Merge \p Inputs into \p WC one partition of function names at a time.
+/// Each partition is merged by a single thread and written to a temporary
+/// indexed profile, so the threads only ever hold one partition each in
+/// memory. The temporary profiles are then loaded into \p WC one by one.
+/// They are removed when the merge is done, or on exit if it fails.
+static void mergeInstrProfilePartitions(const WeightedFileVector &Inputs,
+                                        SymbolRemapper *Remapper,
+                                        const InstrProfCorrelator *Correlator,
+                                        const StringRef ProfiledBinary,
+                                        WriterContext &WC,
+                                        uint64_t TraceReservoirSize,
+                                        uint64_t MaxTraceLength) {
+  // exitWithError() exits without unwinding the stack, so the removers are
+  // static to have their destructors run at exit as well. All files are
+  // created up front so that the removers are not touched by the workers.
+  static SmallVector<std::unique_ptr<FileRemover>, 0> PartitionFileRemovers;
+  SmallVector<std::string, 0> PartitionFiles(NumPartitions);
+  for (std::string &File : PartitionFiles) {
+    SmallString<128> Path;
+    if (std::error_code EC = sys::fs::createTemporaryFile(
+            "profdata-partition", "profdata", Path))
+      exitWithErrorCode(EC);
+    File = std::string(Path);
+    PartitionFileRemovers.push_back(std::make_unique<FileRemover>(File));
+    sys::RemoveFileOnSignal(File);
+  }
+
+  auto MergePartition = [&](unsigned Partition) {
+    const std::string &Path = PartitionFiles[Partition];
+    std::error_code EC;
+    raw_fd_ostream OS(Path, EC, sys::fs::OF_None);
+    if (EC)
+      exitWithErrorCode(EC, Path);
+
+    WriterContext PartitionWC(/*IsSparse=*/false, WC.ErrLock,
+                              WC.WriterErrorCodes, TraceReservoirSize,
+                              MaxTraceLength);
+    for (const auto &Input : Inputs)
+      loadInput(Input, Remapper, Correlator, ProfiledBinary, &PartitionWC,
+                Partition, NumPartitions);
+    if (Error E = PartitionWC.Writer.write(OS))
+      exitWithError(std::move(E), Path);
+    // Only partition 0 reports the per-input errors so they are reported once.
+    if (Partition == 0)
+      WC.Errors = std::move(PartitionWC.Errors);
+  };
+
+  DefaultThreadPool Pool(hardware_concurrency(NumThreads));
+  for (unsigned I = 0; I < NumPartitions; ++I)
+    Pool.async(MergePartition, I);
+  Pool.wait();
+
+  for (const std::string &Path : PartitionFiles) {
+    loadInput({Path, 1}, /*Remapper=*/nullptr, /*Correlator=*/nullptr,
+              /*ProfiledBinary=*/"", &WC);
+    sys::DontRemoveFileOnSignal(Path);
+  }
+  // Remove the temporary profiles now rather than at exit.
+  PartitionFileRemovers.clear();
+}
+
 static void mergeInstrProfile(const WeightedFileVector &Inputs,
                               SymbolRemapper *Remapper,
                               int MaxDbgCorrelationWarnings,
@@ -926,18 +1021,25 @@ static void mergeInstrProfile(const WeightedFileVector &Inputs,
   SmallSet<instrprof_error, 4> WriterErrorCodes;
 
   // If NumThreads is not specified, auto-detect a good default.
+  // When partitioning, the threads work on partitions instead of inputs.
+  const bool Partitioned = NumPartitions > 1;
   if (NumThreads == 0)
     NumThreads = std::min(hardware_concurrency().compute_thread_count(),
-                          unsigned((Inputs.size() + 1) / 2));
+                          Partitioned ? unsigned(NumPartitions)
+                                      : unsigned((Inputs.size() + 1) / 2));
 
   // Initialize the writer contexts.
   SmallVector<std::unique_ptr<WriterContext>, 4> Contexts;
-  for (unsigned I = 0; I < NumThreads; ++I)
+  for (unsigned I = 0; I < (Partitioned ? 1u : unsigned(NumThreads)); ++I)
     Contexts.emplace_back(std::make_unique<WriterContext>(
         OutputSparse, ErrorLock, WriterErrorCodes, TraceReservoirSize,
         MaxTraceLength));
 
-  if (NumThreads == 1) {
+  if (Partitioned) {
+    mergeInstrProfilePartitions(Inputs, Remapper, Correlator.get(),
+                                ProfiledBinary, *Contexts[0],
+                                TraceReservoirSize, MaxTraceLength);
+  } else if (NumThreads == 1) {
     for (const auto &Input : Inputs)
       loadInput(Input, Remapper, Correlator.get(), ProfiledBinary,
                 Contexts[0].get());
@@ -948,7 +1050,7 @@ static void mergeInstrProfile(const WeightedFileVector &Inputs,
     unsigned Ctx = 0;
     for (const auto &Input : Inputs) {
       Pool.async(loadInput, Input, Remapper, Correlator.get(), ProfiledBinary,
-                 Contexts[Ctx].get());
+                 Contexts[Ctx].get(), /*Partition=*/0, /*NumPartitions=*/1);
       Ctx = (Ctx + 1) % NumThreads;
     }
     Pool.wait();
@@ -11,6 +11,8 @@
 #include "llvm/DebugInfo/Symbolize/SymbolizableModule.h"
 #include "llvm/Support/FileSystem.h"
 #include "llvm/Support/Process.h"
+#include "llvm/Support/ThreadPool.h"
+#include "llvm/Support/Threading.h"
 #include "llvm/Support/ToolOutputFile.h"
 
 #define DEBUG_TYPE "perf-reader"
@@ -42,6 +44,11 @@ static cl::opt<bool>
 cl::opt<bool> ShowDetailedWarning("show-detailed-warning",
                                   cl::desc("Show detailed warning message."));
 
+static cl::opt<unsigned> UnwindThreads(
+    "unwind-threads", cl::init(1),
+    cl::desc("Number of threads used to unwind hybrid samples of a binary "
+             "with pseudo probes (0 = all hardware threads)."));
+
 extern cl::opt<std::string> PerfTraceFilename;
 extern cl::opt<bool> ShowDisassemblyOnly;
 extern cl::opt<bool> ShowSourceLocations;
@@ -262,6 +269,18 @@ void VirtualUnwinder::recordBranchCount(const LBREntry &Branch,
   }
 }
 
+void VirtualUnwinder::mergeStats(const VirtualUnwinder &Other) {
+  NumTotalBranches += Other.NumTotalBranches;
+  NumExtCallBranch += Other.NumExtCallBranch;
+  NumMissingExternalFrame += Other.NumMissingExternalFrame;
+  NumMismatchedProEpiBranch += Other.NumMismatchedProEpiBranch;
+  NumMismatchedExtCallBranch += Other.NumMismatchedExtCallBranch;
+  NumUnpairedExtAddr += Other.NumUnpairedExtAddr;
+  NumPairedExtAddr += Other.NumPairedExtAddr;
+  UntrackedCallsites.insert(Other.UntrackedCallsites.begin(),
+                            Other.UntrackedCallsites.end());
+}
+
 bool VirtualUnwinder::unwind(const PerfSample *Sample, uint64_t Repeat) {
   // Capture initial state as starting point for unwinding.
   UnwindState State(Sample, Binary);
@@ -502,12 +521,57 @@ static std::string getContextKeyStr(ContextKey *K,
 }
 
 void HybridPerfReader::unwindSamples() {
-  VirtualUnwinder Unwinder(&SampleCounters, Binary);
-  for (const auto &Item : AggregatedSamples) {
-    const PerfSample *Sample = Item.first.getPtr();
-    Unwinder.unwind(Sample, Item.second);
+  // With pseudo probes, unwinding only reads the binary, so the samples can be
+  // unwound on several threads into separate counters that are merged at the
+  // end. Without them, unwinding symbolizes through caches that are not
+  // thread-safe.
+  unsigned NumThreads = 1;
+  if (Binary->usePseudoProbes())
+    NumThreads = std::max<size_t>(
+        1, std::min<size_t>(
+               hardware_concurrency(UnwindThreads).compute_thread_count(),
+               AggregatedSamples.size()));
+
+  if (NumThreads == 1) {
+    VirtualUnwinder Unwinder(&SampleCounters, Binary);
+    for (const auto &Item : AggregatedSamples) {
+      const PerfSample *Sample = Item.first.getPtr();
+      Unwinder.unwind(Sample, Item.second);
+    }
+    emitUnwinderWarnings(Unwinder);
+    return;
+  }
+
+  std::vector<const AggregatedCounter::value_type *> Samples;
+  Samples.reserve(AggregatedSamples.size());
+  for (const auto &Item : AggregatedSamples)
+    Samples.push_back(&Item);
+
+  std::vector<ContextSampleCounterMap> Counters(NumThreads - 1);
+  std::vector<VirtualUnwinder> Unwinders;
+  Unwinders.reserve(NumThreads);
+  Unwinders.emplace_back(&SampleCounters, Binary);
+  for (ContextSampleCounterMap &Counter : Counters)
+    Unwinders.emplace_back(&Counter, Binary);
+
+  DefaultThreadPool Pool(hardware_concurrency(NumThreads));
+  for (unsigned T = 0; T < NumThreads; ++T) {
+    Pool.async([&, T]() {
+      for (size_t I = T; I < Samples.size(); I += NumThreads)
+        Unwinders[T].unwind(Samples[I]->first.getPtr(), Samples[I]->second);
+    });
   }
+  Pool.wait();
+
+  for (unsigned T = 1; T < NumThreads; ++T) {
+    Unwinders[0].mergeStats(Unwinders[T]);
+    for (const auto &[Key, Counter] : Counters[T - 1])
+      SampleCounters[Key].merge(Counter);
+  }
+  emitUnwinderWarnings(Unwinders[0]);
+}
 
+void HybridPerfReader::emitUnwinderWarnings(VirtualUnwinder &Unwinder) {
   // Warn about untracked frames due to missing probes.
   if (ShowDetailedWarning) {
     for (auto Address : Unwinder.getUntrackedCallsites())
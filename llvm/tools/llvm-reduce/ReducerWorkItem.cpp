@@ -8,6 +8,7 @@
 
 #include "ReducerWorkItem.h"
 #include "TestRunner.h"
+#include "llvm/ADT/StringExtras.h"
 #include "llvm/Analysis/ModuleSummaryAnalysis.h"
 #include "llvm/Analysis/ProfileSummaryInfo.h"
 #include "llvm/Bitcode/BitcodeReader.h"
@@ -32,6 +33,7 @@
 #include "llvm/IRReader/IRReader.h"
 #include "llvm/MC/TargetRegistry.h"
 #include "llvm/Passes/PassBuilder.h"
+#include "llvm/Support/BLAKE3.h"
 #include "llvm/Support/MemoryBufferRef.h"
 #include "llvm/Support/SourceMgr.h"
 #include "llvm/Support/TargetSelect.h"
@@ -460,6 +462,16 @@ bool ReducerWorkItem::verify(raw_fd_ostream *OS) const {
 bool ReducerWorkItem::isReduced(const TestRunner &Test) const {
   const bool UseBitcode = Test.inputIsBitcode() || TmpFilesAsBitcode;
 
+  SmallString<0> Contents;
+  raw_svector_ostream ContentsOS(Contents);
+  writeOutput(ContentsOS, UseBitcode);
+
+  // Skip the test if identical contents were already tested.
+  BLAKE3Result<16> Hash = BLAKE3::hash<16>(arrayRefFromStringRef(Contents));
+  StringRef HashKey = toStringRef(Hash);
+  if (std::optional<bool> Cached = Test.getCachedResult(HashKey))
+    return *Cached;
+
   SmallString<128> CurrentFilepath;
 
   // Write ReducerWorkItem to tmp file
@@ -476,7 +488,7 @@ bool ReducerWorkItem::isReduced(const TestRunner &Test) const {
 
   ToolOutputFile Out(CurrentFilepath, FD);
 
-  writeOutput(Out.os(), UseBitcode);
+  Out.os() << Contents;
 
   Out.os().close();
   if (Out.os().has_error()) {
@@ -487,7 +499,9 @@ bool ReducerWorkItem::isReduced(const TestRunner &Test) const {
   }
 
   // Current Chunks aren't interesting
-  return Test.run(CurrentFilepath);
+  bool IsInteresting = Test.run(CurrentFilepath);
+  Test.cacheResult(HashKey, IsInteresting);
+  return IsInteresting;
 }
 
 std::unique_ptr<ReducerWorkItem>
@@ -59,6 +59,19 @@ int TestRunner::run(StringRef Filename) const {
   return !Result;
 }
 
+std::optional<bool> TestRunner::getCachedResult(StringRef Hash) const {
+  std::lock_guard<std::mutex> Lock(ResultCacheMutex);
+  auto I = ResultCache.find(Hash);
+  if (I == ResultCache.end())
+    return std::nullopt;
+  return I->second;
+}
+
+void TestRunner::cacheResult(StringRef Hash, bool IsInteresting) const {
+  std::lock_guard<std::mutex> Lock(ResultCacheMutex);
+  ResultCache[Hash] = IsInteresting;
+}
+
 void TestRunner::writeOutput(StringRef Message) {
   std::error_code EC;
   raw_fd_ostream Out(OutputFilename, EC,
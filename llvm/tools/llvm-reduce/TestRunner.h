@@ -10,12 +10,15 @@
 #define LLVM_TOOLS_LLVM_REDUCE_TESTRUNNER_H
 
 #include "ReducerWorkItem.h"
+#include "llvm/ADT/StringMap.h"
 #include "llvm/IR/Module.h"
 #include "llvm/Support/Error.h"
 #include "llvm/Support/FileSystem.h"
 #include "llvm/Support/Path.h"
 #include "llvm/Support/Program.h"
 #include "llvm/Target/TargetMachine.h"
+#include <mutex>
+#include <optional>
 #include <vector>
 
 namespace llvm {
@@ -34,6 +37,13 @@ public:
   /// @returns 0 if test was successful, 1 if otherwise
   int run(StringRef Filename) const;
 
+  /// Returns the result of an earlier test of a file whose contents had the
+  /// hash \p Hash, if there was one.
+  std::optional<bool> getCachedResult(StringRef Hash) const;
+
+  /// Records the result of testing a file whose contents had the hash \p Hash.
+  void cacheResult(StringRef Hash, bool IsInteresting) const;
+
   /// Returns the most reduced version of the original testcase
   ReducerWorkItem &getProgram() const { return *Program; }
 
@@ -61,6 +71,11 @@ private:
   StringRef OutputFilename;
   const bool InputIsBitcode;
   bool EmitBitcode;
+
+  // Different chunk removals, passes and rounds often produce the same
+  // module, so results are remembered by a hash of the tested contents.
+  mutable StringMap<bool> ResultCache;
+  mutable std::mutex ResultCacheMutex;
 };
 
 } // namespace llvm
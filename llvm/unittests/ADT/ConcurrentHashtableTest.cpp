@@ -259,6 +259,40 @@ TEST(ConcurrentHashTableTest, AddStringEntriesParallel) {
               std::string::npos);
 }
 
+TEST(ConcurrentHashTableTest, FindStringEntriesParallel) {
+  PerThreadBumpPtrAllocator Allocator;
+  const size_t NumElements = 10000;
+  ConcurrentHashTableByPtr<std::string, String, PerThreadBumpPtrAllocator,
+                           ConcurrentHashTableInfoByPtr<
+                               std::string, String, PerThreadBumpPtrAllocator>>
+      HashTable(Allocator, 10);
+
+  // Insert even numbers while looking up odd ones, which must never be found,
+  // and even ones, which are found once their insertion has happened.
+  parallelFor(0, NumElements, [&](size_t I) {
+    std::string StringForElement = formatv("{0}", I);
+    if (I % 2 == 0) {
+      std::pair<String *, bool> Entry = HashTable.insert(StringForElement);
+      EXPECT_TRUE(Entry.second);
+      EXPECT_EQ(HashTable.find(StringForElement), Entry.first);
+    } else {
+      EXPECT_EQ(HashTable.find(StringForElement), nullptr);
+    }
+  });
+
+  EXPECT_EQ(HashTable.size(), NumElements / 2);
+  for (size_t I = 0; I < NumElements; I++) {
+    std::string StringForElement = formatv("{0}", I);
+    String *Entry = HashTable.find(StringForElement);
+    if (I % 2 == 0) {
+      ASSERT_NE(Entry, nullptr);
+      EXPECT_EQ(Entry->getKey(), StringForElement);
+    } else {
+      EXPECT_EQ(Entry, nullptr);
+    }
+  }
+}
+
 TEST(ConcurrentHashTableTest, AddStringEntriesParallelWithResize) {
   PerThreadBumpPtrAllocator Allocator;
   const size_t NumElements = 20000;
@@ -498,6 +498,58 @@ TEST_F(StringMapTest, PrecomputedHash) {
   ASSERT_EQ(I->second, Value);
 }
 
+TEST_F(StringMapTest, PrecomputedHashQueries) {
+  StringMap<int> A;
+  uint32_t FooHash = StringMap<int>::hash("foo");
+  uint32_t BarHash = StringMap<int>::hash("bar");
+  A.try_emplace_with_hash("foo", FooHash, 42);
+  EXPECT_TRUE(A.contains("foo", FooHash));
+  EXPECT_EQ(1u, A.count("foo", FooHash));
+  EXPECT_EQ(42, A.lookup("foo", FooHash));
+  EXPECT_FALSE(A.contains("bar", BarHash));
+  EXPECT_EQ(0u, A.count("bar", BarHash));
+  EXPECT_EQ(0, A.lookup("bar", BarHash));
+}
+
+TEST_F(StringMapTest, Reserve) {
+  StringMap<int> A;
+  A.reserve(100);
+  unsigned NumBuckets = A.getNumBuckets();
+  EXPECT_GE(NumBuckets * 3, 100u * 4);
+  for (int I = 0; I < 100; ++I)
+    A.try_emplace(Twine(I).str(), I);
+  EXPECT_EQ(NumBuckets, A.getNumBuckets());
+
+  // Growing a populated table keeps its contents.
+  A.reserve(1000);
+  EXPECT_GT(A.getNumBuckets(), NumBuckets);
+  EXPECT_EQ(100u, A.size());
+  for (int I = 0; I < 100; ++I)
+    EXPECT_EQ(I, A.lookup(Twine(I).str()));
+
+  // Reserving less than the current capacity does nothing.
+  NumBuckets = A.getNumBuckets();
+  A.reserve(1);
+  EXPECT_EQ(NumBuckets, A.getNumBuckets());
+}
+
+TEST_F(StringMapTest, InsertRangeReserves) {
+  std::vector<std::pair<StringRef, int>> Elts;
+  std::vector<std::string> Keys;
+  for (int I = 0; I < 200; ++I)
+    Keys.push_back(Twine(I).str());
+  for (int I = 0; I < 200; ++I)
+    Elts.push_back({Keys[I], I});
+
+  StringMap<int> A;
+  StringMap<int> B;
+  B.reserve(200);
+  A.insert(Elts.begin(), Elts.end());
+  EXPECT_EQ(200u, A.size());
+  EXPECT_EQ(B.getNumBuckets(), A.getNumBuckets());
+  EXPECT_EQ(199, A.lookup("199"));
+}
+
 struct Countable {
   int &InstanceCount;
   int Number;
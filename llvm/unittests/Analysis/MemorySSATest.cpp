@@ -1775,3 +1775,32 @@ TEST_F(MemorySSATest, TestNoDbgInsts) {
   ASSERT_EQ(MSSA.getMemoryAccess(DbgDeclare), nullptr);
   ASSERT_EQ(MSSA.getMemoryAccess(DbgValue), nullptr);
 }
+
+TEST_F(MemorySSATest, TestBatchedClobberQueries) {
+  F = Function::Create(FunctionType::get(B.getVoidTy(), {}, false),
+                       GlobalValue::ExternalLinkage, "F", &M);
+  B.SetInsertPoint(BasicBlock::Create(C, "", F));
+  Type *Int8 = Type::getInt8Ty(C);
+  Value *A = B.CreateAlloca(Int8, ConstantInt::get(Int8, 1), "A");
+  Value *X = B.CreateAlloca(Int8, ConstantInt::get(Int8, 1), "X");
+  StoreInst *SA = B.CreateStore(ConstantInt::get(Int8, 0), A);
+  StoreInst *SX = B.CreateStore(ConstantInt::get(Int8, 1), X);
+  LoadInst *LA = B.CreateLoad(Int8, A);
+  LoadInst *LX = B.CreateLoad(Int8, X);
+
+  setupAnalyses();
+  MemorySSA &MSSA = *Analyses->MSSA;
+  MemorySSAWalker *Walker = Analyses->Walker;
+
+  SmallVector<MemoryAccess *, 4> Accesses;
+  for (Instruction *I : std::initializer_list<Instruction *>{SA, SX, LA, LX})
+    Accesses.push_back(MSSA.getMemoryAccess(I));
+  SmallVector<MemoryAccess *, 4> Clobbers;
+  Walker->getClobberingMemoryAccesses(Accesses, Clobbers);
+
+  ASSERT_EQ(Clobbers.size(), Accesses.size());
+  EXPECT_TRUE(MSSA.isLiveOnEntryDef(Clobbers[0]));
+  EXPECT_TRUE(MSSA.isLiveOnEntryDef(Clobbers[1]));
+  EXPECT_EQ(Clobbers[2], MSSA.getMemoryAccess(SA));
+  EXPECT_EQ(Clobbers[3], MSSA.getMemoryAccess(SX));
+}
@@ -14,6 +14,7 @@
 #include "llvm/DebugInfo/GSYM/FileEntry.h"
 #include "llvm/DebugInfo/GSYM/FileWriter.h"
 #include "llvm/DebugInfo/GSYM/FunctionInfo.h"
+#include "llvm/DebugInfo/GSYM/GsymContext.h"
 #include "llvm/DebugInfo/GSYM/GsymCreator.h"
 #include "llvm/DebugInfo/GSYM/GsymReader.h"
 #include "llvm/DebugInfo/GSYM/Header.h"
@@ -1280,6 +1281,55 @@ TEST(GSYMTest, TestGsymLookups) {
     testing::ElementsAre(SourceLocation{"main", "/tmp", "main.c", 8, 32}));
 }
 
+TEST(GSYMTest, TestGsymContext) {
+  // Verify that GsymContext answers DIContext queries, including inline
+  // frames, from a GSYM file.
+  GsymCreator GC;
+  FunctionInfo FI(0x1000, 0x100, GC.insertString("main"));
+  FI.OptLineTable = LineTable();
+  const uint32_t MainFileIndex = GC.insertFile("/tmp/main.c");
+  const uint32_t FooFileIndex = GC.insertFile("/tmp/foo.h");
+  FI.OptLineTable->push(LineEntry(0x1000, MainFileIndex, 5));
+  FI.OptLineTable->push(LineEntry(0x1010, FooFileIndex, 10));
+  FI.OptLineTable->push(LineEntry(0x1020, MainFileIndex, 8));
+  FI.Inline = InlineInfo();
+  FI.Inline->Name = GC.insertString("inline1");
+  FI.Inline->CallFile = MainFileIndex;
+  FI.Inline->CallLine = 6;
+  FI.Inline->Ranges.insert(AddressRange(0x1010, 0x1020));
+  GC.addFunctionInfo(std::move(FI));
+  OutputAggregator Null(nullptr);
+  ASSERT_FALSE((bool)GC.finalize(Null));
+  SmallString<512> Str;
+  raw_svector_ostream OutStrm(Str);
+  FileWriter FW(OutStrm, llvm::endianness::native);
+  ASSERT_FALSE((bool)GC.encode(FW));
+  Expected<GsymReader> GR = GsymReader::copyBuffer(OutStrm.str());
+  ASSERT_THAT_EXPECTED(GR, Succeeded());
+  GsymContext Ctx(std::move(*GR));
+
+  DILineInfoSpecifier Spec(
+      DILineInfoSpecifier::FileLineInfoKind::AbsoluteFilePath,
+      DINameKind::LinkageName);
+  DILineInfo Info = Ctx.getLineInfoForAddress({0x1000}, Spec);
+  EXPECT_EQ(Info.FunctionName, "main");
+  EXPECT_EQ(Info.FileName, "/tmp/main.c");
+  EXPECT_EQ(Info.Line, 5u);
+  EXPECT_EQ(Info.StartAddress, 0x1000u);
+
+  DIInliningInfo Inlined = Ctx.getInliningInfoForAddress({0x1010}, Spec);
+  ASSERT_EQ(Inlined.getNumberOfFrames(), 2u);
+  EXPECT_EQ(Inlined.getFrame(0).FunctionName, "inline1");
+  EXPECT_EQ(Inlined.getFrame(0).FileName, "/tmp/foo.h");
+  EXPECT_EQ(Inlined.getFrame(0).Line, 10u);
+  EXPECT_EQ(Inlined.getFrame(1).FunctionName, "main");
+  EXPECT_EQ(Inlined.getFrame(1).FileName, "/tmp/main.c");
+  EXPECT_EQ(Inlined.getFrame(1).Line, 6u);
+
+  // Addresses outside of any function produce empty results.
+  EXPECT_EQ(Ctx.getLineInfoForAddress({0x2000}, Spec), DILineInfo());
+}
+
 
 TEST(GSYMTest, TestDWARFFunctionWithAddresses) {
   // Create a single compile unit with a single function and make sure it gets
@@ -0,0 +1,58 @@
+//===- DirectoryObjectCacheTest.cpp - Unit tests for DirectoryObjectCache -===//
+//
+// Part of the LLVM Project, under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+//===----------------------------------------------------------------------===//
+
+#include "llvm/ExecutionEngine/Orc/CompileUtils.h"
+#include "llvm/ADT/SmallString.h"
+#include "llvm/IR/LLVMContext.h"
+#include "llvm/IR/Module.h"
+#include "llvm/Support/FileSystem.h"
+#include "llvm/Support/MemoryBuffer.h"
+#include "gtest/gtest.h"
+
+using namespace llvm;
+using namespace llvm::orc;
+
+namespace {
+
+class DirectoryObjectCacheTest : public testing::Test {
+protected:
+  void SetUp() override {
+    ASSERT_FALSE(sys::fs::createUniqueDirectory("orc-object-cache", Dir));
+  }
+  void TearDown() override { sys::fs::remove_directories(Dir); }
+
+  SmallString<128> Dir;
+  LLVMContext Ctx;
+  Module M{"M", Ctx};
+};
+
+TEST_F(DirectoryObjectCacheTest, StoreAndLoad) {
+  DirectoryObjectCache Cache(std::string(Dir), "salt");
+  EXPECT_EQ(Cache.getObject(&M), nullptr);
+  Cache.notifyObjectCompiled(&M, MemoryBufferRef("object", "M"));
+
+  std::unique_ptr<MemoryBuffer> Obj = Cache.getObject(&M);
+  ASSERT_NE(Obj, nullptr);
+  EXPECT_EQ(Obj->getBuffer(), "object");
+
+  // A different salt gives a different key.
+  DirectoryObjectCache OtherCache(std::string(Dir), "other salt");
+  EXPECT_EQ(OtherCache.getObject(&M), nullptr);
+}
+
+TEST_F(DirectoryObjectCacheTest, CompilationFailureDropsPendingEntry) {
+  DirectoryObjectCache Cache(std::string(Dir), "salt");
+  EXPECT_EQ(Cache.getObject(&M), nullptr);
+  Cache.notifyObjectCompilationFailed(&M);
+
+  // The module is no longer pending, so nothing is stored for it.
+  Cache.notifyObjectCompiled(&M, MemoryBufferRef("object", "M"));
+  EXPECT_EQ(Cache.getObject(&M), nullptr);
+}
+
+} // namespace
@@ -7,6 +7,7 @@
 //===----------------------------------------------------------------------===//
 
 #include "llvm/ProfileData/SampleProf.h"
+#include "llvm/ADT/ScopeExit.h"
 #include "llvm/ADT/StringMap.h"
 #include "llvm/ADT/StringRef.h"
 #include "llvm/IR/DebugInfoMetadata.h"
@@ -23,6 +24,7 @@
 #include "llvm/Support/raw_ostream.h"
 #include "llvm/Testing/Support/SupportHelpers.h"
 #include "gtest/gtest.h"
+#include <list>
 #include <string>
 #include <vector>
 
@@ -328,6 +330,75 @@ struct SampleProfTest : ::testing::Test {
     verifyProfileSummary(Summary, M, true, true);
   }
 
+  // Round-trip a context-sensitive profile through the extensible binary
+  // format. With \p LoadFromModule, only the contexts of the functions in the
+  // module and their callees are loaded.
+  void testCSRoundTrip(bool LoadFromModule) {
+    TempFile ProfileFile("profile", "", "", /*Unique*/ true);
+    createWriter(SampleProfileFormat::SPF_Ext_Binary, ProfileFile.path());
+
+    bool SavedProfileIsCS = FunctionSamples::ProfileIsCS;
+    auto Restore = make_scope_exit(
+        [&]() { FunctionSamples::ProfileIsCS = SavedProfileIsCS; });
+    FunctionSamples::ProfileIsCS = true;
+
+    std::list<SampleContextFrameVector> CSNameTable;
+    std::vector<SampleContext> Contexts;
+    SampleProfileMap Profiles;
+    uint64_t Total = 1000;
+    for (StringRef ContextStr :
+         {"[main]", "[main:1 @ foo]", "[main:1 @ foo:2 @ bar]", "[baz]",
+          "[baz:3 @ qux]"}) {
+      SampleContext Ctx(ContextStr, CSNameTable);
+      FunctionSamples &FS = Profiles.Create(Ctx);
+      FS.addTotalSamples(Total);
+      FS.addHeadSamples(Total / 10);
+      FS.addBodySamples(1, 0, Total);
+      Contexts.push_back(Ctx);
+      Total += 100;
+    }
+
+    std::error_code EC = Writer->write(Profiles);
+    ASSERT_TRUE(NoError(EC));
+    Writer->getOutputStream().flush();
+
+    Module M("my_module", Context);
+    FunctionType *FnType =
+        FunctionType::get(Type::getVoidTy(Context), {}, false);
+    M.getOrInsertFunction("foo", FnType);
+
+    auto FS = vfs::getRealFileSystem();
+    auto ReaderOrErr = SampleProfileReader::create(
+        ProfileFile.path().str(), Context, *FS, FSDiscriminatorPass::Base);
+    ASSERT_TRUE(NoError(ReaderOrErr.getError()));
+    Reader = std::move(ReaderOrErr.get());
+    if (LoadFromModule)
+      Reader->setModule(&M);
+    EC = Reader->read();
+    ASSERT_TRUE(NoError(EC));
+    ASSERT_TRUE(Reader->profileIsCS());
+
+    // foo is only called from main, so [main:1 @ foo] is the farthest
+    // ancestor context to load, along with its callee context.
+    SampleProfileMap &ReadProfiles = Reader->getProfiles();
+    if (LoadFromModule)
+      ASSERT_EQ(ReadProfiles.size(), 2u);
+    else
+      ASSERT_EQ(ReadProfiles.size(), Profiles.size());
+    for (const SampleContext &Ctx : Contexts) {
+      auto It = ReadProfiles.find(Ctx);
+      SampleContextFrames Frames = Ctx.getContextFrames();
+      bool Expected = !LoadFromModule || (Frames.size() > 1 &&
+                                          Frames[1].Func == FunctionId("foo"));
+      ASSERT_EQ(It != ReadProfiles.end(), Expected) << Ctx.toString();
+      if (!Expected)
+        continue;
+      ASSERT_EQ(It->second.getContext(), Ctx);
+      ASSERT_EQ(It->second.getTotalSamples(),
+                Profiles.find(Ctx)->second.getTotalSamples());
+    }
+  }
+
   void addFunctionSamples(SampleProfileMap *Smap, const char *Fname,
                           uint64_t TotalSamples, uint64_t HeadSamples) {
     StringRef Name(Fname);
@@ -426,6 +497,14 @@ TEST_F(SampleProfTest, remap_ext_binary_profile) {
   testRoundTrip(SampleProfileFormat::SPF_Ext_Binary, true, false);
 }
 
+TEST_F(SampleProfTest, roundtrip_cs_ext_binary_profile) {
+  testCSRoundTrip(false);
+}
+
+TEST_F(SampleProfTest, roundtrip_cs_ext_binary_profile_on_demand) {
+  testCSRoundTrip(true);
+}
+
 TEST_F(SampleProfTest, sample_overflow_saturation) {
   const uint64_t Max = std::numeric_limits<uint64_t>::max();
   sampleprof_error Result;
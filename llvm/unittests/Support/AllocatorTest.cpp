@@ -7,6 +7,7 @@
 //===----------------------------------------------------------------------===//
 
 #include "llvm/Support/Allocator.h"
+#include "llvm/Support/MappedMemoryAllocator.h"
 #include "gtest/gtest.h"
 #include <cstdlib>
 
@@ -258,4 +259,23 @@ TEST(AllocatorTest, TestBigAlignment) {
   EXPECT_GT(MockSlabAllocator::GetLastSlabSize(), 4096u);
 }
 
+// Slabs taken directly from mapped (possibly huge) pages.
+TEST(AllocatorTest, TestMappedMemorySlabs) {
+  BumpPtrAllocatorImpl<MappedMemoryAllocator, 2 * 1024 * 1024> Alloc;
+  uint64_t *A = Alloc.Allocate<uint64_t>(1024);
+  A[0] = 1;
+  A[1023] = 2;
+  EXPECT_EQ(1U, Alloc.GetNumSlabs());
+
+  // A custom-sized slab for an allocation larger than the slab size.
+  char *B = static_cast<char *>(Alloc.Allocate(3 * 1024 * 1024, 16));
+  B[0] = 'a';
+  B[3 * 1024 * 1024 - 1] = 'b';
+  EXPECT_EQ(2U, Alloc.GetNumSlabs());
+  EXPECT_EQ(1U, A[0]);
+
+  Alloc.Reset();
+  EXPECT_EQ(1U, Alloc.GetNumSlabs());
+}
+
 }  // anonymous namespace
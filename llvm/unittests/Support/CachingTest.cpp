@@ -0,0 +1,128 @@
+//===- CachingTest.cpp ----------------------------------------------------===//
+//
+// Part of the LLVM Project, under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+//===----------------------------------------------------------------------===//
+
+#include "llvm/Support/Caching.h"
+#include "llvm/ADT/SmallString.h"
+#include "llvm/ADT/StringMap.h"
+#include "llvm/Support/Error.h"
+#include "llvm/Support/FileSystem.h"
+#include "llvm/Support/MemoryBuffer.h"
+#include "llvm/Support/Path.h"
+#include "llvm/Support/raw_ostream.h"
+#include "llvm/Testing/Support/Error.h"
+#include "gtest/gtest.h"
+#include <mutex>
+
+using namespace llvm;
+
+namespace {
+
+class SharedCacheTest : public testing::Test {
+protected:
+  void SetUp() override {
+    ASSERT_FALSE(sys::fs::createUniqueDirectory("shared-cache-test", Dir));
+    Shared.Fetch = [this](StringRef Key) -> std::unique_ptr<MemoryBuffer> {
+      std::lock_guard<std::mutex> Lock(StoreMutex);
+      ++NumFetches;
+      auto It = Store.find(Key);
+      if (It == Store.end())
+        return nullptr;
+      return MemoryBuffer::getMemBufferCopy(It->second);
+    };
+    Shared.Store = [this](StringRef Key, MemoryBufferRef Data) {
+      std::lock_guard<std::mutex> Lock(StoreMutex);
+      Store[Key] = Data.getBuffer().str();
+    };
+  }
+
+  void TearDown() override { sys::fs::remove_directories(Dir); }
+
+  /// Returns a shared cache over a local cache in the subdirectory \p Name.
+  FileCache makeCache(StringRef Name) {
+    SmallString<128> Path(Dir);
+    sys::path::append(Path, Name);
+    Expected<FileCache> Local = localCache(
+        "test", "test-cache", Path,
+        [this](size_t Task, const Twine &ModuleName,
+               std::unique_ptr<MemoryBuffer> MB) {
+          Added.push_back(MB->getBuffer().str());
+        });
+    EXPECT_THAT_EXPECTED(Local, Succeeded());
+    return sharedCache(std::move(*Local), Shared);
+  }
+
+  SmallString<128> Dir;
+  SharedCacheStore Shared;
+  std::mutex StoreMutex;
+  StringMap<std::string> Store;
+  unsigned NumFetches = 0;
+  std::vector<std::string> Added;
+};
+
+TEST_F(SharedCacheTest, MissStoresInBothCaches) {
+  FileCache Cache = makeCache("a");
+  AddStreamFn AddStream = cantFail(Cache(0, "key", "module"));
+  ASSERT_TRUE(AddStream);
+  {
+    std::unique_ptr<CachedFileStream> Stream =
+        cantFail(AddStream(0, "module"));
+    *Stream->OS << "contents";
+  }
+  EXPECT_EQ(Store.lookup("key"), "contents");
+  ASSERT_EQ(Added.size(), 1u);
+  EXPECT_EQ(Added[0], "contents");
+
+  // The file is now a local hit, so the shared store is not asked again.
+  Added.clear();
+  NumFetches = 0;
+  EXPECT_FALSE(cantFail(Cache(0, "key", "module")));
+  EXPECT_EQ(NumFetches, 0u);
+  ASSERT_EQ(Added.size(), 1u);
+  EXPECT_EQ(Added[0], "contents");
+}
+
+TEST_F(SharedCacheTest, SharedHitIsCopiedToLocalCache) {
+  Store["key"] = "contents";
+  FileCache Cache = makeCache("a");
+  EXPECT_FALSE(cantFail(Cache(0, "key", "module")));
+  ASSERT_EQ(Added.size(), 1u);
+  EXPECT_EQ(Added[0], "contents");
+
+  // The file is served from the local cache even after the shared store
+  // forgets it.
+  Store.clear();
+  Added.clear();
+  EXPECT_FALSE(cantFail(makeCache("a")(0, "key", "module")));
+  ASSERT_EQ(Added.size(), 1u);
+  EXPECT_EQ(Added[0], "contents");
+}
+
+TEST_F(SharedCacheTest, MissingCallbacks) {
+  Shared.Fetch = nullptr;
+  Store["key"] = "contents";
+  FileCache Cache = makeCache("a");
+  // Without Fetch, entries in the store are never used.
+  AddStreamFn AddStream = cantFail(Cache(0, "key", "module"));
+  ASSERT_TRUE(AddStream);
+
+  Shared.Store = nullptr;
+  Cache = makeCache("b");
+  AddStream = cantFail(Cache(0, "other", "module"));
+  ASSERT_TRUE(AddStream);
+  {
+    std::unique_ptr<CachedFileStream> Stream =
+        cantFail(AddStream(0, "module"));
+    *Stream->OS << "other contents";
+  }
+  // Without Store, the file only goes to the local cache.
+  EXPECT_FALSE(Store.count("other"));
+  ASSERT_EQ(Added.size(), 1u);
+  EXPECT_EQ(Added[0], "other contents");
+}
+
+} // namespace
@@ -155,6 +155,30 @@ TEST(FileOutputBuffer, Test) {
   ASSERT_EQ(File6Size, 0ULL);
   ASSERT_NO_ERROR(fs::remove(File6.str()));
 
+  // TEST 7: Writes after startWriteback() are still committed.
+  SmallString<128> File7(TestDirectory);
+  File7.append("/file7");
+  {
+    Expected<std::unique_ptr<FileOutputBuffer>> BufferOrErr =
+        FileOutputBuffer::create(File7, 8192);
+    ASSERT_NO_ERROR(errorToErrorCode(BufferOrErr.takeError()));
+    std::unique_ptr<FileOutputBuffer> &Buffer = *BufferOrErr;
+    memset(Buffer->getBufferStart(), 'A', 8192);
+    Buffer->startWriteback();
+    memcpy(Buffer->getBufferEnd() - 20, "AABBCCDDEEFFGGHHIIJJ", 20);
+    ASSERT_NO_ERROR(errorToErrorCode(Buffer->commit()));
+  }
+  {
+    ErrorOr<std::unique_ptr<MemoryBuffer>> BufOrErr =
+        MemoryBuffer::getFile(File7);
+    ASSERT_TRUE(!!BufOrErr);
+    StringRef Contents = (*BufOrErr)->getBuffer();
+    ASSERT_EQ(Contents.size(), 8192ULL);
+    EXPECT_EQ(Contents.take_front(4), "AAAA");
+    EXPECT_EQ(Contents.take_back(20), "AABBCCDDEEFFGGHHIIJJ");
+  }
+  ASSERT_NO_ERROR(fs::remove(File7.str()));
+
   // Clean up.
   ASSERT_NO_ERROR(fs::remove(TestDirectory.str()));
 }
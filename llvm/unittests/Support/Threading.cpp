@@ -15,6 +15,11 @@
 #include <atomic>
 #include <condition_variable>
 
+#if defined(__linux__) && !defined(__ANDROID__)
+#include <sched.h>
+#include <set>
+#endif
+
 using namespace llvm;
 
 namespace {
@@ -57,6 +62,14 @@ TEST(Threading, NumPhysicalCoresUnsupported) {
   ASSERT_EQ(Num, -1);
 }
 
+TEST(Threading, PinnedStrategy) {
+  std::optional<ThreadPoolStrategy> S = get_threadpool_strategy("pinned");
+  ASSERT_TRUE(S);
+  EXPECT_TRUE(S->PinThreads);
+  EXPECT_FALSE(S->UseHyperThreads);
+  EXPECT_FALSE(get_threadpool_strategy("4")->PinThreads);
+}
+
 #if LLVM_ENABLE_THREADS
 
 class Notification {
@@ -111,6 +124,37 @@ TEST(Threading, RunOnThreadSync) {
   ASSERT_EQ(Executed, true);
 }
 
+#if defined(__linux__) && !defined(__ANDROID__)
+TEST(Threading, PinnedThreadsUseDistinctCPUs) {
+  cpu_set_t ProcessAffinity;
+  ASSERT_EQ(sched_getaffinity(0, sizeof(ProcessAffinity), &ProcessAffinity),
+            0);
+  ThreadPoolStrategy S = *get_threadpool_strategy("pinned");
+  unsigned NumThreads = std::min<unsigned>(S.compute_thread_count(),
+                                           CPU_COUNT(&ProcessAffinity));
+
+  // Each thread ends up on a single CPU of the process mask, and as there are
+  // no more threads than CPUs, no two threads share one.
+  std::set<int> CPUs;
+  for (unsigned I = 0; I != NumThreads; ++I) {
+    cpu_set_t ThreadAffinity;
+    CPU_ZERO(&ThreadAffinity);
+    llvm::thread Thread([&] {
+      S.apply_thread_strategy(I);
+      ASSERT_EQ(sched_getaffinity(0, sizeof(ThreadAffinity), &ThreadAffinity),
+                0);
+    });
+    Thread.join();
+    ASSERT_EQ(CPU_COUNT(&ThreadAffinity), 1);
+    for (int CPU = 0; CPU < CPU_SETSIZE; ++CPU)
+      if (CPU_ISSET(CPU, &ThreadAffinity)) {
+        EXPECT_TRUE(CPU_ISSET(CPU, &ProcessAffinity));
+        EXPECT_TRUE(CPUs.insert(CPU).second);
+      }
+  }
+}
+#endif
+
 #if defined(__APPLE__)
 TEST(Threading, AppleStackSize) {
   llvm::thread Thread([] {
@@ -65,6 +65,34 @@ TEST(TimeProfiler, Async_Begin_End_Smoke) {
   ASSERT_TRUE(json.find(R"("detail":"detail")") != std::string::npos);
 }
 
+TEST(TimeProfiler, Scope_Arguments) {
+  setupProfiler();
+
+  {
+    TimeTraceScope scope("event", "detail");
+    scope.addArgument("bytes", 42);
+  }
+
+  std::string json = teardownProfiler();
+  ASSERT_TRUE(json.find(R"("detail":"detail")") != std::string::npos);
+  ASSERT_TRUE(json.find(R"("bytes":42)") != std::string::npos);
+}
+
+TEST(TimeProfiler, MaxEntries) {
+  timeTraceProfilerSetMaxEntries(2);
+  setupProfiler();
+  timeTraceProfilerSetMaxEntries(0);
+
+  { TimeTraceScope scope("first"); }
+  { TimeTraceScope scope("second"); }
+  { TimeTraceScope scope("third"); }
+
+  std::string json = teardownProfiler();
+  ASSERT_TRUE(json.find(R"("name":"first")") == std::string::npos);
+  ASSERT_TRUE(json.find(R"("name":"second")") != std::string::npos);
+  ASSERT_TRUE(json.find(R"("name":"third")") != std::string::npos);
+}
+
 TEST(TimeProfiler, Begin_End_Disabled) {
   // Nothing should be observable here. The test is really just making sure
   // we've not got a stray nullptr deref.
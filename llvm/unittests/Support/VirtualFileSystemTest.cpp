@@ -20,8 +20,10 @@
 #include "llvm/Testing/Support/SupportHelpers.h"
 #include "gmock/gmock.h"
 #include "gtest/gtest.h"
+#include <atomic>
 #include <map>
 #include <string>
+#include <thread>
 
 using namespace llvm;
 using llvm::sys::fs::UniqueID;
@@ -1044,6 +1046,73 @@ TEST(ProxyFileSystemTest, Basic) {
   EXPECT_FALSE(Local);
 }
 
+namespace {
+class StatCountingFileSystem : public DummyFileSystem {
+public:
+  std::atomic<unsigned> NumStats{0};
+
+  ErrorOr<vfs::Status> status(const Twine &Path) override {
+    ++NumStats;
+    return DummyFileSystem::status(Path);
+  }
+};
+} // namespace
+
+TEST(CachingFileSystemTest, Basic) {
+  IntrusiveRefCntPtr<StatCountingFileSystem> Base(new StatCountingFileSystem());
+  Base->addDirectory("/dir");
+  Base->addRegularFile("/dir/a");
+  ASSERT_FALSE(Base->setCurrentWorkingDirectory("/dir"));
+  vfs::CachingFileSystem CFS(Base);
+
+  auto Stat = CFS.status("/dir/a");
+  ASSERT_FALSE(Stat.getError());
+  EXPECT_EQ(1u, Base->NumStats);
+
+  // The same file through a relative path is served from the cache, under the
+  // name it was requested by.
+  Stat = CFS.status("a");
+  ASSERT_FALSE(Stat.getError());
+  EXPECT_EQ("a", Stat->getName());
+  EXPECT_TRUE(CFS.exists("/dir/a"));
+  EXPECT_EQ(1u, Base->NumStats);
+
+  // Failures are cached too.
+  EXPECT_FALSE(CFS.exists("/dir/b"));
+  EXPECT_FALSE(CFS.exists("/dir/b"));
+  EXPECT_EQ(2u, Base->NumStats);
+
+  Base->addRegularFile("/dir/b");
+  EXPECT_FALSE(CFS.exists("/dir/b"));
+  CFS.invalidate("b");
+  EXPECT_TRUE(CFS.exists("/dir/b"));
+  EXPECT_EQ(3u, Base->NumStats);
+
+  CFS.invalidateAll();
+  EXPECT_TRUE(CFS.exists("/dir/a"));
+  EXPECT_EQ(4u, Base->NumStats);
+}
+
+#if LLVM_ENABLE_THREADS
+TEST(CachingFileSystemTest, ConcurrentStats) {
+  IntrusiveRefCntPtr<StatCountingFileSystem> Base(new StatCountingFileSystem());
+  Base->addRegularFile("/a");
+  vfs::CachingFileSystem CFS(Base);
+
+  std::vector<std::thread> Threads;
+  for (unsigned I = 0; I < 8; ++I)
+    Threads.emplace_back([&] {
+      for (unsigned J = 0; J < 100; ++J) {
+        EXPECT_TRUE(CFS.exists("/a"));
+        EXPECT_FALSE(CFS.exists("/b"));
+      }
+    });
+  for (auto &T : Threads)
+    T.join();
+  EXPECT_EQ(2u, Base->NumStats);
+}
+#endif
+
 class InMemoryFileSystemTest : public ::testing::Test {
 protected:
   llvm::vfs::InMemoryFileSystem FS;
@@ -0,0 +1,159 @@
+#!/usr/bin/env python3
+#
+# ===- compare-time-traces.py - Compare compile-time phases --*- python -*--===#
+#
+# Part of the LLVM Project, under the Apache License v2.0 with LLVM Exceptions.
+# See https://llvm.org/LICENSE.txt for license information.
+# SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+#
+# ===-----------------------------------------------------------------------===#
+
+r"""
+Compile-time Phase Comparison
+=============================
+
+This script summarizes the time profiles written by clang -ftime-trace,
+opt/llc -time-trace and lld --time-trace, and compares such summaries against a
+baseline. Every profile ends with one "Total <phase>" event per phase, so the
+phases of all the tools that took part in a build can be summed up together.
+
+Example usage, running the same build of a fixed corpus before and after a
+change:
+
+  compare-time-traces.py summarize -o base.json \
+      $(find build-base -name '*.json')
+  compare-time-traces.py summarize -o new.json \
+      $(find build-new -name '*.json')
+  compare-time-traces.py compare base.json new.json --threshold 2
+
+The compare mode exits with a non-zero status if any phase got slower by more
+than the threshold, so it can be used as a regression check.
+"""
+
+import argparse
+import json
+import sys
+
+
+def summarize_trace(path, phases):
+    with open(path) as f:
+        try:
+            trace = json.load(f)
+        except json.JSONDecodeError:
+            # Build directories also contain JSON that is not a time profile.
+            return False
+    if not isinstance(trace, dict) or "traceEvents" not in trace:
+        return False
+    for event in trace["traceEvents"]:
+        name = event.get("name", "")
+        if event.get("ph") != "X" or not name.startswith("Total "):
+            continue
+        phase = phases.setdefault(name[len("Total ") :], {"us": 0, "count": 0})
+        phase["us"] += event.get("dur", 0)
+        phase["count"] += event.get("args", {}).get("count", 1)
+    return True
+
+
+def summarize(args):
+    phases = {}
+    num_traces = 0
+    for path in args.traces:
+        if summarize_trace(path, phases):
+            num_traces += 1
+    summary = {"traces": num_traces, "phases": phases}
+    out = open(args.output, "w") if args.output else sys.stdout
+    json.dump(summary, out, indent=2, sort_keys=True)
+    out.write("\n")
+    return 0
+
+
+def load_summary(path):
+    with open(path) as f:
+        return json.load(f)
+
+
+def compare(args):
+    base = load_summary(args.baseline)
+    new = load_summary(args.current)
+    if base["traces"] != new["traces"]:
+        print(
+            "warning: comparing %d traces against %d baseline traces"
+            % (new["traces"], base["traces"]),
+            file=sys.stderr,
+        )
+
+    regressions = []
+    rows = []
+    for name in sorted(set(base["phases"]) | set(new["phases"])):
+        base_us = base["phases"].get(name, {}).get("us", 0)
+        new_us = new["phases"].get(name, {}).get("us", 0)
+        # Short phases are dominated by noise.
+        if max(base_us, new_us) < args.min_ms * 1000:
+            continue
+        if base_us:
+            delta = 100.0 * (new_us - base_us) / base_us
+        else:
+            delta = float("inf")
+        rows.append((name, base_us, new_us, delta))
+        if delta > args.threshold:
+            regressions.append(name)
+
+    rows.sort(key=lambda row: row[2], reverse=True)
+    print(
+        "%-40s %12s %12s %9s" % ("Phase", "Baseline ms", "Current ms", "Change")
+    )
+    for name, base_us, new_us, delta in rows:
+        print(
+            "%-40s %12.1f %12.1f %+8.2f%%"
+            % (name[:40], base_us / 1000.0, new_us / 1000.0, delta)
+        )
+
+    if regressions:
+        print(
+            "\n%d phase(s) regressed by more than %.2f%%: %s"
+            % (len(regressions), args.threshold, ", ".join(regressions))
+        )
+        return 1
+    return 0
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__.split("\n\n")[1])
+    subparsers = parser.add_subparsers(dest="mode", required=True)
+
+    summarize_parser = subparsers.add_parser(
+        "summarize", help="sum up the phases of a set of time profiles"
+    )
+    summarize_parser.add_argument(
+        "traces", nargs="+", help="time profile files"
+    )
+    summarize_parser.add_argument(
+        "-o", "--output", help="write the summary here instead of stdout"
+    )
+    summarize_parser.set_defaults(func=summarize)
+
+    compare_parser = subparsers.add_parser(
+        "compare", help="compare a summary against a baseline summary"
+    )
+    compare_parser.add_argument("baseline", help="baseline summary")
+    compare_parser.add_argument("current", help="summary to check")
+    compare_parser.add_argument(
+        "--threshold",
+        type=float,
+        default=1.0,
+        help="slowdown in percent above which a phase is a regression",
+    )
+    compare_parser.add_argument(
+        "--min-ms",
+        type=float,
+        default=10.0,
+        help="ignore phases that took less than this in both summaries",
+    )
+    compare_parser.set_defaults(func=compare)
+
+    args = parser.parse_args()
+    sys.exit(args.func(args))
+
+
+if __name__ == "__main__":
+    main()
@@ -49,6 +49,33 @@ private:
   /// The symbol table of the top-level operation.
   SymbolTable &topLevelSymbolTable;
 };
+
+/// This analysis contains the map of symbol users for all of the symbols
+/// defined under the top-level operation. Building it walks every symbol use
+/// nested under the operation, so passes that only need to query users should
+/// fetch it through the analysis manager and passes that don't change symbol
+/// uses should mark it as preserved. Unlike `SymbolTableAnalysis`, the map is
+/// not updated by passes and is invalidated unless explicitly preserved.
+class SymbolUserMapAnalysis {
+public:
+  /// Create the user map from the symbol tables of the `SymbolTableAnalysis`
+  /// of the same operation, which is shared with the other clients.
+  SymbolUserMapAnalysis(Operation *op, AnalysisManager &am)
+      : symbolTables(am.getAnalysis<SymbolTableAnalysis>().getSymbolTables()),
+        userMap(symbolTables, op) {}
+
+  /// Get the symbol table collection used to resolve symbol uses.
+  SymbolTableCollection &getSymbolTables() { return symbolTables; }
+
+  /// Get the symbol user map.
+  SymbolUserMap &getUserMap() { return userMap; }
+
+private:
+  /// The symbol tables owned by the `SymbolTableAnalysis`.
+  SymbolTableCollection &symbolTables;
+  /// The map of symbol operations to their users.
+  SymbolUserMap userMap;
+};
 } // namespace mlir
 
 #endif // MLIR_ANALYSIS_SYMBOLTABLEANALYSIS_H
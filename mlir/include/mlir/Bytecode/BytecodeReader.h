@@ -64,6 +64,14 @@ public:
       Operation *op, llvm::function_ref<bool(Operation *)> lazyOpsCallback =
                          [](Operation *) { return false; });
 
+  /// Materialize the provided operation if needed, together with every
+  /// materializable operation nested under it, at any depth. This is meant to
+  /// be called right before `op` is handed to code that needs its body, e.g.
+  /// by a pass instrumentation, so that only the parts of the IR that are
+  /// actually visited pay the parsing cost. The reader is not thread-safe:
+  /// concurrent calls must be serialized by the caller.
+  LogicalResult materializeNested(Operation *op);
+
   /// Finalize the lazy-loading by calling back with every op that hasn't been
   /// materialized to let the client decide if the op should be deleted or
   /// materialized. The op is materialized if the callback returns true, deleted
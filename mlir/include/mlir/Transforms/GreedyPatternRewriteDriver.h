@@ -54,6 +54,22 @@ public:
   /// Note: Only applicable when simplifying entire regions.
   int64_t maxIterations = 10;
 
+  /// When set, the ops nested directly within the simplified region that are
+  /// isolated from above are first simplified independently of each other on
+  /// the context's thread pool (if multi-threading is enabled). The remaining
+  /// ops are then simplified as usual, without revisiting the bodies of those
+  /// isolated ops unless the outer rewrite touches them. The resulting
+  /// "changed" and convergence states are the union of all partial rewrites,
+  /// so they do not depend on the thread schedule.
+  ///
+  /// The patterns must be safe to apply concurrently to disjoint isolated
+  /// regions, which is the same requirement the pass manager places on passes
+  /// it runs on sibling isolated ops. Ignored when a `listener` is set or
+  /// `strictMode` is not `AnyOp`, as both observe the entire region.
+  ///
+  /// Note: Only applicable when simplifying entire regions.
+  bool parallelizeIsolatedOps = false;
+
   /// This specifies the maximum number of rewrites within an iteration. Use
   /// `kNoLimit` to disable this limit.
   int64_t maxNumRewrites = kNoLimit;
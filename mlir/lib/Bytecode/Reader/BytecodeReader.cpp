@@ -1354,13 +1354,32 @@ public:
 
   /// Materialize all operations.
   LogicalResult materializeAll() {
-    while (!lazyLoadableOpsMap.empty()) {
-      if (failed(materialize(lazyLoadableOpsMap.begin())))
+    while (!lazyLoadableOps.empty()) {
+      if (failed(materialize(lazyLoadableOpsMap.find(
+              lazyLoadableOps.begin()->first))))
         return failure();
     }
     return success();
   }
 
+  /// Materialize every lazy-loadable operation nested under `op` (including
+  /// `op` itself), as well as the ones discovered while doing so.
+  LogicalResult materializeNested(Operation *op) {
+    if (lazyLoadableOpsMap.empty())
+      return success();
+    auto materializeEagerly = [](Operation *) { return true; };
+    WalkResult result = op->walk<WalkOrder::PreOrder>([&](Operation *nested) {
+      if (!isMaterializable(nested))
+        return WalkResult::advance();
+      // Nested lazy ops are parsed eagerly, so there is nothing left to visit
+      // below `nested`.
+      if (failed(materialize(nested, materializeEagerly)))
+        return WalkResult::interrupt();
+      return WalkResult::skip();
+    });
+    return failure(result.wasInterrupted());
+  }
+
   /// Finalize the lazy-loading by calling back with every op that hasn't been
   /// materialized to let the client decide if the op should be deleted or
   /// materialized. The op is materialized if the callback returns true, deleted
@@ -2557,6 +2576,10 @@ LogicalResult BytecodeReader::materialize(
   return impl->materialize(op, lazyOpsCallback);
 }
 
+LogicalResult BytecodeReader::materializeNested(Operation *op) {
+  return impl->materializeNested(op);
+}
+
 LogicalResult
 BytecodeReader::finalize(function_ref<bool(Operation *)> shouldMaterialize) {
   return impl->finalize(shouldMaterialize);
@@ -111,6 +111,14 @@ Operation *Operation::create(Location location, OperationName name,
   size_t prefixByteSize = llvm::alignTo(
       Operation::prefixAllocSize(numTrailingResults, numInlineResults),
       alignof(Operation));
+  // FIXME: Each operation is a separate malloc, which makes walks over very
+  // large modules dominated by cache misses. An arena owned by a Block or
+  // Region doesn't fit the current ownership model: operations are freely
+  // moved between blocks and regions (splice, moveBefore, inlining) and are
+  // freed one at a time through destroy(), so an arena could only release its
+  // memory once every operation it ever held is gone. Compacting storage would
+  // additionally require rewriting every Operation*, Value and use-list pointer
+  // held by clients, which the API does not allow.
   char *mallocMem = reinterpret_cast<char *>(malloc(byteSize + prefixByteSize));
   void *rawMem = mallocMem + prefixByteSize;
 
@@ -61,7 +61,15 @@ static LogicalResult loadSourceFileBuffer(llvm::StringRef filename,
     return emitError(mlir::UnknownLoc::get(ctx),
                      "only main buffer parsed at the moment");
   }
-  auto fileOrErr = llvm::MemoryBuffer::getFileOrSTDIN(filename);
+  // Bytecode doesn't need a null terminator, and not requiring one lets large
+  // files always be memory mapped: resource blobs read from the bytecode can
+  // then alias the mapping instead of being copied to the heap. The textual
+  // parser does need the terminator, so reopen the file in that case (stdin is
+  // always read into a null terminated heap buffer).
+  auto fileOrErr = llvm::MemoryBuffer::getFileOrSTDIN(
+      filename, /*IsText=*/false, /*RequiresNullTerminator=*/false);
+  if (fileOrErr && filename != "-" && !isBytecode(**fileOrErr))
+    fileOrErr = llvm::MemoryBuffer::getFileOrSTDIN(filename);
   if (fileOrErr.getError())
     return emitError(mlir::UnknownLoc::get(ctx),
                      "could not open input file " + filename);
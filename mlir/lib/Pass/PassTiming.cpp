@@ -9,7 +9,9 @@
 #include "PassDetail.h"
 #include "mlir/Pass/PassManager.h"
 #include "llvm/ADT/SmallVector.h"
+#include "llvm/Support/Process.h"
 #include "llvm/Support/Threading.h"
+#include "llvm/Support/TimeProfiler.h"
 
 #include <chrono>
 #include <optional>
@@ -22,6 +24,13 @@ using namespace mlir::detail;
 //===----------------------------------------------------------------------===//
 
 namespace {
+/// The time trace sections opened for the passes running on the current
+/// thread, along with the malloc usage at the time each pass started. The time
+/// trace profiler is itself per-thread, so this is only populated on threads
+/// where it is enabled.
+thread_local SmallVector<std::pair<llvm::TimeTraceProfilerEntry *, size_t>, 4>
+    activeTimeTraceEntries;
+
 struct PassTiming : public PassInstrumentation {
   PassTiming(TimingScope &timingScope) : rootScope(timingScope) {}
   PassTiming(std::unique_ptr<TimingManager> tm)
@@ -86,7 +95,7 @@ struct PassTiming : public PassInstrumentation {
   // Pass
   //===--------------------------------------------------------------------===//
 
-  void runBeforePass(Pass *pass, Operation *) override {
+  void runBeforePass(Pass *pass, Operation *op) override {
     auto tid = llvm::get_threadid();
     auto &activeTimers = activeThreadTimers[tid];
     auto &parentScope = activeTimers.empty() ? rootScope : activeTimers.back();
@@ -103,6 +112,15 @@ struct PassTiming : public PassInstrumentation {
       activeTimers.push_back(
           parentScope.nest(pass->getThreadingSiblingOrThis(),
                            [pass]() { return std::string(pass->getName()); }));
+
+      // Also report the pass to the time trace profiler if the host enabled
+      // it, e.g. with -ftime-trace, so that it shows up in the Chrome trace.
+      if (llvm::timeTraceProfilerEnabled()) {
+        activeTimeTraceEntries.emplace_back(
+            llvm::timeTraceProfilerBegin(pass->getName(),
+                                         op->getName().getStringRef()),
+            llvm::sys::Process::GetMallocUsage());
+      }
     }
   }
 
@@ -110,6 +128,9 @@ struct PassTiming : public PassInstrumentation {
     auto tid = llvm::get_threadid();
     if (isa<OpToOpPassAdaptor>(pass))
       parentTimerIndices.erase({tid, pass});
+    else if (llvm::timeTraceProfilerEnabled() &&
+             !activeTimeTraceEntries.empty())
+      endTimeTraceEntry();
     auto &activeTimers = activeThreadTimers[tid];
     assert(!activeTimers.empty() && "expected active timer");
     activeTimers.pop_back();
@@ -119,6 +140,18 @@ struct PassTiming : public PassInstrumentation {
     runAfterPass(pass, op);
   }
 
+  /// Close the innermost time trace section, recording the change in malloc
+  /// usage while the pass ran. Note that the malloc usage is process-wide, so
+  /// it includes allocations made by passes running on other threads.
+  void endTimeTraceEntry() {
+    auto [entry, mallocUsage] = activeTimeTraceEntries.pop_back_val();
+    llvm::timeTraceProfilerAddArgument(
+        entry, "malloc-delta",
+        static_cast<int64_t>(llvm::sys::Process::GetMallocUsage()) -
+            static_cast<int64_t>(mallocUsage));
+    llvm::timeTraceProfilerEnd(entry);
+  }
+
   //===--------------------------------------------------------------------===//
   // Analysis
   //===--------------------------------------------------------------------===//
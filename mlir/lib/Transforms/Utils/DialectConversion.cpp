@@ -18,6 +18,7 @@
 #include "llvm/ADT/ScopeExit.h"
 #include "llvm/ADT/SetVector.h"
 #include "llvm/ADT/SmallPtrSet.h"
+#include "llvm/Support/Allocator.h"
 #include "llvm/Support/Debug.h"
 #include "llvm/Support/FormatVariadic.h"
 #include "llvm/Support/SaveAndRestore.h"
@@ -235,6 +236,13 @@ protected:
   ConversionPatternRewriterImpl &rewriterImpl;
 };
 
+/// Rewrites are allocated from a bump allocator owned by the rewriter, so
+/// destroying one must only run its destructor.
+struct IRRewriteDeleter {
+  void operator()(IRRewrite *rewrite) const { rewrite->~IRRewrite(); }
+};
+using IRRewritePtr = std::unique_ptr<IRRewrite, IRRewriteDeleter>;
+
 /// A block rewrite.
 class BlockRewrite : public IRRewrite {
 public:
@@ -811,8 +819,8 @@ struct ConversionPatternRewriterImpl : public RewriterBase::Listener {
   /// failure.
   template <typename RewriteTy, typename... Args>
   void appendRewrite(Args &&...args) {
-    rewrites.push_back(
-        std::make_unique<RewriteTy>(*this, std::forward<Args>(args)...));
+    rewrites.emplace_back(new (rewriteAllocator.Allocate<RewriteTy>())
+                              RewriteTy(*this, std::forward<Args>(args)...));
   }
 
   /// Undo the rewrites (motions, splits) one by one in reverse order until
@@ -974,8 +982,14 @@ struct ConversionPatternRewriterImpl : public RewriterBase::Listener {
   // replacing a value with one of a different type.
   ConversionValueMapping mapping;
 
+  /// Storage for the rewrites below. A conversion records at least one
+  /// rewrite for almost every IR change, so individually heap allocating them
+  /// is a noticeable cost. The memory of rolled back rewrites is only
+  /// reclaimed when the conversion finishes.
+  llvm::BumpPtrAllocator rewriteAllocator;
+
   /// Ordered list of block operations (creations, splits, motions).
-  SmallVector<std::unique_ptr<IRRewrite>> rewrites;
+  SmallVector<IRRewritePtr> rewrites;
 
   /// A set of operations that should no longer be considered for legalization.
   /// E.g., ops that are recursively legal. Ops that were replaced/erased are
@@ -1805,7 +1819,7 @@ void ConversionPatternRewriter::cancelOpModification(Operation *op) {
 #endif
   // Erase the last update for this operation.
   auto it = llvm::find_if(
-      llvm::reverse(impl->rewrites), [&](std::unique_ptr<IRRewrite> &rewrite) {
+      llvm::reverse(impl->rewrites), [&](IRRewritePtr &rewrite) {
         auto *modifyRewrite = dyn_cast<ModifyOperationRewrite>(rewrite.get());
         return modifyRewrite && modifyRewrite->getOperation() == op;
       });
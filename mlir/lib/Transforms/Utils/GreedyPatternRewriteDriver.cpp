@@ -15,6 +15,7 @@
 #include "mlir/Config/mlir-config.h"
 #include "mlir/IR/Action.h"
 #include "mlir/IR/Matchers.h"
+#include "mlir/IR/Threading.h"
 #include "mlir/IR/Verifier.h"
 #include "mlir/Interfaces/SideEffectInterfaces.h"
 #include "mlir/Rewrite/PatternApplicator.h"
@@ -785,9 +786,25 @@ public:
   /// success if the transformation converged.
   LogicalResult simplify(bool *changed) &&;
 
+  /// Do not populate the worklist with the bodies of the ops nested directly
+  /// in `region` that are isolated from above. These are assumed to be
+  /// simplified already; ops inside them are still processed when they are
+  /// modified during the rewrite.
+  void skipIsolatedOpBodies() { skipIsolatedBodies = true; }
+
 private:
+  /// Invoke `callback` on all ops that should seed the worklist, in post-order
+  /// or pre-order (honouring `WalkResult::skip()` in the latter case).
+  void walkWorklistSeeds(function_ref<void(Operation *)> callback);
+  void
+  walkWorklistSeedsPreOrder(function_ref<WalkResult(Operation *)> callback);
+
   /// The region that is simplified.
   Region &region;
+
+  /// Whether isolated ops nested directly in `region` are seeded without their
+  /// bodies.
+  bool skipIsolatedBodies = false;
 };
 } // namespace
 
@@ -801,6 +818,34 @@ RegionPatternRewriteDriver::RegionPatternRewriteDriver(
   }
 }
 
+void RegionPatternRewriteDriver::walkWorklistSeeds(
+    function_ref<void(Operation *)> callback) {
+  if (!skipIsolatedBodies)
+    return (void)region.walk(callback);
+  for (Block &block : region) {
+    for (Operation &op : llvm::make_early_inc_range(block)) {
+      if (op.hasTrait<OpTrait::IsIsolatedFromAbove>())
+        callback(&op);
+      else
+        op.walk(callback);
+    }
+  }
+}
+
+void RegionPatternRewriteDriver::walkWorklistSeedsPreOrder(
+    function_ref<WalkResult(Operation *)> callback) {
+  if (!skipIsolatedBodies)
+    return (void)region.walk<WalkOrder::PreOrder>(callback);
+  for (Block &block : region) {
+    for (Operation &op : llvm::make_early_inc_range(block)) {
+      if (op.hasTrait<OpTrait::IsIsolatedFromAbove>())
+        (void)callback(&op);
+      else
+        (void)op.walk<WalkOrder::PreOrder>(callback);
+    }
+  }
+}
+
 namespace {
 class GreedyPatternRewriteIteration
     : public tracing::ActionImpl<GreedyPatternRewriteIteration> {
@@ -847,13 +892,13 @@ LogicalResult RegionPatternRewriteDriver::simplify(bool *changed) && {
 
     if (!config.useTopDownTraversal) {
       // Add operations to the worklist in postorder.
-      region.walk([&](Operation *op) {
+      walkWorklistSeeds([&](Operation *op) {
         if (!insertKnownConstant(op))
           addToWorklist(op);
       });
     } else {
       // Add all nested operations to the worklist in preorder.
-      region.walk<WalkOrder::PreOrder>([&](Operation *op) {
+      walkWorklistSeedsPreOrder([&](Operation *op) {
         if (!insertKnownConstant(op)) {
           addToWorklist(op);
           return WalkResult::advance();
@@ -904,10 +949,43 @@ mlir::applyPatternsAndFoldGreedily(Region &region,
         "greedy pattern rewriter input IR failed to verify");
 #endif // MLIR_ENABLE_EXPENSIVE_PATTERN_API_CHECKS
 
+  // Simplify the bodies of nested isolated ops independently of each other.
+  // The results are merged in region order, so the outcome is deterministic.
+  bool parallelize = config.parallelizeIsolatedOps && !config.listener &&
+                     config.strictMode == GreedyRewriteStrictness::AnyOp;
+  bool isolatedChanged = false, isolatedConverged = true;
+  if (parallelize) {
+    SmallVector<Region *> isolatedRegions;
+    for (Block &block : region)
+      for (Operation &op : block)
+        if (op.hasTrait<OpTrait::IsIsolatedFromAbove>())
+          for (Region &nested : op.getRegions())
+            if (!nested.empty())
+              isolatedRegions.push_back(&nested);
+
+    SmallVector<char> regionChanged(isolatedRegions.size(), false);
+    SmallVector<char> regionConverged(isolatedRegions.size(), false);
+    parallelFor(region.getContext(), 0, isolatedRegions.size(), [&](size_t i) {
+      GreedyRewriteConfig nestedConfig = config;
+      nestedConfig.scope = isolatedRegions[i];
+      bool nestedChanged = false;
+      regionConverged[i] = succeeded(applyPatternsAndFoldGreedily(
+          *isolatedRegions[i], patterns, nestedConfig, &nestedChanged));
+      regionChanged[i] = nestedChanged;
+    });
+    isolatedChanged = llvm::is_contained(regionChanged, true);
+    isolatedConverged = llvm::all_of(regionConverged, [](char c) { return c; });
+  }
+
   // Start the pattern driver.
   RegionPatternRewriteDriver driver(region.getContext(), patterns, config,
                                     region);
+  if (parallelize)
+    driver.skipIsolatedOpBodies();
   LogicalResult converged = std::move(driver).simplify(changed);
+  if (changed)
+    *changed |= isolatedChanged;
+  converged = success(succeeded(converged) && isolatedConverged);
   LLVM_DEBUG(if (failed(converged)) {
     llvm::dbgs() << "The pattern rewrite did not converge after scanning "
                  << config.maxIterations << " times\n";
@@ -311,6 +311,7 @@ struct TestPatternDriver
     GreedyRewriteConfig config;
     config.useTopDownTraversal = this->useTopDownTraversal;
     config.maxIterations = this->maxIterations;
+    config.parallelizeIsolatedOps = this->parallelizeIsolatedOps;
     (void)applyPatternsAndFoldGreedily(getOperation(), std::move(patterns),
                                        config);
   }
@@ -323,6 +324,10 @@ struct TestPatternDriver
       *this, "max-iterations",
       llvm::cl::desc("Max. iterations in the GreedyRewriteConfig"),
       llvm::cl::init(GreedyRewriteConfig().maxIterations)};
+  Option<bool> parallelizeIsolatedOps{
+      *this, "parallelize-isolated-ops",
+      llvm::cl::desc("Simplify nested isolated ops in parallel"),
+      llvm::cl::init(GreedyRewriteConfig().parallelizeIsolatedOps)};
 };
 
 struct DumpNotifications : public RewriterBase::Listener {
@@ -61,6 +61,19 @@ struct LazyLoadingPass : public PassWrapper<LazyLoadingPass, OperationPass<>> {
     llvm::outs() << "Has " << reader.getNumOpsToMaterialize()
                  << " ops to materialize\n";
 
+    if (materializeNested) {
+      for (Operation &topLevel : block) {
+        if (failed(reader.materializeNested(&topLevel))) {
+          topLevel.emitError() << "failed to materialize";
+          signalPassFailure();
+          return;
+        }
+      }
+      llvm::outs() << "Has " << reader.getNumOpsToMaterialize()
+                   << " ops to materialize\n";
+      return;
+    }
+
     // Recursively print the operations, before and after lazy loading.
     while (!toLoadOps.empty()) {
       Operation *toLoad = toLoadOps.front();
@@ -85,6 +98,10 @@ struct LazyLoadingPass : public PassWrapper<LazyLoadingPass, OperationPass<>> {
   Option<int> version{*this, "bytecode-version",
                       llvm::cl::desc("Specifies the bytecode version to use."),
                       llvm::cl::init(-1)};
+  Option<bool> materializeNested{
+      *this, "materialize-nested",
+      llvm::cl::desc("Materialize everything below the top-level ops at once"),
+      llvm::cl::init(false)};
 };
 } // namespace
 
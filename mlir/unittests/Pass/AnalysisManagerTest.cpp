@@ -7,6 +7,7 @@
 //===----------------------------------------------------------------------===//
 
 #include "mlir/Pass/AnalysisManager.h"
+#include "mlir/Analysis/SymbolTableAnalysis.h"
 #include "mlir/Dialect/Func/IR/FuncOps.h"
 #include "mlir/IR/Builders.h"
 #include "mlir/IR/BuiltinOps.h"
@@ -266,4 +267,43 @@ TEST(AnalysisManagerTest, DependentAnalysis2Ctors) {
   EXPECT_TRUE(an.ctor2called);
 }
 
+TEST(AnalysisManagerTest, SymbolUserMapAnalysis) {
+  MLIRContext context;
+  context.loadDialect<func::FuncDialect>();
+  OpBuilder builder(&context);
+
+  // Create a module with a function `bar` calling a function `foo`.
+  OwningOpRef<ModuleOp> module(ModuleOp::create(UnknownLoc::get(&context)));
+  auto fnType = builder.getFunctionType(std::nullopt, std::nullopt);
+  func::FuncOp foo =
+      func::FuncOp::create(builder.getUnknownLoc(), "foo", fnType);
+  foo.setPrivate();
+  module->push_back(foo);
+  func::FuncOp bar =
+      func::FuncOp::create(builder.getUnknownLoc(), "bar", fnType);
+  module->push_back(bar);
+  builder.setInsertionPointToStart(bar.addEntryBlock());
+  builder.create<func::CallOp>(builder.getUnknownLoc(), foo, ValueRange());
+  builder.create<func::ReturnOp>(builder.getUnknownLoc());
+
+  ModuleAnalysisManager mam(*module, /*passInstrumentor=*/nullptr);
+  AnalysisManager am = mam;
+
+  auto &users = am.getAnalysis<SymbolUserMapAnalysis>();
+  EXPECT_EQ(users.getUserMap().getUsers(foo).size(), 1u);
+  EXPECT_TRUE(users.getUserMap().useEmpty(bar));
+  EXPECT_TRUE(am.getCachedAnalysis<SymbolTableAnalysis>().has_value());
+
+  // The user map survives when preserved.
+  detail::PreservedAnalyses pa;
+  pa.preserve<SymbolUserMapAnalysis>();
+  am.invalidate(pa);
+  EXPECT_TRUE(am.getCachedAnalysis<SymbolUserMapAnalysis>().has_value());
+
+  // Otherwise it is dropped, but the symbol tables are kept.
+  am.invalidate(detail::PreservedAnalyses());
+  EXPECT_FALSE(am.getCachedAnalysis<SymbolUserMapAnalysis>().has_value());
+  EXPECT_TRUE(am.getCachedAnalysis<SymbolTableAnalysis>().has_value());
+}
+
 } // namespace
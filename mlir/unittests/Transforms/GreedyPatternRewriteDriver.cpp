@@ -0,0 +1,124 @@
+//===- GreedyPatternRewriteDriver.cpp - Greedy rewrite driver tests -------===//
+//
+// Part of the LLVM Project, under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+//===----------------------------------------------------------------------===//
+
+#include "mlir/Transforms/GreedyPatternRewriteDriver.h"
+#include "mlir/IR/BuiltinOps.h"
+#include "mlir/IR/PatternMatch.h"
+#include "mlir/Parser/Parser.h"
+#include "gtest/gtest.h"
+
+using namespace mlir;
+
+namespace {
+
+/// Replaces "test.foo" with "test.bar".
+struct RenameFooPattern : public RewritePattern {
+  RenameFooPattern(MLIRContext *context)
+      : RewritePattern("test.foo", /*benefit=*/1, context) {}
+
+  LogicalResult matchAndRewrite(Operation *op,
+                                PatternRewriter &rewriter) const override {
+    OperationState state(op->getLoc(), "test.bar");
+    rewriter.create(state);
+    rewriter.eraseOp(op);
+    return success();
+  }
+};
+
+class ParallelizeIsolatedOpsTest : public ::testing::TestWithParam<bool> {
+protected:
+  ParallelizeIsolatedOpsTest() { context.allowUnregisteredDialects(); }
+
+  /// Simplifies the body of the top-level module of `source` and returns the
+  /// number of "test.foo" and "test.bar" ops left.
+  std::pair<int, int> simplify(StringRef source, bool &changed,
+                               LogicalResult &converged) {
+    OwningOpRef<ModuleOp> module =
+        parseSourceString<ModuleOp>(source, &context);
+    EXPECT_TRUE(module);
+    if (!module)
+      return {-1, -1};
+
+    RewritePatternSet patterns(&context);
+    patterns.add<RenameFooPattern>(&context);
+    FrozenRewritePatternSet frozenPatterns(std::move(patterns));
+    GreedyRewriteConfig config;
+    config.parallelizeIsolatedOps = GetParam();
+    converged = applyPatternsAndFoldGreedily(module->getBodyRegion(),
+                                             frozenPatterns, config, &changed);
+
+    int numFoo = 0, numBar = 0;
+    module->walk([&](Operation *op) {
+      if (op->getName().getStringRef() == "test.foo")
+        ++numFoo;
+      else if (op->getName().getStringRef() == "test.bar")
+        ++numBar;
+    });
+    return {numFoo, numBar};
+  }
+
+  MLIRContext context;
+};
+
+TEST_P(ParallelizeIsolatedOpsTest, RewritesNestedAndOuterOps) {
+  bool changed = false;
+  LogicalResult converged = failure();
+  const char *ir = R"mlir(
+    module {
+      module { "test.foo"() : () -> () }
+      module {
+        "test.foo"() : () -> ()
+        module { "test.foo"() : () -> () }
+      }
+      "test.foo"() : () -> ()
+    }
+  )mlir";
+  auto [numFoo, numBar] = simplify(ir, changed, converged);
+  EXPECT_EQ(numFoo, 0);
+  EXPECT_EQ(numBar, 4);
+  EXPECT_TRUE(changed);
+  EXPECT_TRUE(succeeded(converged));
+}
+
+TEST_P(ParallelizeIsolatedOpsTest, ChangesOnlyInIsolatedOps) {
+  // The outer rewrite doesn't change anything, so "changed" must come from the
+  // isolated bodies.
+  bool changed = false;
+  LogicalResult converged = failure();
+  const char *ir = R"mlir(
+    module {
+      module { "test.foo"() : () -> () }
+      module { "test.baz"() : () -> () }
+    }
+  )mlir";
+  auto [numFoo, numBar] = simplify(ir, changed, converged);
+  EXPECT_EQ(numFoo, 0);
+  EXPECT_EQ(numBar, 1);
+  EXPECT_TRUE(changed);
+  EXPECT_TRUE(succeeded(converged));
+}
+
+TEST_P(ParallelizeIsolatedOpsTest, NoChanges) {
+  bool changed = true;
+  LogicalResult converged = failure();
+  const char *ir = R"mlir(
+    module {
+      module { "test.baz"() : () -> () }
+    }
+  )mlir";
+  auto [numFoo, numBar] = simplify(ir, changed, converged);
+  EXPECT_EQ(numFoo, 0);
+  EXPECT_EQ(numBar, 0);
+  EXPECT_FALSE(changed);
+  EXPECT_TRUE(succeeded(converged));
+}
+
+INSTANTIATE_TEST_SUITE_P(GreedyPatternRewriteDriver, ParallelizeIsolatedOpsTest,
+                         ::testing::Bool());
+
+} // namespace
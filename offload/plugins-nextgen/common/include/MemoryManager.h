@@ -13,6 +13,7 @@
 #ifndef LLVM_OPENMP_LIBOMPTARGET_PLUGINS_COMMON_MEMORYMANAGER_H
 #define LLVM_OPENMP_LIBOMPTARGET_PLUGINS_COMMON_MEMORYMANAGER_H
 
+#include <atomic>
 #include <cassert>
 #include <functional>
 #include <list>
@@ -69,6 +70,21 @@ class MemoryManagerTy {
     return Num >> 1;
   }
 
+  /// Round \p Size up to the size of the bucket it goes to, so that a freed
+  /// node can serve later requests of any size in that bucket rather than
+  /// only those of exactly the same size. Sizes beyond the largest bucket are
+  /// kept as they are. Since bucket sizes are powers of two, this allocates up
+  /// to twice the requested size; the threshold and the cache limit are
+  /// checked against the rounded size.
+  static size_t roundUpToBucketSize(size_t Size) {
+    if (Size > BucketSize[NumBuckets - 1])
+      return Size;
+    if (Size <= BucketSize[1])
+      return BucketSize[1];
+    const size_t F = floorToPowerOfTwo(Size);
+    return F == Size ? Size : F << 1;
+  }
+
   /// Find a suitable bucket
   static int findBucket(size_t Size) {
     const size_t F = floorToPowerOfTwo(Size);
@@ -133,6 +149,22 @@ class MemoryManagerTy {
   /// memory manager.
   size_t SizeThreshold = 1U << 13;
 
+  /// The maximum number of bytes kept in the free lists. Freed nodes that would
+  /// take the free lists above it are returned to the device. Zero means no
+  /// limit.
+  size_t CacheLimit = 0;
+
+  /// The number of bytes currently kept in the free lists.
+  size_t CachedBytes = 0;
+
+  /// Lock for \p CachedBytes, so that checking it against \p CacheLimit and
+  /// updating it is a single step.
+  std::mutex CachedBytesLock;
+
+  /// Statistics reported when the memory manager is destroyed.
+  std::atomic<size_t> NumReused = 0;
+  std::atomic<size_t> NumAllocatedOnDevice = 0;
+
   /// Request memory from target device
   void *allocateOnDevice(size_t Size, void *HstPtr) const {
     return DeviceAllocator.allocate(Size, HstPtr, TARGET_ALLOC_DEVICE);
@@ -146,6 +178,7 @@ class MemoryManagerTy {
   /// FreeList and try to allocate again.
   void *freeAndAllocate(size_t Size, void *HstPtr) {
     std::vector<void *> RemoveList;
+    size_t RemovedBytes = 0;
 
     // Deallocate all memory in FreeList
     for (int I = 0; I < NumBuckets; ++I) {
@@ -156,10 +189,16 @@ class MemoryManagerTy {
       for (const NodeTy &N : List) {
         deleteOnDevice(N.Ptr);
         RemoveList.push_back(N.Ptr);
+        RemovedBytes += N.Size;
       }
       FreeLists[I].clear();
     }
 
+    if (RemovedBytes) {
+      std::lock_guard<std::mutex> G(CachedBytesLock);
+      CachedBytes -= RemovedBytes;
+    }
+
     // Remove all nodes in the map table which have been released
     if (!RemoveList.empty()) {
       std::lock_guard<std::mutex> LG(MapTableLock);
@@ -200,10 +239,15 @@ public:
         DeviceAllocator(DeviceAllocator) {
     if (Threshold)
       SizeThreshold = Threshold;
+    CacheLimit = getCacheLimitFromEnv();
   }
 
   /// Destructor
   ~MemoryManagerTy() {
+    DP("MemoryManagerTy: %zu allocations reused a free node, %zu were "
+       "allocated on the device, %zu bytes were cached at exit.\n",
+       NumReused.load(), NumAllocatedOnDevice.load(), CachedBytes);
+
     for (auto Itr = PtrToNodeTable.begin(); Itr != PtrToNodeTable.end();
          ++Itr) {
       assert(Itr->second.Ptr && "nullptr in map table");
@@ -223,11 +267,13 @@ public:
        Size, DPxPTR(HstPtr));
 
     // If the size is greater than the threshold, allocate it directly from
-    // device.
-    if (Size > SizeThreshold) {
+    // device. The rounded size is what the memory manager would allocate, so
+    // that's what is compared.
+    const size_t BucketedSize = roundUpToBucketSize(Size);
+    if (BucketedSize > SizeThreshold) {
       DP("%zu is greater than the threshold %zu. Allocate it directly from "
          "device\n",
-         Size, SizeThreshold);
+         BucketedSize, SizeThreshold);
       void *TgtPtr = allocateOrFreeAndAllocateOnDevice(Size, HstPtr);
 
       DP("Got target pointer " DPxMOD ". Return directly.\n", DPxPTR(TgtPtr));
@@ -236,6 +282,7 @@ public:
     }
 
     NodeTy *NodePtr = nullptr;
+    Size = BucketedSize;
 
     // Try to get a node from FreeList
     {
@@ -252,8 +299,12 @@ public:
       }
     }
 
-    if (NodePtr != nullptr)
+    if (NodePtr != nullptr) {
       DP("Find one node " DPxMOD " in the bucket.\n", DPxPTR(NodePtr));
+      ++NumReused;
+      std::lock_guard<std::mutex> G(CachedBytesLock);
+      CachedBytes -= Size;
+    }
 
     // We cannot find a valid node in FreeLists. Let's allocate on device and
     // create a node for it.
@@ -264,6 +315,7 @@ public:
 
       if (TgtPtr == nullptr)
         return nullptr;
+      ++NumAllocatedOnDevice;
 
       // Create a new node and add it into the map table
       {
@@ -304,6 +356,25 @@ public:
       return deleteOnDevice(TgtPtr);
     }
 
+    // Account for the node before inserting it, and return the memory to the
+    // device instead if caching it would exceed the limit.
+    bool Cache = true;
+    {
+      std::lock_guard<std::mutex> G(CachedBytesLock);
+      if (CacheLimit && CachedBytes + P->Size > CacheLimit)
+        Cache = false;
+      else
+        CachedBytes += P->Size;
+    }
+    if (!Cache) {
+      DP("Free lists are full. Delete it on device directly.\n");
+      {
+        std::lock_guard<std::mutex> G(MapTableLock);
+        PtrToNodeTable.erase(TgtPtr);
+      }
+      return deleteOnDevice(TgtPtr);
+    }
+
     // Insert the node to the free list
     const int B = findBucket(P->Size);
 
@@ -337,6 +408,15 @@ public:
 
     return std::make_pair(Threshold, true);
   }
+
+  /// Get the maximum number of bytes kept in the free lists from the
+  /// environment variable \p LIBOMPTARGET_MEMORY_MANAGER_CACHE_LIMIT . Zero,
+  /// the default, keeps every freed node.
+  static size_t getCacheLimitFromEnv() {
+    static UInt32Envar MemoryManagerCacheLimit(
+        "LIBOMPTARGET_MEMORY_MANAGER_CACHE_LIMIT", 0);
+    return MemoryManagerCacheLimit.get();
+  }
 };
 
 // GCC still cannot handle the static data member like Clang so we still need
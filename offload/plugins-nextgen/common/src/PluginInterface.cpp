@@ -540,6 +540,12 @@ Error GenericKernelTy::printLaunchInfoDetails(GenericDeviceTy &GenericDevice,
   return Plugin::success();
 }
 
+// FIXME: Launches are already enqueued on the stream of the async info, so
+// consecutive nowait regions sharing a queue run back to back without host
+// synchronization. What still costs per launch is this host-side setup and
+// the driver call in launchImpl. Coalescing them would need the plugins to
+// capture a queue into a CUDA graph or an AQL packet batch, and libomptarget
+// to say when a sequence of launches may be replayed.
 Error GenericKernelTy::launch(GenericDeviceTy &GenericDevice, void **ArgPtrs,
                               ptrdiff_t *ArgOffsets, KernelArgsTy &KernelArgs,
                               AsyncInfoWrapperTy &AsyncInfoWrapper) const {
@@ -87,6 +87,10 @@ kmp_bar_pat_e __kmp_barrier_gather_pat_dflt = bp_hyper_bar;
 kmp_bar_pat_e __kmp_barrier_release_pat_dflt = bp_hyper_bar;
 /* hyper2: C78980 */
 
+// FIXME: Patterns and branch bits are process-wide, and the team setup in
+// kmp_runtime.cpp checks them directly, e.g. for bp_dist_bar. Choosing them
+// per team from the team size and __kmp_topology would first need them to
+// be stored in kmp_team_t.
 kmp_uint32 __kmp_barrier_gather_branch_bits[bs_last_barrier] = {0};
 kmp_uint32 __kmp_barrier_release_branch_bits[bs_last_barrier] = {0};
 kmp_bar_pat_e __kmp_barrier_gather_pattern[bs_last_barrier] = {bp_linear_bar};
@@ -353,6 +357,7 @@ omp_memspace_handle_t const llvm_omp_target_device_mem_space =
 KMP_BUILD_ASSERT(sizeof(kmp_tasking_flags_t) == 4);
 
 int __kmp_task_stealing_constraint = 1; /* Constrain task stealing by default */
+int __kmp_task_stealing_locality = 0; /* Prefer nearby victims when stealing */
 int __kmp_enable_task_throttling = 1;
 
 #ifdef DEBUG_SUSPEND
@@ -294,6 +294,11 @@ kmp_depnode_list_t *__kmpc_task_get_successors(kmp_task_t *task) {
   return td->td_depnode->dn.successors;
 }
 
+// The dephash is only written by the thread running the parent task, so it
+// needs no locking. The depnode lock is what keeps a new successor from being
+// added while the predecessor completes and releases its successors list.
+// FIXME: a predecessor could instead close its list with a sentinel that is
+// swapped in atomically, letting the successor be pushed with a CAS.
 static inline kmp_int32
 __kmp_depnode_link_successor(kmp_int32 gtid, kmp_info_t *thread,
                              kmp_task_t *task, kmp_depnode_t *node,
@@ -11,6 +11,7 @@
 //===----------------------------------------------------------------------===//
 
 #include "kmp.h"
+#include "kmp_affinity.h"
 #include "kmp_i18n.h"
 #include "kmp_itt.h"
 #include "kmp_stats.h"
@@ -3216,6 +3217,59 @@ static kmp_task_t *__kmp_remove_my_task(kmp_info_t *thread, kmp_int32 gtid,
   return task;
 }
 
+#if KMP_AFFINITY_SUPPORTED
+// __kmp_shared_topology_levels: number of topology levels, from the outermost
+// one down, on which the places of two threads coincide. Threads on the same
+// core share every level above the hardware thread; threads on different
+// sockets share none.
+static int __kmp_shared_topology_levels(kmp_info_t *thr1, kmp_info_t *thr2) {
+  if (!KMP_AFFINITY_CAPABLE() || !__kmp_topology)
+    return 0;
+  int depth = __kmp_topology->get_depth();
+  int level = 0;
+  for (; level < depth; ++level) {
+    kmp_hw_t type = __kmp_topology->get_type(level);
+    int id = thr1->th.th_topology_ids.ids[type];
+    if (id < 0 || id != thr2->th.th_topology_ids.ids[type])
+      break;
+  }
+  return level;
+}
+#endif // KMP_AFFINITY_SUPPORTED
+
+// __kmp_select_victim: pick a random thread other than tid to steal from.
+// With KMP_TASK_STEALING_LOCALITY=1, the closest of a few random candidates in
+// the machine topology is picked instead, so that steals stay within a core,
+// cache or NUMA node when possible. Remote victims are still picked whenever
+// no closer candidate was drawn, so no thread is starved of thieves.
+static kmp_int32 __kmp_select_victim(kmp_info_t *thread, kmp_int32 tid,
+                                     kmp_int32 nthreads,
+                                     kmp_thread_data_t *threads_data) {
+  kmp_int32 victim_tid = __kmp_get_random(thread) % (nthreads - 1);
+  if (victim_tid >= tid) {
+    ++victim_tid; // Adjusts random distribution to exclude self
+  }
+#if KMP_AFFINITY_SUPPORTED
+  if (__kmp_task_stealing_locality && nthreads > 2) {
+    const int num_candidates = 4;
+    int best_levels = __kmp_shared_topology_levels(
+        thread, threads_data[victim_tid].td.td_thr);
+    for (int i = 1; i < num_candidates; ++i) {
+      kmp_int32 candidate = __kmp_get_random(thread) % (nthreads - 1);
+      if (candidate >= tid)
+        ++candidate;
+      int levels = __kmp_shared_topology_levels(
+          thread, threads_data[candidate].td.td_thr);
+      if (levels > best_levels) {
+        best_levels = levels;
+        victim_tid = candidate;
+      }
+    }
+  }
+#endif // KMP_AFFINITY_SUPPORTED
+  return victim_tid;
+}
+
 // __kmp_steal_task: remove a task from another thread's deque
 // Assume that calling thread has already checked existence of
 // task_team thread_data before calling this routine.
@@ -3422,10 +3476,8 @@ static inline int __kmp_execute_tasks_template(
             // Pick a random thread. Initial plan was to cycle through all the
             // threads, and only return if we tried to steal from every thread,
             // and failed.  Arch says that's not such a great idea.
-            victim_tid = __kmp_get_random(thread) % (nthreads - 1);
-            if (victim_tid >= tid) {
-              ++victim_tid; // Adjusts random distribution to exclude self
-            }
+            victim_tid =
+                __kmp_select_victim(thread, tid, nthreads, threads_data);
             // Found a potential victim
             other_thread = threads_data[victim_tid].td.td_thr;
             // There is a slight chance that __kmp_enable_tasking() did not wake
@@ -0,0 +1,45 @@
+// RUN: %libomp-compile
+// RUN: env KMP_SETTINGS=1 KMP_TASK_STEALING_LOCALITY=1 %libomp-run 2>&1 | FileCheck %s
+// RUN: env KMP_TASK_STEALING_LOCALITY=1 KMP_AFFINITY=compact %libomp-run
+// RUN: env KMP_TASK_STEALING_LOCALITY=1 KMP_AFFINITY=none %libomp-run
+// RUN: env KMP_TASK_STEALING_LOCALITY=0 %libomp-run
+//
+// CHECK: Effective settings
+// CHECK: KMP_TASK_STEALING_LOCALITY=1
+//
+// With KMP_TASK_STEALING_LOCALITY=1, thieves prefer victims close to them in
+// the machine topology. Check that every task still runs exactly once, with
+// and without affinity information.
+
+#include <stdio.h>
+#include <omp.h>
+
+#define NUM_TASKS 10000
+
+int main() {
+  int executed[NUM_TASKS] = {0};
+  int failed = 0;
+  int i;
+
+#pragma omp parallel num_threads(4)
+#pragma omp single
+  for (i = 0; i < NUM_TASKS; ++i) {
+#pragma omp task firstprivate(i) shared(executed)
+    {
+      volatile int work = 0;
+      int j;
+      for (j = 0; j < 100; ++j)
+        work += j;
+#pragma omp atomic
+      executed[i]++;
+    }
+  }
+
+  for (i = 0; i < NUM_TASKS; ++i) {
+    if (executed[i] != 1) {
+      fprintf(stderr, "task %d ran %d times\n", i, executed[i]);
+      failed = 1;
+    }
+  }
+  return failed;
+}
@@ -26,6 +26,7 @@
 #include "polly/Support/GICHelper.h"
 #include "polly/Support/ISLTools.h"
 #include "llvm/ADT/Sequence.h"
+#include "llvm/ADT/Statistic.h"
 #include "llvm/Support/Debug.h"
 #include "isl/aff.h"
 #include "isl/ctx.h"
@@ -42,6 +43,9 @@ using namespace llvm;
 #include "polly/Support/PollyDebug.h"
 #define DEBUG_TYPE "polly-dependence"
 
+STATISTIC(DependencesComputedOut,
+          "Number of dependence analyses that exceeded the ISL quota");
+
 static cl::opt<int> OptComputeOut(
     "polly-dependences-computeout",
     cl::desc("Bound the dependence analysis by a maximal amount of "
@@ -479,6 +483,7 @@ void Dependences::calculateDependences(Scop &S) {
   }
 
   if (isl_ctx_last_error(IslCtx.get()) == isl_error_quota) {
+    DependencesComputedOut++;
     isl_union_map_free(RAW);
     isl_union_map_free(WAW);
     isl_union_map_free(WAR);
@@ -200,6 +200,8 @@ static cl::opt<bool> OptimizedScops(
 
 STATISTIC(ScopsProcessed, "Number of scops processed");
 STATISTIC(ScopsRescheduled, "Number of scops rescheduled");
+STATISTIC(ScopsScheduleComputedOut,
+          "Number of scops whose rescheduling exceeded the ISL quota");
 STATISTIC(ScopsOptimized, "Number of scops optimized");
 
 STATISTIC(NumAffineLoopsOptimized, "Number of affine loops optimized");
@@ -873,9 +875,11 @@ static void runIslScheduleOptimizer(
       IslMaxOperationsGuard MaxOpGuard(Ctx, ScheduleComputeOut);
       Schedule = SC.compute_schedule();
 
-      if (MaxOpGuard.hasQuotaExceeded())
+      if (MaxOpGuard.hasQuotaExceeded()) {
+        ScopsScheduleComputedOut++;
         POLLY_DEBUG(
             dbgs() << "Schedule optimizer calculation exceeds ISL quota\n");
+      }
     }
 
     isl_options_set_on_error(Ctx, OnErrorStatus);